@@ -0,0 +1,470 @@
+/**
+ * @file bench.c
+ * @brief Minimal harness shared by the benchmark executables.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+#if defined(__linux__)
+#define _GNU_SOURCE // clock_gettime, syscall
+#elif defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200809L // clock_gettime
+#endif
+
+#ifndef BENCH_PERF_COUNTERS // Define at compile-command time if desired
+#if defined(__linux__)
+#define BENCH_PERF_COUNTERS 1
+#else
+#define BENCH_PERF_COUNTERS 0
+#endif
+#endif // BENCH_PERF_COUNTERS
+
+/* File Inclusions */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#if BENCH_PERF_COUNTERS
+#include <errno.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "bench.h"
+
+/* Local Variables */
+
+static volatile uint64_t Sink;
+
+#if BENCH_PERF_COUNTERS
+static const struct
+{
+   uint32_t type;
+   uint64_t config;
+} COUNTER_EVENTS[BenchCounter_Count] =
+{
+   [BenchCounter_Cycles]       = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+   [BenchCounter_Instructions] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+   [BenchCounter_L1dMisses]    = { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D |
+                                                       (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+   [BenchCounter_LlcMisses]    = { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL |
+                                                       (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+   [BenchCounter_BranchMisses] = { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+   [BenchCounter_DtlbMisses]   = { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB |
+                                                       (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                                       (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+};
+
+// Opened on the first bench_start, and left open (counting) until exit
+static int CounterFds[BenchCounter_Count];
+static bool CountersOpened = false;
+#endif
+
+/* Private Function Prototypes */
+
+static int cmp_u64(const void * a, const void * b);
+static uint64_t percentile(const uint64_t * sorted, size_t n, double pct);
+static size_t histo_bucket(uint64_t ns);
+static uint64_t histo_bucket_top(size_t bucket);
+static size_t proc_status_bytes(const char * key);
+static void counters_read(struct BenchCounterReading * readings);
+static void report_counters(size_t ops, const struct BenchTimer * timer);
+#if BENCH_PERF_COUNTERS
+static void counters_open(void);
+#endif
+
+/* Public Function Definitions */
+
+uint64_t bench_now_ns(void)
+{
+#if defined(CLOCK_MONOTONIC)
+   struct timespec ts;
+   (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+#else
+   return (uint64_t)( (double)clock() * (1e9 / CLOCKS_PER_SEC) );
+#endif
+}
+
+void bench_start(struct BenchTimer * timer)
+{
+   assert(timer != NULL);
+   timer->elapsed_ns = 0;
+   counters_read(timer->counters_start);
+   timer->start_ns = bench_now_ns();
+}
+
+void bench_stop(struct BenchTimer * timer)
+{
+   assert(timer != NULL);
+   timer->elapsed_ns = bench_now_ns() - timer->start_ns;
+
+   struct BenchCounterReading end[BenchCounter_Count];
+   counters_read(end);
+   for ( size_t i = 0; i < BenchCounter_Count; i++ )
+   {
+      const struct BenchCounterReading * start = &timer->counters_start[i];
+      uint64_t running = end[i].time_running - start->time_running;
+      if ( (0 == running) || (end[i].value < start->value) )
+      {
+         timer->counts[i] = BENCH_COUNTER_NONE;
+         continue;
+      }
+
+      // Scale up counts the kernel only sampled, for having more counters
+      // open than the PMU could count at once
+      uint64_t enabled = end[i].time_enabled - start->time_enabled;
+      double count = (double)(end[i].value - start->value);
+      timer->counts[i] = (uint64_t)( count * ((double)enabled / (double)running) );
+   }
+}
+
+void bench_header(const char * title)
+{
+   printf("\n%s\n", title);
+   printf("   %-40s %14s %12s\n", "case", "total (ms)", "ns/op");
+}
+
+void bench_report(const char * name, size_t ops, const struct BenchTimer * timer)
+{
+   assert(timer != NULL);
+   double total_ms = (double)timer->elapsed_ns / 1e6;
+   double ns_per_op = (ops > 0) ? ((double)timer->elapsed_ns / (double)ops) : 0.0;
+   printf("   %-40s %14.3f %12.1f\n", name, total_ms, ns_per_op);
+   report_counters(ops, timer);
+}
+
+void bench_latency_header(const char * title)
+{
+   printf("\n%s\n", title);
+   printf("   %-32s %10s %10s %10s %10s %10s %10s\n",
+          "case (ns)", "mean", "p50", "p99", "p99.9", "p99.99", "max");
+}
+
+void bench_report_latency(const char * name, uint64_t * samples_ns, size_t n,
+                          const struct BenchTimer * timer)
+{
+   assert( (samples_ns != NULL) || (0 == n) );
+   if ( 0 == n )
+   {
+      printf("   %-32s (no samples)\n", name);
+      return;
+   }
+
+   qsort(samples_ns, n, sizeof(samples_ns[0]), cmp_u64);
+   double sum = 0.0;
+   for ( size_t i = 0; i < n; i++ )
+   {
+      sum += (double)samples_ns[i];
+   }
+
+   printf("   %-32s %10.1f %10llu %10llu %10llu %10llu %10llu\n",
+          name, sum / (double)n,
+          (unsigned long long)percentile(samples_ns, n, 50.0),
+          (unsigned long long)percentile(samples_ns, n, 99.0),
+          (unsigned long long)percentile(samples_ns, n, 99.9),
+          (unsigned long long)percentile(samples_ns, n, 99.99),
+          (unsigned long long)samples_ns[n - 1]);
+   if ( timer != NULL )
+   {
+      report_counters(n, timer);
+   }
+}
+
+void bench_histo_clear(struct BenchHisto * histo)
+{
+   assert(histo != NULL);
+   memset(histo, 0, sizeof(struct BenchHisto));
+}
+
+void bench_histo_record(struct BenchHisto * histo, uint64_t ns)
+{
+   assert(histo != NULL);
+   histo->counts[histo_bucket(ns)]++;
+   histo->num_samples++;
+   histo->sum_ns += (double)ns;
+   histo->max_ns = (ns > histo->max_ns) ? ns : histo->max_ns;
+}
+
+uint64_t bench_histo_percentile(const struct BenchHisto * histo, double pct)
+{
+   assert(histo != NULL);
+   if ( 0 == histo->num_samples )
+   {
+      return 0;
+   }
+
+   // Same rank as percentile() picks out of the sorted samples
+   uint64_t rank = (uint64_t)( (pct / 100.0) * (double)histo->num_samples );
+   rank = (rank < histo->num_samples) ? rank : (histo->num_samples - 1);
+   uint64_t seen = 0;
+   for ( size_t bucket = 0; bucket < BENCH_HISTO_BUCKETS; bucket++ )
+   {
+      seen += histo->counts[bucket];
+      if ( seen > rank )
+      {
+         uint64_t top = histo_bucket_top(bucket);
+         return (top < histo->max_ns) ? top : histo->max_ns;
+      }
+   }
+   return histo->max_ns;
+}
+
+void bench_report_histo(const char * name, const struct BenchHisto * histo,
+                        const struct BenchTimer * timer)
+{
+   assert(histo != NULL);
+   if ( 0 == histo->num_samples )
+   {
+      printf("   %-32s (no samples)\n", name);
+      return;
+   }
+
+   printf("   %-32s %10.1f %10llu %10llu %10llu %10llu %10llu\n",
+          name, histo->sum_ns / (double)histo->num_samples,
+          (unsigned long long)bench_histo_percentile(histo, 50.0),
+          (unsigned long long)bench_histo_percentile(histo, 99.0),
+          (unsigned long long)bench_histo_percentile(histo, 99.9),
+          (unsigned long long)bench_histo_percentile(histo, 99.99),
+          (unsigned long long)histo->max_ns);
+   if ( timer != NULL )
+   {
+      report_counters((size_t)histo->num_samples, timer);
+   }
+}
+
+size_t bench_rss_bytes(void)
+{
+   return proc_status_bytes("VmRSS:");
+}
+
+size_t bench_peak_rss_bytes(void)
+{
+   return proc_status_bytes("VmHWM:");
+}
+
+bool bench_peak_rss_reset(void)
+{
+   // Linux resets VmHWM when 5 is written here
+   FILE * clear_refs = fopen("/proc/self/clear_refs", "w");
+   if ( NULL == clear_refs )
+   {
+      return false;
+   }
+   bool reset = (fputs("5", clear_refs) >= 0);
+   reset = (0 == fclose(clear_refs)) && reset;
+   return reset;
+}
+
+void bench_keep(uint64_t val)
+{
+   Sink ^= val;
+}
+
+uint64_t bench_rand(uint64_t * state)
+{
+   assert( (state != NULL) && (*state != 0) );
+   uint64_t x = *state;
+   x ^= x >> 12;
+   x ^= x << 25;
+   x ^= x >> 27;
+   *state = x;
+   return x * UINT64_C(2685821657736338717);
+}
+
+/* Private Function Definitions */
+
+static int cmp_u64(const void * a, const void * b)
+{
+   uint64_t lhs = *(const uint64_t *)a;
+   uint64_t rhs = *(const uint64_t *)b;
+   return (lhs > rhs) - (lhs < rhs);
+}
+
+/**
+ * @brief Nearest-rank percentile of an ascending array of n (> 0) samples.
+ */
+static uint64_t percentile(const uint64_t * sorted, size_t n, double pct)
+{
+   size_t rank = (size_t)( (pct / 100.0) * (double)n );
+   return sorted[ (rank < n) ? rank : (n - 1) ];
+}
+
+/**
+ * @brief Histogram bucket of a value: the value itself below 2^SUB_BITS, and
+ *        above, the top SUB_BITS bits of the value, offset by its magnitude.
+ */
+static size_t histo_bucket(uint64_t ns)
+{
+   const unsigned int SUB_BITS = BENCH_HISTO_SUB_BITS;
+   if ( ns < (UINT64_C(1) << SUB_BITS) )
+   {
+      return (size_t)ns;
+   }
+
+   unsigned int msb = 0;
+   for ( uint64_t rest = ns >> 1; rest > 0; rest >>= 1 )
+   {
+      msb++;
+   }
+   unsigned int shift = msb - SUB_BITS + 1;
+   return ( (size_t)shift << (SUB_BITS - 1) ) + (size_t)(ns >> shift);
+}
+
+/**
+ * @brief Highest value that falls into a bucket (see histo_bucket).
+ */
+static uint64_t histo_bucket_top(size_t bucket)
+{
+   const unsigned int SUB_BITS = BENCH_HISTO_SUB_BITS;
+   if ( bucket < ((size_t)1 << SUB_BITS) )
+   {
+      return (uint64_t)bucket;
+   }
+
+   unsigned int shift = (unsigned int)(bucket >> (SUB_BITS - 1)) - 1;
+   uint64_t mantissa = (uint64_t)bucket - ((uint64_t)shift << (SUB_BITS - 1));
+   return ( (mantissa + 1) << shift ) - 1;
+}
+
+/**
+ * @brief Value of a "key: N kB" line of /proc/self/status, in bytes (0 if
+ *        there is no such file or line).
+ */
+static size_t proc_status_bytes(const char * key)
+{
+   FILE * status = fopen("/proc/self/status", "r");
+   if ( NULL == status )
+   {
+      return 0;
+   }
+
+   size_t key_len = strlen(key);
+   size_t bytes = 0;
+   char line[256];
+   while ( fgets(line, sizeof(line), status) != NULL )
+   {
+      if ( 0 == strncmp(line, key, key_len) )
+      {
+         bytes = (size_t)strtoull(line + key_len, NULL, 10) * 1024;
+         break;
+      }
+   }
+   (void)fclose(status);
+   return bytes;
+}
+
+/**
+ * @brief Current value of each hardware counter (all zeros where there is none,
+ *        which bench_stop takes as unavailable).
+ */
+static void counters_read(struct BenchCounterReading * readings)
+{
+   memset(readings, 0, BenchCounter_Count * sizeof(struct BenchCounterReading));
+#if BENCH_PERF_COUNTERS
+   if ( !CountersOpened )
+   {
+      counters_open();
+   }
+   for ( size_t i = 0; i < BenchCounter_Count; i++ )
+   {
+      if ( (CounterFds[i] >= 0) &&
+           (read(CounterFds[i], &readings[i], sizeof(readings[i])) != (ssize_t)sizeof(readings[i])) )
+      {
+         memset(&readings[i], 0, sizeof(readings[i]));
+      }
+   }
+#endif
+}
+
+/**
+ * @brief Prints the hardware counters of a case per op, or nothing if none of
+ *        them could be read.
+ */
+static void report_counters(size_t ops, const struct BenchTimer * timer)
+{
+   static const char * const NAMES[BenchCounter_Count] =
+   {
+      "cycles", "instr", "L1d miss", "LLC miss", "br miss", "dTLB miss"
+   };
+
+   bool any = false;
+   for ( size_t i = 0; i < BenchCounter_Count; i++ )
+   {
+      any = any || (timer->counts[i] != BENCH_COUNTER_NONE);
+   }
+   if ( !any || (0 == ops) )
+   {
+      return;
+   }
+
+   printf("      per op:");
+   for ( size_t i = 0; i < BenchCounter_Count; i++ )
+   {
+      const char * sep = (i > 0) ? "," : "";
+      if ( timer->counts[i] != BENCH_COUNTER_NONE )
+      {
+         printf("%s %.2f %s", sep, (double)timer->counts[i] / (double)ops, NAMES[i]);
+      }
+      else
+      {
+         printf("%s - %s", sep, NAMES[i]);
+      }
+   }
+   uint64_t cycles = timer->counts[BenchCounter_Cycles];
+   uint64_t instructions = timer->counts[BenchCounter_Instructions];
+   if ( (cycles != BENCH_COUNTER_NONE) && (instructions != BENCH_COUNTER_NONE) && (cycles > 0) )
+   {
+      printf(" (IPC %.2f)", (double)instructions / (double)cycles);
+   }
+   printf("\n");
+}
+
+#if BENCH_PERF_COUNTERS
+/**
+ * @brief Opens a counter for each hardware event, on this thread and the ones
+ *        it starts from now on. Any that can't be opened are left out; if none
+ *        can, says why once.
+ */
+static void counters_open(void)
+{
+   CountersOpened = true;
+   int first_error = 0;
+   for ( size_t i = 0; i < BenchCounter_Count; i++ )
+   {
+      struct perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = COUNTER_EVENTS[i].type;
+      attr.config = COUNTER_EVENTS[i].config;
+      attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+      attr.inherit = 1;        // Threads started by the case count too
+      attr.exclude_kernel = 1; // Allowed at perf_event_paranoid 2
+      attr.exclude_hv = 1;
+
+      CounterFds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+      if ( (CounterFds[i] < 0) && (0 == first_error) )
+      {
+         first_error = errno;
+      }
+   }
+
+   bool any = false;
+   for ( size_t i = 0; i < BenchCounter_Count; i++ )
+   {
+      any = any || (CounterFds[i] >= 0);
+   }
+   if ( !any )
+   {
+      fprintf(stderr, "(no hardware counters: perf_event_open: %s)\n", strerror(first_error));
+   }
+}
+#endif
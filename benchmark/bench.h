@@ -0,0 +1,190 @@
+/**
+ * @file bench.h
+ * @brief Minimal harness shared by the benchmark executables.
+ *
+ * Each benchmark is its own executable (benchmark/bench_*.c) that times a few
+ * cases against each other and reports them in a common format:
+ *
+ *    struct BenchTimer t;
+ *    bench_start(&t);
+ *    for ( size_t i = 0; i < N; i++ ) { ... }
+ *    bench_stop(&t);
+ *    bench_report("case name", N, &t);
+ *
+ * On Linux, the timer also reads hardware counters (cycles, instructions, L1d,
+ * LLC and dTLB misses, branch misses) through perf_event_open, and the report
+ * shows them per op. Latency cases, which time each op on its own, run a timer
+ * around the whole case too and hand it to bench_report_latency/histo, which
+ * show its counters per sample. Where that isn't permitted (see
+ * perf_event_paranoid) or supported, only the time is reported. Build with
+ * -DBENCH_PERF_COUNTERS=0 to leave the counters out altogether.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+/* File Inclusions */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Public Macro Definitions */
+
+/**
+ * @brief Keeps the compiler from optimizing away a computation whose result
+ *        is otherwise unused.
+ */
+#define BENCH_KEEP(val) bench_keep( (uint64_t)(val) )
+
+//! Latency histograms keep 2^(BENCH_HISTO_SUB_BITS - 1) buckets per power of
+//! two, so any value recorded is known to within 1/64 (~1.6%) of itself
+#define BENCH_HISTO_SUB_BITS    (7u)
+#define BENCH_HISTO_BUCKETS     ( (66u - BENCH_HISTO_SUB_BITS) << (BENCH_HISTO_SUB_BITS - 1u) )
+
+//! Count of a hardware counter that couldn't be read
+#define BENCH_COUNTER_NONE      UINT64_MAX
+
+/* Public Datatypes */
+
+enum BenchCounter
+{
+   BenchCounter_Cycles,
+   BenchCounter_Instructions,
+   BenchCounter_L1dMisses,
+   BenchCounter_LlcMisses,
+   BenchCounter_BranchMisses,
+   BenchCounter_DtlbMisses,
+   BenchCounter_Count
+};
+
+// Laid out as perf_event_open reads a counter, for scaling multiplexed counts
+struct BenchCounterReading
+{
+   uint64_t value;
+   uint64_t time_enabled;
+   uint64_t time_running;
+};
+
+/**
+ * @brief Time taken by a case, and the hardware counters over it (including
+ *        threads started and joined within it), BENCH_COUNTER_NONE where
+ *        unavailable.
+ */
+struct BenchTimer
+{
+   uint64_t start_ns;
+   uint64_t elapsed_ns;
+   uint64_t counts[BenchCounter_Count];
+   struct BenchCounterReading counters_start[BenchCounter_Count];
+};
+
+/**
+ * @brief HDR-style histogram of latencies: exact below 2^BENCH_HISTO_SUB_BITS
+ *        ns, and log-linear above, over the whole range of uint64_t. Takes
+ *        the same memory however many samples it holds.
+ */
+struct BenchHisto
+{
+   uint64_t counts[BENCH_HISTO_BUCKETS];
+   uint64_t num_samples;
+   uint64_t max_ns;
+   double sum_ns;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Public Functions */
+
+/**
+ * @brief Monotonic timestamp (in ns).
+ */
+uint64_t bench_now_ns(void);
+
+void bench_start(struct BenchTimer * timer);
+void bench_stop(struct BenchTimer * timer);
+
+/**
+ * @brief Prints the title of a group of cases that are meant to be compared.
+ */
+void bench_header(const char * title);
+
+/**
+ * @brief Prints the total time and time per op of a case, and on a second line
+ *        the hardware counters per op (if any could be read).
+ * @param name Name of the case
+ * @param ops  Number of operations the timer covered
+ */
+void bench_report(const char * name, size_t ops, const struct BenchTimer * timer);
+
+/**
+ * @brief Prints the title of a group of cases whose per-op latencies are meant
+ *        to be compared.
+ */
+void bench_latency_header(const char * title);
+
+/**
+ * @brief Prints the mean, median, tail percentiles and worst case of a set of
+ *        per-op latencies, and on a second line the hardware counters of the
+ *        case per sample (if any could be read).
+ * @param name       Name of the case
+ * @param samples_ns Latency of each op (in ns), sorted in place
+ * @param n          Number of samples
+ * @param timer      Timer run around the whole case, or NULL for no counters.
+ *                   Its counters take in everything the case did besides the
+ *                   ops, like the clock reads around each of them.
+ */
+void bench_report_latency(const char * name, uint64_t * samples_ns, size_t n,
+                          const struct BenchTimer * timer);
+
+void bench_histo_clear(struct BenchHisto * histo);
+void bench_histo_record(struct BenchHisto * histo, uint64_t ns);
+
+/**
+ * @brief Nearest-rank percentile of the samples in a histogram (0 if empty),
+ *        as the highest value its bucket holds (but no more than the max).
+ */
+uint64_t bench_histo_percentile(const struct BenchHisto * histo, double pct);
+
+/**
+ * @brief Like bench_report_latency, for the samples in a histogram.
+ */
+void bench_report_histo(const char * name, const struct BenchHisto * histo,
+                        const struct BenchTimer * timer);
+
+/**
+ * @brief Resident set size of the process (in bytes), or 0 where unknown.
+ */
+size_t bench_rss_bytes(void);
+
+/**
+ * @brief Highest resident set size of the process (in bytes) since startup or
+ *        the last bench_peak_rss_reset, or 0 where unknown.
+ */
+size_t bench_peak_rss_bytes(void);
+
+/**
+ * @brief Restarts the peak resident set size from the current one.
+ * @return false if the system doesn't allow it (the peak then keeps counting
+ *         from startup).
+ */
+bool bench_peak_rss_reset(void);
+
+void bench_keep(uint64_t val);
+
+/**
+ * @brief Small, fast, deterministic PRNG (xorshift64*) so that every case sees
+ *        the same sequence of sizes/indices for a given seed.
+ */
+uint64_t bench_rand(uint64_t * state);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // BENCH_H
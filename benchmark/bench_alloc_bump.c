@@ -0,0 +1,146 @@
+/**
+ * @file bench_alloc_bump.c
+ * @brief Request-scoped vectors: bump arena vs. malloc.
+ *
+ * Each "request" creates a handful of vectors, pushes a random number of
+ * elements to each, reads them back, and frees them. With the bump allocator,
+ * the arena is reset at the end of every request.
+ *
+ * Two fill patterns are measured: sequential (each vector is filled before the
+ * next is created, so the bump allocator grows the last block in place) and
+ * interleaved (vectors take turns, so growth mostly has to copy).
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bench.h"
+#include "vector.h"
+#include "alloc_bump.h"
+
+/* Local Macro Definitions */
+
+#define NUM_REQUESTS       (20000)
+#define VECS_PER_REQUEST   (4)
+#define MAX_PUSHES         (2048)
+#define ARENA_SZ           ( (size_t)8 << 20 )
+#define SEED               UINT64_C(0x9E3779B97F4A7C15)
+
+/* Forward Function Declarations */
+
+static size_t run_request(const struct Allocator * mem_mgr, bool interleaved, uint64_t * seed);
+static void run_case(const char * name, const struct Allocator * mem_mgr,
+                     struct BumpArena * arena, bool interleaved);
+
+/* Meat of the Program */
+
+int main(void)
+{
+   void * buf = malloc(ARENA_SZ);
+   if ( NULL == buf )
+   {
+      fprintf(stderr, "Failed to allocate the arena's buffer\n");
+      return 1;
+   }
+   struct BumpArena arena;
+   bump_init(&arena, buf, ARENA_SZ);
+
+   const struct Allocator malloc_mgr = DEFAULT_ALLOCATOR;
+   const struct Allocator bump_mgr = BUMP_ALLOCATOR(&arena);
+
+   bench_header("Request-scoped vectors (4 vectors x up to 2048 pushes per request)");
+   run_case("malloc, sequential fill",        &malloc_mgr, NULL,   false);
+   run_case("bump arena, sequential fill",    &bump_mgr,   &arena, false);
+   run_case("malloc, interleaved fill",       &malloc_mgr, NULL,   true);
+   run_case("bump arena, interleaved fill",   &bump_mgr,   &arena, true);
+
+   free(buf);
+   return 0;
+}
+
+/**
+ * @brief Times NUM_REQUESTS requests with the given allocator.
+ * @param arena Arena to reset after each request (NULL if not a bump allocator)
+ */
+static void run_case(const char * name, const struct Allocator * mem_mgr,
+                     struct BumpArena * arena, bool interleaved)
+{
+   uint64_t seed = SEED;
+   size_t total = 0;
+
+   struct BenchTimer timer;
+   bench_start(&timer);
+   for ( size_t i = 0; i < NUM_REQUESTS; i++ )
+   {
+      total += run_request(mem_mgr, interleaved, &seed);
+      if ( arena != NULL )
+      {
+         bump_reset(arena);
+      }
+   }
+   bench_stop(&timer);
+
+   BENCH_KEEP(total);
+   bench_report(name, NUM_REQUESTS, &timer);
+}
+
+static size_t run_request(const struct Allocator * mem_mgr, bool interleaved, uint64_t * seed)
+{
+   struct Vector * vecs[VECS_PER_REQUEST];
+   size_t pushes[VECS_PER_REQUEST];
+   size_t sum = 0;
+
+   for ( size_t v = 0; v < VECS_PER_REQUEST; v++ )
+   {
+      vecs[v] = VectorNew(sizeof(uint32_t), 0, MAX_PUSHES, 0, mem_mgr);
+      pushes[v] = 1 + (size_t)(bench_rand(seed) % MAX_PUSHES);
+      if ( NULL == vecs[v] )
+      {
+         fprintf(stderr, "Failed to create a vector\n");
+         exit(1);
+      }
+   }
+
+   if ( interleaved )
+   {
+      for ( uint32_t i = 0; i < MAX_PUSHES; i++ )
+      {
+         for ( size_t v = 0; v < VECS_PER_REQUEST; v++ )
+         {
+            if ( i < pushes[v] )
+            {
+               (void)VectorPush(vecs[v], &i);
+            }
+         }
+      }
+   }
+   else
+   {
+      for ( size_t v = 0; v < VECS_PER_REQUEST; v++ )
+      {
+         for ( uint32_t i = 0; i < pushes[v]; i++ )
+         {
+            (void)VectorPush(vecs[v], &i);
+         }
+      }
+   }
+
+   for ( size_t v = 0; v < VECS_PER_REQUEST; v++ )
+   {
+      size_t len = VectorLength(vecs[v]);
+      for ( size_t i = 0; i < len; i++ )
+      {
+         sum += *(uint32_t *)VectorGet(vecs[v], i);
+      }
+      VectorFree(vecs[v]);
+   }
+
+   return sum;
+}
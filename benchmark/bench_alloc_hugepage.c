@@ -0,0 +1,172 @@
+/**
+ * @file bench_alloc_hugepage.c
+ * @brief Scanning a huge vector: regular pages vs. huge pages.
+ *
+ * A vector is grown to VEC_BYTES, then read back sequentially and at random
+ * indices. Random reads over a buffer this large miss the TLB on nearly every
+ * access with 4 KiB pages, which is what huge pages are meant to fix.
+ *
+ * How much of each buffer actually ended up on huge pages is reported too,
+ * since THP depends on the system's settings (see
+ * /sys/kernel/mm/transparent_hugepage/enabled) and MAP_HUGETLB on pages having
+ * been reserved up front (vm.nr_hugepages).
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "vector.h"
+#include "alloc_mmap.h"
+
+/* Local Macro Definitions */
+
+#define VEC_BYTES       ( (size_t)512 << 20 )
+#define VEC_LEN         ( VEC_BYTES / sizeof(uint64_t) )
+#define RANDOM_READS    ( (size_t)1 << 24 )
+#define SEED            UINT64_C(0x4F1BBCDCBFA53E0B)
+
+/* Forward Function Declarations */
+
+static void run_case(const char * name, const struct Allocator * mem_mgr);
+static void print_system_settings(void);
+static long anon_huge_pages_kb(void);
+
+/* Meat of the Program */
+
+int main(void)
+{
+   struct MmapArena regular = { .threshold = (size_t)1 << 20, .huge_pages = MmapHugePages_Off };
+   struct MmapArena thp     = { .threshold = (size_t)1 << 20, .huge_pages = MmapHugePages_Transparent };
+   struct MmapArena hugetlb = { .threshold = (size_t)1 << 20, .huge_pages = MmapHugePages_Explicit };
+
+   const struct Allocator malloc_mgr  = DEFAULT_ALLOCATOR;
+   const struct Allocator regular_mgr = MMAP_ALLOCATOR(&regular);
+   const struct Allocator thp_mgr     = MMAP_ALLOCATOR(&thp);
+   const struct Allocator hugetlb_mgr = MMAP_ALLOCATOR(&hugetlb);
+
+   print_system_settings();
+   run_case("malloc", &malloc_mgr);
+   run_case("mmap, regular pages", &regular_mgr);
+   run_case("mmap, transparent huge pages", &thp_mgr);
+   run_case("mmap, MAP_HUGETLB (THP fallback)", &hugetlb_mgr);
+
+   return 0;
+}
+
+/**
+ * @brief Grows a vector to VEC_LEN elements, then times a sequential pass and
+ *        RANDOM_READS random reads over it.
+ */
+static void run_case(const char * name, const struct Allocator * mem_mgr)
+{
+   long huge_kb_before = anon_huge_pages_kb();
+
+   struct Vector * vec = VectorNew(sizeof(uint64_t), 0, VEC_LEN, 0, mem_mgr);
+   if ( NULL == vec )
+   {
+      fprintf(stderr, "Failed to create a vector\n");
+      exit(1);
+   }
+
+   struct BenchTimer fill_timer;
+   bench_start(&fill_timer);
+   for ( uint64_t i = 0; i < VEC_LEN; i++ )
+   {
+      if ( !VectorPush(vec, &i) )
+      {
+         fprintf(stderr, "Failed to grow the vector\n");
+         exit(1);
+      }
+   }
+   bench_stop(&fill_timer);
+
+   long huge_kb = anon_huge_pages_kb();
+   const uint64_t * data = VectorGet(vec, 0);
+   uint64_t sum = 0;
+
+   struct BenchTimer seq_timer;
+   bench_start(&seq_timer);
+   for ( size_t i = 0; i < VEC_LEN; i++ )
+   {
+      sum += data[i];
+   }
+   bench_stop(&seq_timer);
+
+   uint64_t seed = SEED;
+   struct BenchTimer rand_timer;
+   bench_start(&rand_timer);
+   for ( size_t i = 0; i < RANDOM_READS; i++ )
+   {
+      sum += data[ bench_rand(&seed) % VEC_LEN ];
+   }
+   bench_stop(&rand_timer);
+
+   VectorFree(vec);
+   BENCH_KEEP(sum);
+
+   char title[128];
+   if ( (huge_kb >= 0) && (huge_kb_before >= 0) )
+   {
+      long huge_mb = (huge_kb - huge_kb_before) / 1024;
+      (void)snprintf(title, sizeof(title), "%s (%ld of %zu MiB on huge pages)",
+                     name, (huge_mb > 0) ? huge_mb : 0L, VEC_BYTES >> 20);
+   }
+   else
+   {
+      (void)snprintf(title, sizeof(title), "%s", name);
+   }
+   bench_header(title);
+   bench_report("fill (push)", VEC_LEN, &fill_timer);
+   bench_report("sequential read", VEC_LEN, &seq_timer);
+   bench_report("random read", RANDOM_READS, &rand_timer);
+}
+
+static void print_system_settings(void)
+{
+   FILE * f = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+   char line[128] = "unknown";
+   if ( f != NULL )
+   {
+      if ( NULL == fgets(line, sizeof(line), f) )
+      {
+         (void)strcpy(line, "unknown");
+      }
+      line[strcspn(line, "\n")] = '\0';
+      (void)fclose(f);
+   }
+   printf("Transparent huge pages: %s\n", line);
+}
+
+/**
+ * @brief Amount of this process's anonymous memory on transparent huge pages
+ *        (in KiB), or -1 where the system doesn't say.
+ * @note MAP_HUGETLB pages are accounted separately, and don't show up here.
+ */
+static long anon_huge_pages_kb(void)
+{
+   FILE * f = fopen("/proc/self/smaps_rollup", "r");
+   if ( NULL == f )
+   {
+      return -1;
+   }
+
+   long kb = -1;
+   char line[256];
+   while ( fgets(line, sizeof(line), f) != NULL )
+   {
+      if ( 1 == sscanf(line, "AnonHugePages: %ld kB", &kb) )
+      {
+         break;
+      }
+   }
+   (void)fclose(f);
+   return kb;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file bench_alloc_slab.c
+ * @brief Continuously growing and dying vectors: slab allocator vs. malloc.
+ *
+ * A fixed number of vector slots is churned through: at each step, a random
+ * slot's vector is freed and replaced with a new one that grows to a random
+ * length. This is the pattern where recycling buffers by size class pays off.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "bench.h"
+#include "vector.h"
+#include "alloc_slab.h"
+
+/* Local Macro Definitions */
+
+#define NUM_SLOTS    (20)     // Must stay below VEC_STRUCT_POOL_SIZE
+#define NUM_STEPS    (200000)
+#define MAX_LEN      (4096)
+#define SEED         UINT64_C(0x2545F4914F6CDD1D)
+
+/* Forward Function Declarations */
+
+static void run_churn(const char * name, const struct Allocator * mem_mgr);
+static void run_doubling(const char * name, const struct Allocator * mem_mgr);
+
+/* Meat of the Program */
+
+int main(void)
+{
+   struct SlabArena arena;
+   slab_init(&arena);
+
+   const struct Allocator malloc_mgr = DEFAULT_ALLOCATOR;
+   const struct Allocator slab_mgr = SLAB_ALLOCATOR(&arena);
+
+   bench_header("Vector churn (20 live vectors, random lengths up to 4096)");
+   run_churn("malloc", &malloc_mgr);
+   run_churn("slab", &slab_mgr);
+
+   bench_header("Raw allocator: doubling chains 16 B -> 64 KiB, then free");
+   run_doubling("malloc", &malloc_mgr);
+   run_doubling("slab", &slab_mgr);
+
+   slab_destroy(&arena);
+   return 0;
+}
+
+static void run_churn(const char * name, const struct Allocator * mem_mgr)
+{
+   struct Vector * slots[NUM_SLOTS] = {0};
+   uint64_t seed = SEED;
+   uint64_t sum = 0;
+
+   struct BenchTimer timer;
+   bench_start(&timer);
+   for ( size_t step = 0; step < NUM_STEPS; step++ )
+   {
+      size_t slot = (size_t)(bench_rand(&seed) % NUM_SLOTS);
+      VectorFree(slots[slot]);
+
+      slots[slot] = VectorNew(sizeof(uint32_t), 0, MAX_LEN, 0, mem_mgr);
+      if ( NULL == slots[slot] )
+      {
+         fprintf(stderr, "Failed to create a vector\n");
+         exit(1);
+      }
+      uint32_t len = (uint32_t)(1 + (bench_rand(&seed) % MAX_LEN));
+      for ( uint32_t i = 0; i < len; i++ )
+      {
+         (void)VectorPush(slots[slot], &i);
+      }
+      sum += *(uint32_t *)VectorLastElement(slots[slot]);
+   }
+   bench_stop(&timer);
+
+   for ( size_t i = 0; i < NUM_SLOTS; i++ )
+   {
+      VectorFree(slots[i]);
+   }
+
+   BENCH_KEEP(sum);
+   bench_report(name, NUM_STEPS, &timer);
+}
+
+static void run_doubling(const char * name, const struct Allocator * mem_mgr)
+{
+   const size_t CHAINS = NUM_STEPS;
+   void * arena = mem_mgr->arena;
+   uint64_t sum = 0;
+
+   struct BenchTimer timer;
+   bench_start(&timer);
+   for ( size_t c = 0; c < CHAINS; c++ )
+   {
+      size_t sz = 16;
+      uint8_t * ptr = mem_mgr->alloc(sz, arena);
+      while ( (ptr != NULL) && (sz < ((size_t)64 * 1024)) )
+      {
+         ptr[0] = (uint8_t)c;
+         ptr = mem_mgr->realloc(ptr, sz * 2, sz, arena);
+         sz *= 2;
+      }
+      if ( NULL == ptr )
+      {
+         fprintf(stderr, "Allocation failed\n");
+         exit(1);
+      }
+      sum += ptr[0];
+      mem_mgr->reclaim(ptr, sz, arena);
+   }
+   bench_stop(&timer);
+
+   BENCH_KEEP(sum);
+   bench_report(name, CHAINS, &timer);
+}
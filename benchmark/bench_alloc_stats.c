@@ -0,0 +1,164 @@
+/**
+ * @file bench_alloc_stats.c
+ * @brief Cost of gathering allocator statistics, on top of malloc and slab.
+ *
+ * The same vector churn is run against each allocator bare and wrapped with
+ * stats_wrap, and then against the raw allocator calls, where the wrapper's
+ * overhead is least diluted. The wrapped runs also print what was gathered.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "bench.h"
+#include "vector.h"
+#include "alloc_slab.h"
+#include "alloc_stats.h"
+
+/* Local Macro Definitions */
+
+#define NUM_SLOTS    (20)     // Must stay below VEC_STRUCT_POOL_SIZE
+#define NUM_STEPS    (200000)
+#define MAX_LEN      (4096)
+#define SEED         UINT64_C(0x9E3779B97F4A7C15)
+
+/* Forward Function Declarations */
+
+static void run_churn(const char * name, const struct Allocator * mem_mgr);
+static void run_raw(const char * name, const struct Allocator * mem_mgr);
+static void print_stats(const struct StatsArena * arena);
+
+/* Meat of the Program */
+
+int main(void)
+{
+   struct SlabArena slab;
+   slab_init(&slab);
+
+   const struct Allocator malloc_mgr = DEFAULT_ALLOCATOR;
+   const struct Allocator slab_mgr = SLAB_ALLOCATOR(&slab);
+
+   struct StatsArena malloc_stats;
+   struct StatsArena slab_stats;
+   const struct Allocator malloc_stats_mgr = stats_wrap(&malloc_stats, &malloc_mgr);
+   const struct Allocator slab_stats_mgr = stats_wrap(&slab_stats, &slab_mgr);
+
+   bench_header("Vector churn (20 live vectors, random lengths up to 4096)");
+   run_churn("malloc", &malloc_mgr);
+   run_churn("malloc + stats", &malloc_stats_mgr);
+   run_churn("slab", &slab_mgr);
+   run_churn("slab + stats", &slab_stats_mgr);
+
+   print_stats(&malloc_stats);
+
+   bench_header("Raw allocator: 64 B alloc, realloc to 128 B, reclaim");
+   run_raw("malloc", &malloc_mgr);
+   run_raw("malloc + stats", &malloc_stats_mgr);
+   run_raw("slab", &slab_mgr);
+   run_raw("slab + stats", &slab_stats_mgr);
+
+   slab_destroy(&slab);
+   return 0;
+}
+
+static void run_churn(const char * name, const struct Allocator * mem_mgr)
+{
+   struct Vector * slots[NUM_SLOTS] = {0};
+   uint64_t seed = SEED;
+   uint64_t sum = 0;
+
+   struct BenchTimer timer;
+   bench_start(&timer);
+   for ( size_t step = 0; step < NUM_STEPS; step++ )
+   {
+      size_t slot = (size_t)(bench_rand(&seed) % NUM_SLOTS);
+      VectorFree(slots[slot]);
+
+      slots[slot] = VectorNew(sizeof(uint32_t), 0, MAX_LEN, 0, mem_mgr);
+      if ( NULL == slots[slot] )
+      {
+         fprintf(stderr, "Failed to create a vector\n");
+         exit(1);
+      }
+      uint32_t len = (uint32_t)(1 + (bench_rand(&seed) % MAX_LEN));
+      for ( uint32_t i = 0; i < len; i++ )
+      {
+         (void)VectorPush(slots[slot], &i);
+      }
+      sum += *(uint32_t *)VectorLastElement(slots[slot]);
+   }
+   bench_stop(&timer);
+
+   for ( size_t i = 0; i < NUM_SLOTS; i++ )
+   {
+      VectorFree(slots[i]);
+   }
+
+   BENCH_KEEP(sum);
+   bench_report(name, NUM_STEPS, &timer);
+}
+
+static void run_raw(const char * name, const struct Allocator * mem_mgr)
+{
+   const size_t ROUNDS = 10 * NUM_STEPS;
+   void * arena = mem_mgr->arena;
+   uint64_t sum = 0;
+
+   struct BenchTimer timer;
+   bench_start(&timer);
+   for ( size_t r = 0; r < ROUNDS; r++ )
+   {
+      uint8_t * ptr = mem_mgr->alloc(64, arena);
+      if ( ptr != NULL )
+      {
+         ptr[0] = (uint8_t)r;
+         ptr = mem_mgr->realloc(ptr, 128, 64, arena);
+      }
+      if ( NULL == ptr )
+      {
+         fprintf(stderr, "Allocation failed\n");
+         exit(1);
+      }
+      sum += ptr[0];
+      mem_mgr->reclaim(ptr, 128, arena);
+   }
+   bench_stop(&timer);
+
+   BENCH_KEEP(sum);
+   bench_report(name, ROUNDS, &timer);
+}
+
+static void print_stats(const struct StatsArena * arena)
+{
+   struct AllocStats stats;
+   stats_snapshot(arena, &stats);
+
+   printf("\nGathered for \"malloc + stats\":\n");
+   printf("   allocs %llu, reallocs %llu, expanded in place %llu, reclaims %llu\n",
+          (unsigned long long)stats.allocs, (unsigned long long)stats.reallocs,
+          (unsigned long long)stats.expands_in_place, (unsigned long long)stats.reclaims);
+   printf("   live %zu B in %zu blocks, peak %zu B\n",
+          stats.live_bytes, stats.live_blocks, stats.peak_bytes);
+   if ( stats.latency_samples > 0 )
+   {
+      printf("   latency: mean %llu ns, max %llu ns (%llu calls timed)\n",
+             (unsigned long long)(stats.latency_total_ns / stats.latency_samples),
+             (unsigned long long)stats.latency_max_ns,
+             (unsigned long long)stats.latency_samples);
+   }
+   printf("   realloc sizes:");
+   for ( size_t i = 0; i < STATS_SIZE_BUCKETS; i++ )
+   {
+      if ( stats.realloc_sizes[i] > 0 )
+      {
+         printf(" %zu B+: %llu,", (size_t)1 << i, (unsigned long long)stats.realloc_sizes[i]);
+      }
+   }
+   printf("\n");
+}
@@ -0,0 +1,190 @@
+/**
+ * @file bench_alloc_tlheap.c
+ * @brief Vectors created, grown and freed from several threads at once:
+ *        thread-local heaps vs. malloc.
+ *
+ * Two patterns are measured, both with every thread running flat out:
+ *    - Private churn: each thread keeps a few vectors of its own, and keeps
+ *      replacing a random one with a freshly grown one
+ *    - Hand-off: each thread grows vectors and passes them on to the next
+ *      thread, which reads and frees them (so every free is cross-thread)
+ *
+ * @note Vectors are created/freed concurrently, so this must be built with
+ *       VEC_POOL_THREAD_SAFE (which `make bench` does).
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "bench.h"
+#include "vector.h"
+#include "alloc_tlheap.h"
+
+#ifndef VEC_POOL_THREAD_SAFE
+#error "Build with -DVEC_POOL_THREAD_SAFE, as vectors are created from several threads"
+#endif
+
+/* Local Macro Definitions */
+
+#define NUM_THREADS        (4)
+#define SLOTS_PER_THREAD   (5)      // NUM_THREADS * this must stay below VEC_STRUCT_POOL_SIZE
+#define STEPS_PER_THREAD   (50000)
+#define MAX_LEN            (1024)
+#define SEED               UINT64_C(0xD1B54A32D192ED03)
+
+/* Local Datatypes */
+
+struct Worker
+{
+   pthread_t thread;
+   size_t idx;
+   const struct Allocator * mem_mgr;
+   uint64_t sum;
+};
+
+/* Forward Function Declarations */
+
+static void run_case(const char * name, const struct Allocator * mem_mgr, void * (*fn)(void *));
+static void * private_churn(void * arg);
+static void * hand_off(void * arg);
+static struct Vector * grown_vector(const struct Allocator * mem_mgr, uint64_t * seed);
+static uint64_t consume(struct Vector * vec);
+
+/* Local Variables */
+
+// One per thread: the vector most recently handed to it (or NULL)
+static struct Vector * Mailboxes[NUM_THREADS];
+
+/* Meat of the Program */
+
+int main(void)
+{
+   const struct Allocator malloc_mgr = DEFAULT_ALLOCATOR;
+   const struct Allocator tlheap_mgr = TLHEAP_ALLOCATOR;
+
+   bench_header("Private churn (4 threads x 5 live vectors, random lengths up to 1024)");
+   run_case("malloc", &malloc_mgr, private_churn);
+   run_case("thread-local heaps", &tlheap_mgr, private_churn);
+
+   bench_header("Hand-off (4 threads, each vector freed by the next thread over)");
+   run_case("malloc", &malloc_mgr, hand_off);
+   run_case("thread-local heaps", &tlheap_mgr, hand_off);
+
+   tlheap_destroy_all();
+   return 0;
+}
+
+/**
+ * @brief Runs fn on NUM_THREADS threads at once, timing until all are done.
+ */
+static void run_case(const char * name, const struct Allocator * mem_mgr, void * (*fn)(void *))
+{
+   struct Worker workers[NUM_THREADS];
+   uint64_t sum = 0;
+
+   struct BenchTimer timer;
+   bench_start(&timer);
+   for ( size_t t = 0; t < NUM_THREADS; t++ )
+   {
+      workers[t].idx = t;
+      workers[t].mem_mgr = mem_mgr;
+      workers[t].sum = 0;
+      if ( pthread_create(&workers[t].thread, NULL, fn, &workers[t]) != 0 )
+      {
+         fprintf(stderr, "Failed to start a thread\n");
+         exit(1);
+      }
+   }
+   for ( size_t t = 0; t < NUM_THREADS; t++ )
+   {
+      (void)pthread_join(workers[t].thread, NULL);
+      sum += workers[t].sum;
+   }
+   bench_stop(&timer);
+
+   // Whatever was left in flight
+   for ( size_t t = 0; t < NUM_THREADS; t++ )
+   {
+      sum += consume(Mailboxes[t]);
+      Mailboxes[t] = NULL;
+   }
+
+   BENCH_KEEP(sum);
+   bench_report(name, (size_t)NUM_THREADS * STEPS_PER_THREAD, &timer);
+}
+
+static void * private_churn(void * arg)
+{
+   struct Worker * self = arg;
+   struct Vector * slots[SLOTS_PER_THREAD] = {0};
+   uint64_t seed = SEED + self->idx;
+
+   for ( size_t step = 0; step < STEPS_PER_THREAD; step++ )
+   {
+      size_t slot = (size_t)(bench_rand(&seed) % SLOTS_PER_THREAD);
+      self->sum += consume(slots[slot]);
+      slots[slot] = grown_vector(self->mem_mgr, &seed);
+   }
+
+   for ( size_t i = 0; i < SLOTS_PER_THREAD; i++ )
+   {
+      self->sum += consume(slots[i]);
+   }
+   return NULL;
+}
+
+static void * hand_off(void * arg)
+{
+   struct Worker * self = arg;
+   uint64_t seed = SEED + self->idx;
+   struct Vector ** inbox = &Mailboxes[self->idx];
+   struct Vector ** outbox = &Mailboxes[(self->idx + 1) % NUM_THREADS];
+
+   for ( size_t step = 0; step < STEPS_PER_THREAD; step++ )
+   {
+      self->sum += consume( __atomic_exchange_n(inbox, NULL, __ATOMIC_ACQUIRE) );
+
+      // If the next thread hasn't gotten to our last vector yet, take it back
+      struct Vector * vec = grown_vector(self->mem_mgr, &seed);
+      self->sum += consume( __atomic_exchange_n(outbox, vec, __ATOMIC_ACQ_REL) );
+   }
+   return NULL;
+}
+
+static struct Vector * grown_vector(const struct Allocator * mem_mgr, uint64_t * seed)
+{
+   struct Vector * vec = VectorNew(sizeof(uint32_t), 0, MAX_LEN, 0, mem_mgr);
+   if ( NULL == vec )
+   {
+      fprintf(stderr, "Failed to create a vector\n");
+      exit(1);
+   }
+   uint32_t len = (uint32_t)(1 + (bench_rand(seed) % MAX_LEN));
+   for ( uint32_t i = 0; i < len; i++ )
+   {
+      (void)VectorPush(vec, &i);
+   }
+   return vec;
+}
+
+/**
+ * @brief Reads the last element of vec and frees it. NULL is a no-op.
+ */
+static uint64_t consume(struct Vector * vec)
+{
+   if ( NULL == vec )
+   {
+      return 0;
+   }
+   uint64_t last = *(uint32_t *)VectorLastElement(vec);
+   VectorFree(vec);
+   return last;
+}
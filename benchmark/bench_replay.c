@@ -0,0 +1,585 @@
+/**
+ * @file bench_replay.c
+ * @brief Replays a trace of vector calls (see VectorTraceStart) and times each.
+ *
+ *    bench_replay.out [trace file] [malloc|slab|tlheap]...
+ *
+ * The trace is decoded up front, then re-executed against the library once per
+ * allocator given (all three by default): first straight through for the total
+ * time, then call by call for the time of each kind of call. So a workload
+ * captured from production can be used to compare allocators, growth policies
+ * and build options (rebuild the library and replay the same trace).
+ *
+ * Element contents aren't in a trace, so zeroes are written instead. Calls on
+ * vectors that weren't created during the trace are skipped. Without a trace
+ * file, a made-up workload is recorded first, if the library was built with
+ * CCOL_TRACE.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 17, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+#include "vector.h"
+#include "alloc_slab.h"
+#include "alloc_tlheap.h"
+
+/* Local Macro Definitions */
+
+#define DEMO_TRACE_PATH "bench_replay_demo.trace"
+#define DEMO_STEPS      (100000)
+#define SEED            UINT64_C(0x9E3779B97F4A7C15)
+
+/* Local Datatypes */
+
+struct Trace
+{
+   struct VectorTraceRecord * recs;
+   size_t num_recs;
+   size_t num_handles;  // Highest handle + 1
+   size_t scratch_sz;   // Bytes of element data the largest call needs
+};
+
+struct OpTimes
+{
+   size_t calls;
+   size_t failures;
+   uint64_t total_ns;
+   uint64_t max_ns;
+};
+
+struct Replay
+{
+   const struct Trace * trace;
+   const struct Allocator * mem_mgr;
+   struct Vector ** vecs;   // By handle
+   uint8_t * scratch;
+   size_t skipped;
+};
+
+/* Local Variables */
+
+static const char * const OP_NAMES[VectorTraceOp_Count] = {
+   [VectorTraceOp_New]             = "New",
+   [VectorTraceOp_Free]            = "Free",
+   [VectorTraceOp_Duplicate]       = "Duplicate",
+   [VectorTraceOp_Move]            = "Move",
+   [VectorTraceOp_AreEqual]        = "AreEqual",
+   [VectorTraceOp_Push]            = "Push",
+   [VectorTraceOp_Insert]          = "Insert",
+   [VectorTraceOp_Get]             = "Get",
+   [VectorTraceOp_LastElement]     = "LastElement",
+   [VectorTraceOp_CpyElementAt]    = "CpyElementAt",
+   [VectorTraceOp_CpyLastElement]  = "CpyLastElement",
+   [VectorTraceOp_Set]             = "Set",
+   [VectorTraceOp_Remove]          = "Remove",
+   [VectorTraceOp_ClearElementAt]  = "ClearElementAt",
+   [VectorTraceOp_Reset]           = "Reset",
+   [VectorTraceOp_HardReset]       = "HardReset",
+   [VectorTraceOp_SplitAt]         = "SplitAt",
+   [VectorTraceOp_Slice]           = "Slice",
+   [VectorTraceOp_Concatenate]     = "Concatenate",
+   [VectorTraceOp_RangePush]       = "RangePush",
+   [VectorTraceOp_RangeInsert]     = "RangeInsert",
+   [VectorTraceOp_RangeCpy]        = "RangeCpy",
+   [VectorTraceOp_RangeSetWithArr] = "RangeSetWithArr",
+   [VectorTraceOp_RangeSetToVal]   = "RangeSetToVal",
+   [VectorTraceOp_RangeRemove]     = "RangeRemove",
+   [VectorTraceOp_RangeClear]      = "RangeClear",
+   [VectorTraceOp_NewAttr]         = "NewAttr",
+};
+
+/* Forward Function Declarations */
+
+static bool record_demo(void);
+static bool load_trace(const char * path, struct Trace * trace);
+static void run_replay(const struct Trace * trace, const char * alloc_name,
+                       const struct Allocator * mem_mgr);
+static bool replay_rec(struct Replay * replay, const struct VectorTraceRecord * rec);
+static void replay_adopt(struct Replay * replay, uint64_t handle, struct Vector * vec);
+static void replay_free_all(struct Replay * replay);
+
+/* Meat of the Program */
+
+int main(int argc, char * argv[])
+{
+   const char * path = (argc > 1) ? argv[1] : DEMO_TRACE_PATH;
+   if ( (argc < 2) && !record_demo() )
+   {
+      printf("usage: %s <trace file> [malloc|slab|tlheap]...\n", argv[0]);
+      printf("(record a trace with VectorTraceStart, in a build with CCOL_TRACE)\n");
+      return 0;
+   }
+
+   struct Trace trace;
+   if ( !load_trace(path, &trace) )
+   {
+      return 1;
+   }
+
+   struct SlabArena slab;
+   slab_init(&slab);
+   const struct Allocator malloc_mgr = DEFAULT_ALLOCATOR;
+   const struct Allocator slab_mgr = SLAB_ALLOCATOR(&slab);
+   const struct Allocator tlheap_mgr = TLHEAP_ALLOCATOR;
+
+   int num_allocs = (argc > 2) ? (argc - 2) : 3;
+   for ( int i = 0; i < num_allocs; i++ )
+   {
+      const char * name = (argc > 2) ? argv[i + 2] : (const char *[]){ "malloc", "slab", "tlheap" }[i];
+      if ( 0 == strcmp(name, "malloc") )       run_replay(&trace, name, &malloc_mgr);
+      else if ( 0 == strcmp(name, "slab") )    run_replay(&trace, name, &slab_mgr);
+      else if ( 0 == strcmp(name, "tlheap") )  run_replay(&trace, name, &tlheap_mgr);
+      else fprintf(stderr, "Unknown allocator \"%s\" (skipped)\n", name);
+   }
+
+   slab_destroy(&slab);
+   free(trace.recs);
+   if ( argc < 2 )
+   {
+      (void)remove(DEMO_TRACE_PATH);
+   }
+   return 0;
+}
+
+/**
+ * @brief Records a workload of vectors that grow, get inserted into and
+ *        removed from, get copied, and are freed again.
+ * @return false if the library can't record traces.
+ */
+static bool record_demo(void)
+{
+   if ( !VectorTraceStart(DEMO_TRACE_PATH) )
+   {
+      return false;
+   }
+
+   struct Vector * vecs[8] = {0};
+   uint64_t seed = SEED;
+   uint32_t val = 0;
+   for ( size_t step = 0; step < DEMO_STEPS; step++ )
+   {
+      struct Vector ** vec = &vecs[bench_rand(&seed) % 8];
+      uint64_t roll = bench_rand(&seed) % 100;
+      if ( NULL == *vec )
+      {
+         *vec = VectorNew(sizeof(uint32_t), 0, 1u << 16, 0, NULL);
+      }
+      else if ( roll < 60 )
+      {
+         (void)VectorPush(*vec, &val);
+      }
+      else if ( roll < 75 )
+      {
+         (void)VectorInsert(*vec, (size_t)(bench_rand(&seed) % (VectorLength(*vec) + 1)), &val);
+      }
+      else if ( roll < 90 )
+      {
+         (void)VectorRemoveLastElement(*vec, &val);
+      }
+      else if ( roll < 98 )
+      {
+         (void)VectorGet(*vec, (size_t)(bench_rand(&seed) % (VectorLength(*vec) + 1)));
+      }
+      else
+      {
+         struct Vector * dup = VectorDuplicate(*vec);
+         VectorFree(*vec);
+         *vec = dup;
+      }
+   }
+   for ( size_t i = 0; i < 8; i++ )
+   {
+      VectorFree(vecs[i]);
+   }
+   return VectorTraceStop();
+}
+
+static bool load_trace(const char * path, struct Trace * trace)
+{
+   memset( trace, 0, sizeof(struct Trace) );
+   trace->num_handles = 1; // Handle 0 (none) is never filed, but is looked up
+
+   FILE * file = fopen(path, "rb");
+   if ( NULL == file )
+   {
+      fprintf(stderr, "Couldn't open %s\n", path);
+      return false;
+   }
+   uint8_t * bytes = NULL;
+   size_t num_bytes = 0;
+   size_t cap = 0;
+   size_t got;
+   do
+   {
+      if ( num_bytes == cap )
+      {
+         cap = (0 == cap) ? 65536 : (cap * 2);
+         uint8_t * grown = realloc(bytes, cap);
+         if ( NULL == grown )
+         {
+            fprintf(stderr, "Out of memory reading %s\n", path);
+            free(bytes);
+            fclose(file);
+            return false;
+         }
+         bytes = grown;
+      }
+      got = fread(&bytes[num_bytes], 1, cap - num_bytes, file);
+      num_bytes += got;
+   } while ( got > 0 );
+   fclose(file);
+
+   if ( (num_bytes < VECTOR_TRACE_MAGIC_LEN) ||
+        (memcmp(bytes, VECTOR_TRACE_MAGIC, VECTOR_TRACE_MAGIC_LEN) != 0) )
+   {
+      fprintf(stderr, "%s isn't a vector trace\n", path);
+      free(bytes);
+      return false;
+   }
+
+   // Every record takes at least a byte
+   trace->recs = malloc((num_bytes - VECTOR_TRACE_MAGIC_LEN + 1) * sizeof(struct VectorTraceRecord));
+   if ( NULL == trace->recs )
+   {
+      fprintf(stderr, "Out of memory decoding %s\n", path);
+      free(bytes);
+      return false;
+   }
+
+   size_t used = VECTOR_TRACE_MAGIC_LEN;
+   size_t max_element_size = 1;
+   size_t max_elements = 1;
+   while ( used < num_bytes )
+   {
+      struct VectorTraceRecord * rec = &trace->recs[trace->num_recs];
+      size_t rec_sz = VectorTraceDecode(&bytes[used], num_bytes - used, rec);
+      if ( 0 == rec_sz )
+      {
+         fprintf(stderr, "%s is cut short or corrupt after %zu calls (replaying those)\n",
+                 path, trace->num_recs);
+         break;
+      }
+      used += rec_sz;
+      trace->num_recs++;
+
+      uint64_t handles[3] = { rec->handle, 0, 0 };
+      uint64_t elements = 1;
+      switch ( rec->op )
+      {
+         case VectorTraceOp_New:
+            max_element_size = (rec->args[0] > max_element_size) ? (size_t)rec->args[0] : max_element_size;
+            break;
+         case VectorTraceOp_Duplicate:
+         case VectorTraceOp_Move:
+         case VectorTraceOp_AreEqual:
+            handles[1] = rec->args[0];
+            break;
+         case VectorTraceOp_SplitAt:
+            handles[1] = rec->args[1];
+            break;
+         case VectorTraceOp_Slice:
+            handles[1] = rec->args[2];
+            break;
+         case VectorTraceOp_Concatenate:
+            handles[1] = rec->args[0];
+            handles[2] = rec->args[1];
+            break;
+         case VectorTraceOp_RangePush:
+            elements = rec->args[0];
+            break;
+         case VectorTraceOp_RangeInsert:
+         case VectorTraceOp_RangeCpy:
+         case VectorTraceOp_RangeSetWithArr:
+         case VectorTraceOp_RangeSetToVal:
+         case VectorTraceOp_RangeRemove:
+            elements = rec->args[1]; // The count, or the end of the range
+            break;
+         case VectorTraceOp_Free:
+         case VectorTraceOp_Push:
+         case VectorTraceOp_Insert:
+         case VectorTraceOp_Get:
+         case VectorTraceOp_LastElement:
+         case VectorTraceOp_CpyElementAt:
+         case VectorTraceOp_CpyLastElement:
+         case VectorTraceOp_Set:
+         case VectorTraceOp_Remove:
+         case VectorTraceOp_ClearElementAt:
+         case VectorTraceOp_Reset:
+         case VectorTraceOp_HardReset:
+         case VectorTraceOp_RangeClear:
+         case VectorTraceOp_NewAttr:
+         case VectorTraceOp_Count:
+         default:
+            break;
+      }
+      for ( size_t i = 0; i < 3; i++ )
+      {
+         if ( handles[i] >= trace->num_handles )
+         {
+            trace->num_handles = (size_t)handles[i] + 1;
+         }
+      }
+      max_elements = (elements > max_elements) ? (size_t)elements : max_elements;
+   }
+   free(bytes);
+
+   trace->scratch_sz = max_element_size * max_elements;
+   printf("Loaded %zu calls from %s\n", trace->num_recs, path);
+   return true;
+}
+
+static void run_replay(const struct Trace * trace, const char * alloc_name,
+                       const struct Allocator * mem_mgr)
+{
+   struct Replay replay = {
+      .trace = trace,
+      .mem_mgr = mem_mgr,
+      .vecs = calloc(trace->num_handles, sizeof(struct Vector *)),
+      .scratch = calloc(trace->scratch_sz, 1),
+      .skipped = 0
+   };
+   struct OpTimes times[VectorTraceOp_Count] = {0};
+   if ( (NULL == replay.vecs) || (NULL == replay.scratch) )
+   {
+      fprintf(stderr, "Out of memory replaying with %s\n", alloc_name);
+      free(replay.vecs);
+      free(replay.scratch);
+      return;
+   }
+
+   char title[128];
+   snprintf(title, sizeof(title), "Replay with %s: whole trace", alloc_name);
+   bench_header(title);
+   struct BenchTimer timer;
+   bench_start(&timer);
+   for ( size_t i = 0; i < trace->num_recs; i++ )
+   {
+      (void)replay_rec(&replay, &trace->recs[i]);
+   }
+   bench_stop(&timer);
+   replay_free_all(&replay);
+   bench_report("all calls", trace->num_recs, &timer);
+
+   // Each call timed on its own, which adds the clock's own overhead to each
+   replay.skipped = 0;
+   for ( size_t i = 0; i < trace->num_recs; i++ )
+   {
+      const struct VectorTraceRecord * rec = &trace->recs[i];
+      if ( VectorTraceOp_NewAttr == rec->op )
+      {
+         (void)replay_rec(&replay, rec);
+         continue; // Part of the New before it, which was timed with it
+      }
+      uint64_t start_ns = bench_now_ns();
+      bool ok = replay_rec(&replay, rec);
+      uint64_t elapsed_ns = bench_now_ns() - start_ns;
+
+      struct OpTimes * op = &times[rec->op];
+      op->calls++;
+      op->failures += ok ? 0 : 1;
+      op->total_ns += elapsed_ns;
+      op->max_ns = (elapsed_ns > op->max_ns) ? elapsed_ns : op->max_ns;
+   }
+   replay_free_all(&replay);
+
+   uint64_t clock_ns = UINT64_MAX;
+   for ( size_t i = 0; i < 1000; i++ )
+   {
+      uint64_t start_ns = bench_now_ns();
+      uint64_t elapsed_ns = bench_now_ns() - start_ns;
+      clock_ns = (elapsed_ns < clock_ns) ? elapsed_ns : clock_ns;
+   }
+   printf("\nReplay with %s: call by call (each incl. ~%llu ns of clock overhead)\n",
+          alloc_name, (unsigned long long)clock_ns);
+   printf("   %-20s %12s %10s %12s %12s\n", "call", "count", "failed", "mean (ns)", "max (ns)");
+   for ( size_t op = 1; op < VectorTraceOp_Count; op++ )
+   {
+      if ( times[op].calls > 0 )
+      {
+         printf("   %-20s %12zu %10zu %12.1f %12llu\n",
+                OP_NAMES[op], times[op].calls, times[op].failures,
+                (double)times[op].total_ns / (double)times[op].calls,
+                (unsigned long long)times[op].max_ns);
+      }
+   }
+   if ( replay.skipped > 0 )
+   {
+      printf("   (%zu calls on vectors not created in the trace were skipped)\n", replay.skipped);
+   }
+
+   free(replay.vecs);
+   free(replay.scratch);
+}
+
+/**
+ * @brief Makes the call a record stands for.
+ * @return Whether the call succeeded (false for a skipped call too).
+ */
+static bool replay_rec(struct Replay * replay, const struct VectorTraceRecord * rec)
+{
+   struct Vector * vec = replay->vecs[rec->handle];
+   void * buf = replay->scratch;
+   const uint64_t * args = rec->args;
+
+   if ( VectorTraceOp_New == rec->op )
+   {
+      // Attributes, if it had any, are in a NewAttr record right after
+      const struct VectorTraceRecord * next = rec + 1;
+      if ( (next < &replay->trace->recs[replay->trace->num_recs]) &&
+           (VectorTraceOp_NewAttr == next->op) && (next->handle == rec->handle) )
+      {
+         const struct VectorAttr attr = {
+            .stable_addresses = (next->args[0] & VECTOR_TRACE_ATTR_STABLE_ADDRESSES) != 0,
+            .alignment = (size_t)next->args[1],
+            .realtime = (next->args[0] & VECTOR_TRACE_ATTR_REALTIME) != 0,
+            .lock_memory = (next->args[0] & VECTOR_TRACE_ATTR_LOCK_MEMORY) != 0
+         };
+         vec = VectorNewWithAttr((size_t)args[0], (size_t)args[1], (size_t)args[2],
+                                 (size_t)args[3], replay->mem_mgr, &attr);
+      }
+      else
+      {
+         vec = VectorNew((size_t)args[0], (size_t)args[1], (size_t)args[2], (size_t)args[3],
+                         replay->mem_mgr);
+      }
+      replay_adopt(replay, rec->handle, vec);
+      return (vec != NULL);
+   }
+   if ( NULL == vec )
+   {
+      replay->skipped++;
+      return false;
+   }
+
+   bool ok = true;
+   struct Vector * other = NULL;
+   switch ( rec->op )
+   {
+      case VectorTraceOp_Free:
+         VectorFree(vec);
+         replay->vecs[rec->handle] = NULL;
+         break;
+      case VectorTraceOp_Duplicate:
+         other = VectorDuplicate(vec);
+         replay_adopt(replay, args[0], other);
+         ok = (other != NULL);
+         break;
+      case VectorTraceOp_Move:
+         ok = VectorMove(vec, replay->vecs[args[0]]);
+         break;
+      case VectorTraceOp_AreEqual:
+         (void)VectorsAreEqual(vec, replay->vecs[args[0]]);
+         break;
+      case VectorTraceOp_Push:
+         ok = VectorPush(vec, buf);
+         break;
+      case VectorTraceOp_Insert:
+         ok = VectorInsert(vec, (size_t)args[0], buf);
+         break;
+      case VectorTraceOp_Get:
+         ok = (VectorGet(vec, (size_t)args[0]) != NULL);
+         break;
+      case VectorTraceOp_LastElement:
+         ok = (VectorLastElement(vec) != NULL);
+         break;
+      case VectorTraceOp_CpyElementAt:
+         ok = VectorCpyElementAt(vec, (size_t)args[0], buf);
+         break;
+      case VectorTraceOp_CpyLastElement:
+         ok = VectorCpyLastElement(vec, buf);
+         break;
+      case VectorTraceOp_Set:
+         ok = VectorSet(vec, (size_t)args[0], buf);
+         break;
+      case VectorTraceOp_Remove:
+         ok = VectorRemove(vec, (size_t)args[0], args[1] ? buf : NULL);
+         break;
+      case VectorTraceOp_ClearElementAt:
+         ok = VectorClearElementAt(vec, (size_t)args[0]);
+         break;
+      case VectorTraceOp_Reset:
+         ok = VectorReset(vec);
+         break;
+      case VectorTraceOp_HardReset:
+         ok = VectorHardReset(vec);
+         break;
+      case VectorTraceOp_SplitAt:
+         other = VectorSplitAt(vec, (size_t)args[0]);
+         replay_adopt(replay, args[1], other);
+         ok = (other != NULL);
+         break;
+      case VectorTraceOp_Slice:
+         other = VectorSlice(vec, (size_t)args[0], (size_t)args[1]);
+         replay_adopt(replay, args[2], other);
+         ok = (other != NULL);
+         break;
+      case VectorTraceOp_Concatenate:
+         other = VectorConcatenate(vec, replay->vecs[args[0]]);
+         replay_adopt(replay, args[1], other);
+         ok = (other != NULL);
+         break;
+      case VectorTraceOp_RangePush:
+         ok = VectorRangePush(vec, buf, (size_t)args[0]);
+         break;
+      case VectorTraceOp_RangeInsert:
+         ok = VectorRangeInsert(vec, (size_t)args[0], buf, (size_t)args[1]);
+         break;
+      case VectorTraceOp_RangeCpy:
+         ok = VectorRangeCpy(vec, (size_t)args[0], (size_t)args[1], buf);
+         break;
+      case VectorTraceOp_RangeSetWithArr:
+         ok = VectorRangeSetWithArr(vec, (size_t)args[0], (size_t)args[1], buf);
+         break;
+      case VectorTraceOp_RangeSetToVal:
+         ok = VectorRangeSetToVal(vec, (size_t)args[0], (size_t)args[1], buf);
+         break;
+      case VectorTraceOp_RangeRemove:
+         ok = VectorRangeRemove(vec, (size_t)args[0], (size_t)args[1], args[2] ? buf : NULL);
+         break;
+      case VectorTraceOp_RangeClear:
+         ok = VectorRangeClear(vec, (size_t)args[0], (size_t)args[1]);
+         break;
+      case VectorTraceOp_NewAttr:
+         break; // Already applied by the New before it
+      case VectorTraceOp_New:
+      case VectorTraceOp_Count:
+      default:
+         ok = false;
+         break;
+   }
+   return ok;
+}
+
+/**
+ * @brief Files a vector created by a replayed call under the handle it was
+ *        given while recording (0 if the recorded call failed to create one).
+ */
+static void replay_adopt(struct Replay * replay, uint64_t handle, struct Vector * vec)
+{
+   if ( 0 == handle )
+   {
+      VectorFree(vec);
+      return;
+   }
+   // A handle is only reused after its vector was freed, unless the
+   // recording started partway through
+   VectorFree(replay->vecs[handle]);
+   replay->vecs[handle] = vec;
+}
+
+static void replay_free_all(struct Replay * replay)
+{
+   for ( size_t i = 0; i < replay->trace->num_handles; i++ )
+   {
+      VectorFree(replay->vecs[i]);
+      replay->vecs[i] = NULL;
+   }
+}
@@ -0,0 +1,327 @@
+/**
+ * @file bench_std_vector.cpp
+ * @brief Same workloads on a Vector and on a C++ std::vector<T>, for several
+ *        sizes of T, with ccol's throughput relative to std::vector's.
+ *
+ * The workloads:
+ *  - push:         push_back onto an empty container, from capacity 0
+ *  - random get:   reads at random indices of a filled container
+ *  - front insert: insert at index 0 (shifting every element each time)
+ *  - bulk append:  appending 64 elements at a time
+ *  - copy:         duplicating a filled container
+ * A relative throughput above 1 means ccol did better. Both sides use malloc,
+ * but std::vector can't realloc, so its growth always copies, where ccol's may
+ * extend the block in place (or, for large blocks, remap it). Every call is
+ * checked, and so is the final length on each side, so that a failed call
+ * can't pass for a fast one.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 17, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+#include "bench.h"
+#include "vector.h"
+
+/* Local Macro Definitions */
+
+#define PUSH_LEN     (256 * 1024)
+#define NUM_GETS     (1024 * 1024)
+#define FRONT_LEN    (4 * 1024)
+#define BULK_LEN     (64)
+#define NUM_COPIES   (64)
+#define NUM_ROUNDS   (8)
+#define SEED         UINT64_C(0x9E3779B97F4A7C15)
+
+/* Local Datatypes */
+
+template <size_t N>
+struct Elem
+{
+   uint8_t bytes[N];
+};
+
+// Time per op of the same workload on each side
+struct Result
+{
+   double ccol_ns;
+   double std_ns;
+};
+
+/* Forward Function Declarations */
+
+template <size_t N> static void run_size(void);
+template <size_t N> static Result run_push(void);
+template <size_t N> static Result run_random_get(void);
+template <size_t N> static Result run_front_insert(void);
+template <size_t N> static Result run_bulk_append(void);
+template <size_t N> static Result run_copy(void);
+static struct Vector * new_vector(size_t element_size);
+static void check(bool ok, const char * what);
+static double ns_per_op(const struct BenchTimer * timer, size_t ops);
+static void report(const char * workload, const Result & result);
+
+/* Meat of the Program */
+
+int main(void)
+{
+   run_size<4>();
+   run_size<16>();
+   run_size<64>();
+   return 0;
+}
+
+template <size_t N>
+static void run_size(void)
+{
+   std::printf("\n%zu-byte elements\n", N);
+   std::printf("   %-24s %12s %12s %12s\n", "workload", "ccol ns/op", "std ns/op", "ccol vs std");
+   report("push", run_push<N>());
+   report("random get", run_random_get<N>());
+   report("front insert", run_front_insert<N>());
+   report("bulk append", run_bulk_append<N>());
+   report("copy", run_copy<N>());
+}
+
+template <size_t N>
+static Result run_push(void)
+{
+   Result result = { 0.0, 0.0 };
+   Elem<N> elem = {};
+   uint64_t sum = 0;
+   struct BenchTimer timer;
+
+   bench_start(&timer);
+   for ( size_t round = 0; round < NUM_ROUNDS; round++ )
+   {
+      struct Vector * vec = new_vector(N);
+      for ( size_t i = 0; i < PUSH_LEN; i++ )
+      {
+         elem.bytes[0] = static_cast<uint8_t>(i);
+         check(VectorPush(vec, &elem), "push");
+      }
+      check(VectorLength(vec) == PUSH_LEN, "push length");
+      sum += static_cast<const Elem<N> *>(VectorLastElement(vec))->bytes[0];
+      VectorFree(vec);
+   }
+   bench_stop(&timer);
+   result.ccol_ns = ns_per_op(&timer, PUSH_LEN * NUM_ROUNDS);
+
+   bench_start(&timer);
+   for ( size_t round = 0; round < NUM_ROUNDS; round++ )
+   {
+      std::vector< Elem<N> > vec;
+      for ( size_t i = 0; i < PUSH_LEN; i++ )
+      {
+         elem.bytes[0] = static_cast<uint8_t>(i);
+         vec.push_back(elem);
+      }
+      check(vec.size() == PUSH_LEN, "push length");
+      sum += vec.back().bytes[0];
+   }
+   bench_stop(&timer);
+   result.std_ns = ns_per_op(&timer, PUSH_LEN * NUM_ROUNDS);
+
+   BENCH_KEEP(sum);
+   return result;
+}
+
+template <size_t N>
+static Result run_random_get(void)
+{
+   Result result = { 0.0, 0.0 };
+   struct Vector * vec = new_vector(N);
+   std::vector< Elem<N> > std_vec(PUSH_LEN);
+   check(VectorRangePush(vec, std_vec.data(), PUSH_LEN), "fill");
+   uint64_t sum = 0;
+   struct BenchTimer timer;
+
+   uint64_t seed = SEED;
+   bench_start(&timer);
+   for ( size_t i = 0; i < NUM_GETS; i++ )
+   {
+      size_t idx = static_cast<size_t>(bench_rand(&seed) % PUSH_LEN);
+      const Elem<N> * elem = static_cast<const Elem<N> *>(VectorGet(vec, idx));
+      check(elem != NULL, "get");
+      sum += elem->bytes[0];
+   }
+   bench_stop(&timer);
+   result.ccol_ns = ns_per_op(&timer, NUM_GETS);
+
+   seed = SEED;
+   bench_start(&timer);
+   for ( size_t i = 0; i < NUM_GETS; i++ )
+   {
+      size_t idx = static_cast<size_t>(bench_rand(&seed) % PUSH_LEN);
+      sum += std_vec[idx].bytes[0];
+   }
+   bench_stop(&timer);
+   result.std_ns = ns_per_op(&timer, NUM_GETS);
+
+   VectorFree(vec);
+   BENCH_KEEP(sum);
+   return result;
+}
+
+template <size_t N>
+static Result run_front_insert(void)
+{
+   Result result = { 0.0, 0.0 };
+   Elem<N> elem = {};
+   uint64_t sum = 0;
+   struct BenchTimer timer;
+
+   bench_start(&timer);
+   for ( size_t round = 0; round < NUM_ROUNDS; round++ )
+   {
+      struct Vector * vec = new_vector(N);
+      for ( size_t i = 0; i < FRONT_LEN; i++ )
+      {
+         elem.bytes[0] = static_cast<uint8_t>(i);
+         check(VectorInsert(vec, 0, &elem), "insert");
+      }
+      check(VectorLength(vec) == FRONT_LEN, "insert length");
+      sum += static_cast<const Elem<N> *>(VectorGet(vec, 0))->bytes[0];
+      VectorFree(vec);
+   }
+   bench_stop(&timer);
+   result.ccol_ns = ns_per_op(&timer, FRONT_LEN * NUM_ROUNDS);
+
+   bench_start(&timer);
+   for ( size_t round = 0; round < NUM_ROUNDS; round++ )
+   {
+      std::vector< Elem<N> > vec;
+      for ( size_t i = 0; i < FRONT_LEN; i++ )
+      {
+         elem.bytes[0] = static_cast<uint8_t>(i);
+         vec.insert(vec.begin(), elem);
+      }
+      check(vec.size() == FRONT_LEN, "insert length");
+      sum += vec.front().bytes[0];
+   }
+   bench_stop(&timer);
+   result.std_ns = ns_per_op(&timer, FRONT_LEN * NUM_ROUNDS);
+
+   BENCH_KEEP(sum);
+   return result;
+}
+
+template <size_t N>
+static Result run_bulk_append(void)
+{
+   Result result = { 0.0, 0.0 };
+   Elem<N> bulk[BULK_LEN] = {};
+   uint64_t sum = 0;
+   struct BenchTimer timer;
+
+   bench_start(&timer);
+   for ( size_t round = 0; round < NUM_ROUNDS; round++ )
+   {
+      struct Vector * vec = new_vector(N);
+      for ( size_t len = 0; len < PUSH_LEN; len += BULK_LEN )
+      {
+         bulk[0].bytes[0] = static_cast<uint8_t>(len);
+         check(VectorRangePush(vec, bulk, BULK_LEN), "bulk append");
+      }
+      check(VectorLength(vec) == PUSH_LEN, "bulk append length");
+      sum += VectorLength(vec);
+      VectorFree(vec);
+   }
+   bench_stop(&timer);
+   result.ccol_ns = ns_per_op(&timer, (PUSH_LEN / BULK_LEN) * NUM_ROUNDS);
+
+   bench_start(&timer);
+   for ( size_t round = 0; round < NUM_ROUNDS; round++ )
+   {
+      std::vector< Elem<N> > vec;
+      for ( size_t len = 0; len < PUSH_LEN; len += BULK_LEN )
+      {
+         bulk[0].bytes[0] = static_cast<uint8_t>(len);
+         vec.insert(vec.end(), bulk, bulk + BULK_LEN);
+      }
+      check(vec.size() == PUSH_LEN, "bulk append length");
+      sum += vec.size();
+   }
+   bench_stop(&timer);
+   result.std_ns = ns_per_op(&timer, (PUSH_LEN / BULK_LEN) * NUM_ROUNDS);
+
+   BENCH_KEEP(sum);
+   return result;
+}
+
+template <size_t N>
+static Result run_copy(void)
+{
+   Result result = { 0.0, 0.0 };
+   struct Vector * vec = new_vector(N);
+   std::vector< Elem<N> > std_vec(PUSH_LEN);
+   check(VectorRangePush(vec, std_vec.data(), PUSH_LEN), "fill");
+   uint64_t sum = 0;
+   struct BenchTimer timer;
+
+   bench_start(&timer);
+   for ( size_t i = 0; i < NUM_COPIES; i++ )
+   {
+      struct Vector * dup = VectorDuplicate(vec);
+      check((dup != NULL) && (VectorLength(dup) == PUSH_LEN), "copy");
+      sum += VectorLength(dup);
+      VectorFree(dup);
+   }
+   bench_stop(&timer);
+   result.ccol_ns = ns_per_op(&timer, NUM_COPIES);
+
+   bench_start(&timer);
+   for ( size_t i = 0; i < NUM_COPIES; i++ )
+   {
+      std::vector< Elem<N> > dup(std_vec);
+      check(dup.size() == PUSH_LEN, "copy");
+      sum += dup.size();
+   }
+   bench_stop(&timer);
+   result.std_ns = ns_per_op(&timer, NUM_COPIES);
+
+   VectorFree(vec);
+   BENCH_KEEP(sum);
+   return result;
+}
+
+static struct Vector * new_vector(size_t element_size)
+{
+   struct Vector * vec = VectorNew(element_size, 0, PUSH_LEN, 0, NULL);
+   if ( NULL == vec )
+   {
+      std::fprintf(stderr, "Failed to create a vector\n");
+      std::exit(1);
+   }
+   return vec;
+}
+
+/**
+ * @brief Gives up on the whole comparison if a call failed, since the time it
+ *        took would say nothing about the workload.
+ */
+static void check(bool ok, const char * what)
+{
+   if ( !ok )
+   {
+      std::fprintf(stderr, "Failed: %s\n", what);
+      std::exit(1);
+   }
+}
+
+static double ns_per_op(const struct BenchTimer * timer, size_t ops)
+{
+   return static_cast<double>(timer->elapsed_ns) / static_cast<double>(ops);
+}
+
+static void report(const char * workload, const Result & result)
+{
+   std::printf("   %-24s %12.2f %12.2f %11.2fx\n", workload,
+               result.ccol_ns, result.std_ns, result.std_ns / result.ccol_ns);
+}
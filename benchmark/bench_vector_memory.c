@@ -0,0 +1,276 @@
+/**
+ * @file bench_vector_memory.c
+ * @brief Memory cost of vectors as they grow, reset, hard-reset and churn,
+ *        per element size and allocator.
+ *
+ * Each case fills 16 vectors to random lengths, resets them (VectorReset keeps
+ * the arrays), hard-resets them (VectorHardReset frees them), and then churns
+ * them (free, new, refill), reporting after each phase:
+ *  - elements:  elements held across the vectors
+ *  - slack %:   share of the arrays' capacity not holding elements
+ *  - B/elem:    bytes held from the allocator plus the handles in use, per
+ *               element (element size plus everything else)
+ *  - alloc ovh: bytes the allocator hands out beyond the capacity asked for
+ *               (usable size, so block headers don't show here...)
+ *  - RSS, peak: ...but they do show in the resident set size, and its peak
+ *               since the case started (if the system allows it to be reset)
+ * Each case runs in a child process of its own, so memory an allocator keeps
+ * cached from an earlier case doesn't skew the resident set of the next.
+ * Nothing here is timed, so unlike the other benchmarks, this one doesn't read
+ * or report hardware counters either.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 17, 2026
+ * @copyright MIT License
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200809L // fork
+#define BENCH_HAS_FORK
+#endif
+
+/* File Inclusions */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef BENCH_HAS_FORK
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#endif
+
+#include "bench.h"
+#include "vector.h"
+#include "alloc_slab.h"
+#include "alloc_tlheap.h"
+#include "alloc_stats.h"
+
+/* Local Macro Definitions */
+
+#define NUM_VECS         (16)               // Must stay below VEC_STRUCT_POOL_SIZE
+#define VEC_MAX_BYTES    (4 * 1024 * 1024)
+#define MAX_ELEMENT_SIZE (256)
+#define NUM_CHURN_STEPS  (32)
+#define SEED             UINT64_C(0x9E3779B97F4A7C15)
+
+/* Local Datatypes */
+
+enum MemMgrKind
+{
+   MemMgrKind_Malloc,
+   MemMgrKind_Slab,
+   MemMgrKind_TLHeap,
+   MemMgrKind_Count
+};
+
+struct Baseline
+{
+   size_t rss;
+   bool peak_reset;
+   size_t handle_bytes;
+};
+
+/* Local Variables */
+
+static const char * const MEM_MGR_NAMES[MemMgrKind_Count] = { "malloc", "slab", "tlheap" };
+static const size_t ELEMENT_SIZES[] = { 4, 32, MAX_ELEMENT_SIZE };
+
+static uint8_t Element[MAX_ELEMENT_SIZE];
+
+/* Forward Function Declarations */
+
+static void run_isolated(size_t element_size, enum MemMgrKind kind);
+static void run_case(size_t element_size, enum MemMgrKind kind);
+static void fill(struct Vector * vec, size_t len);
+static void report(const char * name, const char * phase, const struct StatsArena * stats,
+                   size_t element_size, const struct Baseline * base);
+
+/* Meat of the Program */
+
+int main(void)
+{
+   memset(Element, 0xA5, sizeof(Element));
+
+   struct VectorPoolInfo info;
+   (void)VectorPoolInfoGet(&info);
+   printf("\nHandle pool: %zu handles, %zu B of static memory (%zu B each)\n",
+          info.pool_size, info.pool_bytes, info.pool_bytes / info.pool_size);
+
+   for ( size_t e = 0; e < sizeof(ELEMENT_SIZES) / sizeof(ELEMENT_SIZES[0]); e++ )
+   {
+      char title[96];
+      (void)snprintf(title, sizeof(title), "%zu-byte elements: %d vectors of up to %zu elements",
+                     ELEMENT_SIZES[e], NUM_VECS, VEC_MAX_BYTES / ELEMENT_SIZES[e]);
+      printf("\n%s\n", title);
+      printf("   %-24s %10s %8s %8s %10s %10s %10s\n", "case", "elements", "slack %",
+             "B/elem", "alloc ovh", "RSS KiB", "peak KiB");
+
+      for ( int kind = 0; kind < MemMgrKind_Count; kind++ )
+      {
+         run_isolated(ELEMENT_SIZES[e], (enum MemMgrKind)kind);
+      }
+   }
+   return 0;
+}
+
+/**
+ * @brief Runs a case in a child process where possible, in this one otherwise.
+ */
+static void run_isolated(size_t element_size, enum MemMgrKind kind)
+{
+#ifdef BENCH_HAS_FORK
+   (void)fflush(stdout); // Or the child prints it all again
+   pid_t child = fork();
+   if ( 0 == child )
+   {
+      run_case(element_size, kind);
+      (void)fflush(stdout);
+      _exit(0);
+   }
+   if ( child > 0 )
+   {
+      int status = 0;
+      if ( (waitpid(child, &status, 0) != child) || !WIFEXITED(status) || (WEXITSTATUS(status) != 0) )
+      {
+         fprintf(stderr, "Case %s failed\n", MEM_MGR_NAMES[kind]);
+         exit(1);
+      }
+      return;
+   }
+#endif
+   run_case(element_size, kind);
+}
+
+static void run_case(size_t element_size, enum MemMgrKind kind)
+{
+   struct SlabArena slab;
+   struct Allocator inner = DEFAULT_ALLOCATOR;
+   if ( MemMgrKind_Slab == kind )
+   {
+      slab_init(&slab);
+      inner = SLAB_ALLOCATOR(&slab);
+   }
+   else if ( MemMgrKind_TLHeap == kind )
+   {
+      inner = TLHEAP_ALLOCATOR;
+   }
+   struct StatsArena stats;
+   const struct Allocator mem_mgr = stats_wrap(&stats, &inner);
+
+   struct VectorPoolInfo info;
+   (void)VectorPoolInfoGet(&info);
+   struct Baseline base =
+   {
+      .rss = bench_rss_bytes(),
+      .peak_reset = bench_peak_rss_reset(),
+      .handle_bytes = info.pool_bytes / info.pool_size,
+   };
+
+   const size_t max_len = VEC_MAX_BYTES / element_size;
+   const char * name = MEM_MGR_NAMES[kind];
+   struct Vector * vecs[NUM_VECS] = {0};
+   uint64_t seed = SEED;
+
+   for ( size_t i = 0; i < NUM_VECS; i++ )
+   {
+      vecs[i] = VectorNew(element_size, 1, max_len, 0, &mem_mgr);
+      fill(vecs[i], 1 + (size_t)(bench_rand(&seed) % max_len));
+   }
+   report(name, "grown", &stats, element_size, &base);
+
+   for ( size_t i = 0; i < NUM_VECS; i++ )
+   {
+      (void)VectorReset(vecs[i]);
+   }
+   report(name, "reset", &stats, element_size, &base);
+
+   for ( size_t i = 0; i < NUM_VECS; i++ )
+   {
+      (void)VectorHardReset(vecs[i]);
+   }
+   report(name, "hard reset", &stats, element_size, &base);
+
+   for ( size_t step = 0; step < NUM_CHURN_STEPS; step++ )
+   {
+      size_t slot = (size_t)(bench_rand(&seed) % NUM_VECS);
+      VectorFree(vecs[slot]);
+      vecs[slot] = VectorNew(element_size, 1, max_len, 0, &mem_mgr);
+      fill(vecs[slot], 1 + (size_t)(bench_rand(&seed) % max_len));
+   }
+   report(name, "churned", &stats, element_size, &base);
+
+   for ( size_t i = 0; i < NUM_VECS; i++ )
+   {
+      VectorFree(vecs[i]);
+   }
+   if ( MemMgrKind_Slab == kind )
+   {
+      slab_destroy(&slab);
+   }
+   else if ( MemMgrKind_TLHeap == kind )
+   {
+      tlheap_destroy_all();
+   }
+}
+
+/**
+ * @brief Pushes len elements onto vec one at a time, so that it grows by the
+ *        growth factor (a range push would grow it to fit exactly).
+ */
+static void fill(struct Vector * vec, size_t len)
+{
+   if ( NULL == vec )
+   {
+      fprintf(stderr, "Failed to create a vector\n");
+      exit(1);
+   }
+
+   for ( size_t i = 0; i < len; i++ )
+   {
+      if ( !VectorPush(vec, Element) )
+      {
+         fprintf(stderr, "Failed to push\n");
+         exit(1);
+      }
+   }
+}
+
+static void report(const char * name, const char * phase, const struct StatsArena * stats,
+                   size_t element_size, const struct Baseline * base)
+{
+   struct VectorPoolInfo info;
+   struct AllocStats snapshot;
+   (void)VectorPoolInfoGet(&info);
+   stats_snapshot(stats, &snapshot);
+
+   size_t elements = info.length_bytes / element_size;
+   size_t held = snapshot.live_bytes + (info.in_use * base->handle_bytes);
+   double slack_pct = (info.capacity_bytes > 0) ?
+                      (100.0 * (double)info.slack_bytes / (double)info.capacity_bytes) : 0.0;
+   long long alloc_ovh = (long long)snapshot.live_bytes - (long long)info.capacity_bytes;
+   long long rss_kib = ((long long)bench_rss_bytes() - (long long)base->rss) / 1024;
+
+   char case_name[64];
+   (void)snprintf(case_name, sizeof(case_name), "%s, %s", name, phase);
+   printf("   %-24s %10zu %8.1f ", case_name, elements, slack_pct);
+   if ( elements > 0 )
+   {
+      printf("%8.1f ", (double)held / (double)elements);
+   }
+   else
+   {
+      printf("%8s ", "-");
+   }
+   printf("%10lld %10lld ", alloc_ovh, rss_kib);
+   if ( base->peak_reset )
+   {
+      printf("%10lld\n", ((long long)bench_peak_rss_bytes() - (long long)base->rss) / 1024);
+   }
+   else
+   {
+      printf("%10s\n", "-");
+   }
+}
@@ -0,0 +1,100 @@
+/**
+ * @file bench_vector_realtime.c
+ * @brief Per-push latency of realtime vectors vs. regular ones.
+ *
+ * Fresh vectors are filled up to their max capacity over and over, with every
+ * push timed. A regular vector pays for reallocations and for the first touch
+ * of every new page along the way; a realtime vector paid for both up front,
+ * in VectorNewWithAttr, which is timed separately. The hardware counters per
+ * push are read around the whole case, VectorNewWithAttr included, so they
+ * compare the total work each kind of vector takes for the same pushes.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bench.h"
+#include "vector.h"
+
+/* Local Macro Definitions */
+
+#define MAX_LEN      (256 * 1024)
+#define NUM_ROUNDS   (8)
+#define NUM_SAMPLES  ( (size_t)MAX_LEN * NUM_ROUNDS )
+
+/* Forward Function Declarations */
+
+static void run_case(const char * name, const struct VectorAttr * attr, uint64_t * samples);
+
+/* Meat of the Program */
+
+int main(void)
+{
+   uint64_t * samples = malloc(NUM_SAMPLES * sizeof(uint64_t));
+   if ( NULL == samples )
+   {
+      fprintf(stderr, "Failed to allocate the samples\n");
+      return 1;
+   }
+
+   bench_latency_header("VectorPush: fresh vectors filled to 262144 8-byte elements");
+   run_case("regular", &(struct VectorAttr){ .realtime = false }, samples);
+   run_case("realtime", &(struct VectorAttr){ .realtime = true }, samples);
+   run_case("realtime, locked", &(struct VectorAttr){ .realtime = true, .lock_memory = true }, samples);
+
+   free(samples);
+   return 0;
+}
+
+static void run_case(const char * name, const struct VectorAttr * attr, uint64_t * samples)
+{
+   struct BenchTimer case_timer;
+   struct BenchTimer new_timer = {0};
+   uint64_t new_ns = 0;
+   size_t n = 0;
+   uint64_t sum = 0;
+
+   bench_start(&case_timer);
+   for ( size_t round = 0; round < NUM_ROUNDS; round++ )
+   {
+      bench_start(&new_timer);
+      struct Vector * vec = VectorNewWithAttr(sizeof(uint64_t), 1, MAX_LEN, 0, NULL, attr);
+      bench_stop(&new_timer);
+      if ( NULL == vec )
+      {
+         // Most likely lock_memory running into RLIMIT_MEMLOCK
+         printf("%-32s (could not be created here)\n", name);
+         return;
+      }
+      new_ns += new_timer.elapsed_ns;
+
+      for ( uint64_t i = 0; i < MAX_LEN; i++ )
+      {
+         uint64_t start = bench_now_ns();
+         bool pushed = VectorPush(vec, &i);
+         samples[n++] = bench_now_ns() - start;
+         if ( !pushed )
+         {
+            fprintf(stderr, "Failed to push\n");
+            exit(1);
+         }
+      }
+      sum += *(uint64_t *)VectorLastElement(vec);
+      sum += VectorRealtimeViolations(vec);
+      VectorFree(vec);
+   }
+   bench_stop(&case_timer);
+
+   BENCH_KEEP(sum);
+   char title[64];
+   (void)snprintf(title, sizeof(title), "%s (new: %llu us)",
+                  name, (unsigned long long)(new_ns / NUM_ROUNDS / 1000));
+   bench_report_latency(title, samples, n, &case_timer);
+}
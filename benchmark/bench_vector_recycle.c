@@ -0,0 +1,88 @@
+/**
+ * @file bench_vector_recycle.c
+ * @brief Identically shaped vectors created and freed in a loop, with and
+ *        without recycling of freed arrays.
+ *
+ * This is the pattern of a request loop: each request builds a few vectors of
+ * the same element sizes, grows them to similar lengths, and frees them all
+ * before the next request. Without recycling, every request goes through the
+ * whole allocate/grow/free cycle again.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "bench.h"
+#include "vector.h"
+
+/* Local Macro Definitions */
+
+#define NUM_REQUESTS    (200000)
+#define VECS_PER_REQ    (4)
+#define MAX_LEN         (256)
+#define MIN_LEN         (64)
+#define SEED            UINT64_C(0x9E3779B97F4A7C15)
+
+/* Forward Function Declarations */
+
+static void run_case(const char * name, size_t budget);
+
+/* Meat of the Program */
+
+int main(void)
+{
+   bench_header("Request loop (4 vectors per request, 64-256 elements each)");
+   run_case("no recycling", 0);
+   run_case("recycling (16 KiB budget)", (size_t)16 * 1024);
+
+   VectorRecycleSetBudget(VEC_RECYCLE_BUDGET);
+   return 0;
+}
+
+static void run_case(const char * name, size_t budget)
+{
+   const size_t ELEMENT_SIZES[VECS_PER_REQ] = { 4, 8, 4, 16 };
+   uint8_t element[16] = {0};
+   uint64_t seed = SEED;
+   uint64_t sum = 0;
+
+   VectorRecycleSetBudget(budget);
+
+   struct BenchTimer timer;
+   bench_start(&timer);
+   for ( size_t req = 0; req < NUM_REQUESTS; req++ )
+   {
+      struct Vector * vecs[VECS_PER_REQ];
+      for ( size_t v = 0; v < VECS_PER_REQ; v++ )
+      {
+         vecs[v] = VectorNew(ELEMENT_SIZES[v], 0, MAX_LEN, 0, NULL);
+         if ( NULL == vecs[v] )
+         {
+            fprintf(stderr, "Failed to create a vector\n");
+            exit(1);
+         }
+         size_t len = MIN_LEN + (size_t)(bench_rand(&seed) % (MAX_LEN - MIN_LEN));
+         for ( size_t i = 0; i < len; i++ )
+         {
+            element[0] = (uint8_t)i;
+            (void)VectorPush(vecs[v], element);
+         }
+         sum += *(uint8_t *)VectorLastElement(vecs[v]);
+      }
+      for ( size_t v = 0; v < VECS_PER_REQ; v++ )
+      {
+         VectorFree(vecs[v]);
+      }
+   }
+   bench_stop(&timer);
+
+   VectorRecycleFlush();
+   BENCH_KEEP(sum);
+   bench_report(name, NUM_REQUESTS, &timer);
+}
@@ -0,0 +1,188 @@
+/**
+ * @file bench_vector_tail_latency.c
+ * @brief Tail latency of VectorPush, VectorInsert and VectorRangePush, per
+ *        growth policy and allocator.
+ *
+ * Every call is timed on its own and recorded into a BenchHisto, so the tail
+ * (where a realloc, a copy of the whole array or a page fault lands) shows up
+ * next to the median instead of vanishing into a mean. The growth policies:
+ *  - doubling: starts at capacity 1 and grows by EXPANSION_FACTOR
+ *  - reserved: initial capacity of max_capacity, so it never grows
+ *  - stable:   stable_addresses, committing pages of a reservation as it grows
+ *  - realtime: realtime, allocated and prefaulted in VectorNewWithAttr
+ * The last two don't use the allocator for growth, so they are run with malloc
+ * only. Each timed call includes one clock read (see the p50 of "reserved").
+ * The hardware counters under each case are read around the whole case, so
+ * their per-call figures also take in the clock reads and the vectors' setup.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 17, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bench.h"
+#include "vector.h"
+#include "alloc_slab.h"
+#include "alloc_tlheap.h"
+
+/* Local Macro Definitions */
+
+#define MAX_LEN         (64 * 1024)
+#define INSERT_MAX_LEN  (8 * 1024)   // Inserts shift half the vector on average
+#define RANGE_LEN       (16)
+#define NUM_ROUNDS      (8)
+#define SEED            UINT64_C(0x9E3779B97F4A7C15)
+
+/* Local Datatypes */
+
+enum LatencyOp
+{
+   LatencyOp_Push,
+   LatencyOp_Insert,
+   LatencyOp_RangePush
+};
+
+struct GrowthPolicy
+{
+   const char * name;
+   bool reserve;
+   struct VectorAttr attr;
+   bool any_allocator;
+};
+
+/* Local Variables */
+
+static const struct GrowthPolicy POLICIES[] =
+{
+   { .name = "doubling", .any_allocator = true },
+   { .name = "reserved", .reserve = true, .any_allocator = true },
+   { .name = "stable", .attr = { .stable_addresses = true } },
+   { .name = "realtime", .attr = { .realtime = true } },
+};
+
+// Too big to comfortably live on the stack
+static struct BenchHisto Histo;
+
+/* Forward Function Declarations */
+
+static void run_op(enum LatencyOp op, const struct Allocator * mem_mgrs,
+                   const char * const * mem_mgr_names, size_t num_mem_mgrs);
+static bool run_case(enum LatencyOp op, const struct GrowthPolicy * policy,
+                     const struct Allocator * mem_mgr, struct BenchTimer * timer);
+
+/* Meat of the Program */
+
+int main(void)
+{
+   struct SlabArena slab;
+   slab_init(&slab);
+
+   const struct Allocator mem_mgrs[] =
+   {
+      DEFAULT_ALLOCATOR,
+      SLAB_ALLOCATOR(&slab),
+      TLHEAP_ALLOCATOR,
+   };
+   const char * const mem_mgr_names[] = { "malloc", "slab", "tlheap" };
+   const size_t num_mem_mgrs = sizeof(mem_mgrs) / sizeof(mem_mgrs[0]);
+
+   bench_latency_header("VectorPush: 8 rounds of filling to 65536 8-byte elements");
+   run_op(LatencyOp_Push, mem_mgrs, mem_mgr_names, num_mem_mgrs);
+
+   bench_latency_header("VectorInsert at random indices: 8 rounds of filling to 8192 elements");
+   run_op(LatencyOp_Insert, mem_mgrs, mem_mgr_names, num_mem_mgrs);
+
+   bench_latency_header("VectorRangePush of 16 elements: 8 rounds of filling to 65536 elements");
+   run_op(LatencyOp_RangePush, mem_mgrs, mem_mgr_names, num_mem_mgrs);
+
+   tlheap_destroy_all();
+   slab_destroy(&slab);
+   return 0;
+}
+
+static void run_op(enum LatencyOp op, const struct Allocator * mem_mgrs,
+                   const char * const * mem_mgr_names, size_t num_mem_mgrs)
+{
+   for ( size_t p = 0; p < sizeof(POLICIES) / sizeof(POLICIES[0]); p++ )
+   {
+      size_t runs = POLICIES[p].any_allocator ? num_mem_mgrs : 1;
+      for ( size_t m = 0; m < runs; m++ )
+      {
+         char name[64];
+         (void)snprintf(name, sizeof(name), "%s, %s", POLICIES[p].name, mem_mgr_names[m]);
+         struct BenchTimer timer;
+         if ( run_case(op, &POLICIES[p], &mem_mgrs[m], &timer) )
+         {
+            bench_report_histo(name, &Histo, &timer);
+         }
+         else
+         {
+            printf("   %-32s (could not be created here)\n", name);
+         }
+      }
+   }
+}
+
+static bool run_case(enum LatencyOp op, const struct GrowthPolicy * policy,
+                     const struct Allocator * mem_mgr, struct BenchTimer * timer)
+{
+   const size_t max_len = (LatencyOp_Insert == op) ? INSERT_MAX_LEN : MAX_LEN;
+   const size_t step = (LatencyOp_RangePush == op) ? RANGE_LEN : 1;
+   uint64_t range[RANGE_LEN] = {0};
+   uint64_t seed = SEED;
+   uint64_t sum = 0;
+
+   bench_histo_clear(&Histo);
+   bench_start(timer);
+   for ( size_t round = 0; round < NUM_ROUNDS; round++ )
+   {
+      struct Vector * vec = VectorNewWithAttr(sizeof(uint64_t), policy->reserve ? max_len : 1,
+                                              max_len, 0, mem_mgr, &policy->attr);
+      if ( NULL == vec )
+      {
+         return false;
+      }
+
+      for ( size_t len = 0; len < max_len; len += step )
+      {
+         uint64_t val = (uint64_t)len;
+         size_t idx = (size_t)( bench_rand(&seed) % (len + 1) );
+         bool done = false;
+
+         uint64_t start = bench_now_ns();
+         switch ( op )
+         {
+            case LatencyOp_Push:
+               done = VectorPush(vec, &val);
+               break;
+            case LatencyOp_Insert:
+               done = VectorInsert(vec, idx, &val);
+               break;
+            case LatencyOp_RangePush:
+               done = VectorRangePush(vec, range, RANGE_LEN);
+               break;
+            default:
+               break;
+         }
+         bench_histo_record(&Histo, bench_now_ns() - start);
+
+         if ( !done )
+         {
+            fprintf(stderr, "Failed to add to the vector\n");
+            exit(1);
+         }
+      }
+      sum += *(uint64_t *)VectorLastElement(vec);
+      VectorFree(vec);
+   }
+   bench_stop(timer);
+
+   BENCH_KEEP(sum);
+   return true;
+}
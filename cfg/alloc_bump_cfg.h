@@ -0,0 +1,20 @@
+/**
+ * @file alloc_bump_cfg.h
+ * @brief Configuration of aspects of the bump (arena) allocator.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stddef.h>
+
+/* Public Macro Definitions */
+
+//! Every block handed out by the bump allocator starts at a multiple of this
+//! many bytes (a power of two). Defaults to what malloc guarantees on typical
+//! 64-bit platforms, so that any element type is safe to store.
+#ifndef BUMP_DEFAULT_ALIGNMENT // Define at compile-command time if desired
+#define BUMP_DEFAULT_ALIGNMENT ( (size_t)16 )
+#endif // BUMP_DEFAULT_ALIGNMENT
@@ -0,0 +1,34 @@
+/**
+ * @file alloc_mmap_cfg.h
+ * @brief Configuration of aspects of the mmap-backed allocator.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stddef.h>
+
+/* Public Macro Definitions */
+
+//! Blocks at or above this size (in bytes) are mapped directly from the OS
+//! when no struct MmapArena is provided. Below it, the overhead of a syscall
+//! and a whole page per block isn't worth it.
+#ifndef MMAP_DEFAULT_THRESHOLD // Define at compile-command time if desired
+#define MMAP_DEFAULT_THRESHOLD ( (size_t)1 << 20 )
+#endif // MMAP_DEFAULT_THRESHOLD
+
+//! Huge page policy used when no struct MmapArena is provided (one of enum
+//! MmapHugePages, see alloc_mmap.h). Off by default: huge pages round every
+//! mapping up to MMAP_HUGE_PAGE_SIZE, which only pays off for big buffers.
+#ifndef MMAP_DEFAULT_HUGE_PAGES // Define at compile-command time if desired
+#define MMAP_DEFAULT_HUGE_PAGES MmapHugePages_Off
+#endif // MMAP_DEFAULT_HUGE_PAGES
+
+//! Size of the huge pages the allocator aims for (2 MiB on x86-64 and most
+//! AArch64 setups). Mappings of at least this size are rounded up to and
+//! aligned on a multiple of it when huge pages are requested.
+#ifndef MMAP_HUGE_PAGE_SIZE // Define at compile-command time if desired
+#define MMAP_HUGE_PAGE_SIZE ( (size_t)2 << 20 )
+#endif // MMAP_HUGE_PAGE_SIZE
@@ -0,0 +1,39 @@
+/**
+ * @file alloc_slab_cfg.h
+ * @brief Configuration of aspects of the size-class slab allocator.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stddef.h>
+
+/* Public Macro Definitions */
+
+//! Smallest size class is 2^SLAB_MIN_CLASS_SHIFT bytes. Must be large enough
+//! to hold a pointer (free lists are threaded through free blocks).
+#ifndef SLAB_MIN_CLASS_SHIFT // Define at compile-command time if desired
+#define SLAB_MIN_CLASS_SHIFT 4
+#endif // SLAB_MIN_CLASS_SHIFT
+
+//! Largest size class is 2^SLAB_MAX_CLASS_SHIFT bytes. Anything bigger goes
+//! straight to malloc, where a recycled block would save comparatively little.
+#ifndef SLAB_MAX_CLASS_SHIFT // Define at compile-command time if desired
+#define SLAB_MAX_CLASS_SHIFT 16
+#endif // SLAB_MAX_CLASS_SHIFT
+
+//! Blocks are carved out of chunks of this many bytes, obtained from malloc as
+//! needed and only given back by slab_destroy.
+#ifndef SLAB_CHUNK_SIZE // Define at compile-command time if desired
+#define SLAB_CHUNK_SIZE (256u * 1024u)
+#endif // SLAB_CHUNK_SIZE
+
+#if (SLAB_MIN_CLASS_SHIFT < 4) || (SLAB_MIN_CLASS_SHIFT > SLAB_MAX_CLASS_SHIFT)
+#error "SLAB_MIN_CLASS_SHIFT must be at least 4 and at most SLAB_MAX_CLASS_SHIFT"
+#endif
+
+#if (1u << SLAB_MAX_CLASS_SHIFT) > (SLAB_CHUNK_SIZE / 2u)
+#error "SLAB_CHUNK_SIZE must fit at least two blocks of the largest size class"
+#endif
@@ -0,0 +1,49 @@
+/**
+ * @file alloc_stats_cfg.h
+ * @brief Configuration of aspects of the statistics-gathering allocator.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stddef.h>
+
+/* Public Macro Definitions */
+
+//! One in this many alloc/realloc calls is timed. Reading the clock costs
+//! about as much as a malloc fast path, so timing every call would double the
+//! cost being measured. Set to 1 to time every call, or 0 to time none.
+#ifndef STATS_LATENCY_SAMPLE_PERIOD // Define at compile-command time if desired
+#define STATS_LATENCY_SAMPLE_PERIOD (16u)
+#endif // STATS_LATENCY_SAMPLE_PERIOD
+
+//! When non-zero, a wrapper may be shared by several threads: each counts into
+//! a slot of its own (see STATS_THREAD_SLOTS), and live bytes are updated
+//! atomically. Set to 0 if each wrapper is only ever used from one thread at a
+//! time, which saves the one atomic operation left per call.
+#ifndef STATS_THREAD_SAFE // Define at compile-command time if desired
+#define STATS_THREAD_SAFE 1
+#endif // STATS_THREAD_SAFE
+
+//! Threads that get counters of their own in every wrapper, so that counting
+//! never contends. Any threads beyond that share the last slot, which they
+//! update atomically. A thread keeps its slot after it exits, so count every
+//! thread that ever allocates through a wrapper. Each slot takes about 750 B of
+//! every struct StatsArena.
+#ifndef STATS_THREAD_SLOTS // Define at compile-command time if desired
+#define STATS_THREAD_SLOTS (8u)
+#endif // STATS_THREAD_SLOTS
+
+//! Number of buckets in the realloc size histogram. Bucket i counts reallocs to
+//! a new size in [2^i, 2^(i+1)) bytes, with the last bucket taking the rest.
+#ifndef STATS_SIZE_BUCKETS // Define at compile-command time if desired
+#define STATS_SIZE_BUCKETS (48u)
+#endif // STATS_SIZE_BUCKETS
+
+//! Number of buckets in the latency histogram. Bucket i counts calls that took
+//! [2^i, 2^(i+1)) ns, with the last bucket taking the rest.
+#ifndef STATS_LATENCY_BUCKETS // Define at compile-command time if desired
+#define STATS_LATENCY_BUCKETS (32u)
+#endif // STATS_LATENCY_BUCKETS
@@ -0,0 +1,21 @@
+/**
+ * @file alloc_tlheap_cfg.h
+ * @brief Configuration of aspects of the thread-local heap allocator.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stddef.h>
+
+/* Public Macro Definitions */
+
+//! When non-zero, a thread's heap is handed back for adoption automatically
+//! when the thread exits (through a pthread key destructor). When zero, threads
+//! must call tlheap_thread_detach themselves before exiting, or their heap will
+//! sit unused until tlheap_destroy_all.
+#ifndef TLHEAP_AUTO_DETACH // Define at compile-command time if desired
+#define TLHEAP_AUTO_DETACH 1
+#endif // TLHEAP_AUTO_DETACH
@@ -0,0 +1,38 @@
+/**
+ * @file alloc_tlsf_cfg.h
+ * @brief Configuration of aspects of the TLSF allocator.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stddef.h>
+
+/* Public Macro Definitions */
+
+//! Each power-of-two range of block sizes is split into 2^TLSF_SL_LOG2 free
+//! lists. More lists means a tighter fit (less internal fragmentation) at the
+//! cost of a bigger struct TlsfArena.
+#ifndef TLSF_SL_LOG2 // Define at compile-command time if desired
+#define TLSF_SL_LOG2 5
+#endif // TLSF_SL_LOG2
+
+//! Largest block an arena can hold is just under 2^TLSF_MAX_BLOCK_SHIFT bytes.
+//! Regions bigger than that are only partially used.
+#ifndef TLSF_MAX_BLOCK_SHIFT // Define at compile-command time if desired
+#define TLSF_MAX_BLOCK_SHIFT 30
+#endif // TLSF_MAX_BLOCK_SHIFT
+
+#if (TLSF_SL_LOG2 < 1) || (TLSF_SL_LOG2 > 5)
+#error "TLSF_SL_LOG2 must be between 1 and 5"
+#endif
+
+#if (TLSF_MAX_BLOCK_SHIFT - (TLSF_SL_LOG2 + 4)) >= 31
+#error "TLSF_MAX_BLOCK_SHIFT is too large for the first-level bitmap"
+#endif
+
+#if (TLSF_MAX_BLOCK_SHIFT <= (TLSF_SL_LOG2 + 4))
+#error "TLSF_MAX_BLOCK_SHIFT must be larger than TLSF_SL_LOG2 + 4"
+#endif
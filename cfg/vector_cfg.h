@@ -22,3 +22,59 @@
 //! Specify the size of the `struct Vector` pool which is internally used to deploy vector objects
 #define VEC_STRUCT_POOL_SIZE  25
 
+
+//! Uncomment (or define at compile-command time) for compact vector handles:
+//! each vector then points to its allocator instead of carrying a copy of it
+//! (vectors given identical unmanaged allocators share one internal copy), and
+//! lengths/capacities are 32-bit if MAX_VEC_LEN fits. Shrinks struct Vector to
+//! well under a cache line, at the cost of an extra indirection on allocation.
+// #define VEC_COMPACT_HEADER
+
+//! Uncomment (or define at compile-command time) to have vectors created and
+//! freed from several threads at once. Guards the handle pool with a spinlock,
+//! which costs an uncontended atomic per VectorNew/VectorFree. Operations on a
+//! given vector still need to be kept to one thread at a time by the caller.
+// #define VEC_POOL_THREAD_SAFE
+
+//! Bytes of freed vector arrays to keep around for reuse (0 disables this).
+//! VectorFree then holds onto the array, and the next vector of the same
+//! element size and allocator that needs an array it fits in takes it over
+//! instead of allocating one. Only applies to unmanaged allocators without an
+//! arena (e.g., DEFAULT_ALLOCATOR). Adjustable at run time (see
+//! VectorRecycleSetBudget).
+#ifndef VEC_RECYCLE_BUDGET
+#define VEC_RECYCLE_BUDGET 0
+#endif
+
+//! Most freed arrays kept at once for reuse (see VEC_RECYCLE_BUDGET)
+#ifndef VEC_RECYCLE_SLOTS
+#define VEC_RECYCLE_SLOTS 8
+#endif
+
+//! Uncomment (or define at compile-command time) to count what vectors do:
+//! pushes, inserts, removes, expansions, bytes shifted around by inserts and
+//! removes, and bytes copied by duplication, concatenation, splitting and
+//! slicing, per vector and in total (see VectorStatsGet). Counting costs a
+//! couple of adds per operation, with no locking: totals are kept per thread.
+// #define CCOL_STATS
+
+//! Threads that get running totals of their own with CCOL_STATS. Any threads
+//! beyond that share one (updated atomically). A thread's totals are kept
+//! after it exits, so count every thread that ever operates on a vector.
+#ifndef VEC_STATS_THREAD_SLOTS
+#define VEC_STATS_THREAD_SLOTS 64
+#endif
+
+//! Uncomment (or define at compile-command time) to build in USDT probes
+//! (provider ccol) for bpftrace, perf or SystemTap: vec_expand, vec_expandby,
+//! vec_shift, pool_dispatch, pool_reclaim, pool_exhausted and vector_free (see
+//! inc/README.md for their arguments). Needs <sys/sdt.h> (e.g., the
+//! systemtap-sdt-dev package). Each probe is a single nop until a tracer
+//! attaches to it.
+// #define CCOL_USDT
+
+//! Uncomment (or define at compile-command time) to be able to record every
+//! call made on a vector to a compact binary trace (see VectorTraceStart), for
+//! replaying with benchmark/bench_replay.c. While no trace is being recorded,
+//! each call costs one extra check.
+// #define CCOL_TRACE
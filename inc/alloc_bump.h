@@ -0,0 +1,143 @@
+/**
+ * @file alloc_bump.h
+ * @brief Bump (arena) allocator over a user-provided buffer.
+ *
+ * Allocation is a pointer increment, and nothing is freed individually:
+ * reclaim is a no-op, and the whole arena is emptied at once with bump_reset.
+ * The most recently allocated block can still grow (or shrink) in place, which
+ * is the common case for a vector that's being pushed to while nothing else
+ * allocates from the same arena.
+ *
+ * This is meant for short-lived, request-scoped vectors: point them at an
+ * arena, use them, free the vectors, and reset the arena.
+ *
+ * The arena also serves as a scratch stack: bump_mark takes a savepoint, and
+ * bump_rewind gives back everything allocated since in one go. Savepoints nest,
+ * so a function can take its own within its caller's, as long as it rewinds
+ * before returning. Between a mark and its rewind, only vectors created after
+ * the mark may allocate from the arena: a vector from before that grows would
+ * be moved into memory that the rewind gives back.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+#ifndef ALLOC_BUMP_H
+#define ALLOC_BUMP_H
+
+/* File Inclusions */
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "ccol_shared.h"
+#include "alloc_bump_cfg.h"
+
+/* Public Macro Definitions */
+
+/**
+ * @brief Allocator over a struct BumpArena previously set up with bump_init.
+ * @note The arena must outlive every block allocated through it.
+ */
+#define BUMP_ALLOCATOR(arena_ptr)                           \
+(                                                           \
+ (struct Allocator){                                        \
+   .alloc = bump_alloc,                                     \
+   .realloc = bump_realloc,                                 \
+   .reclaim = bump_reclaim,                                 \
+   .alloca_init = NULL,                                     \
+   .arena = (arena_ptr),                                    \
+   .alloc_zeroed = NULL,                                    \
+   .try_expand_in_place = bump_try_expand_in_place,         \
+   .usable_size = bump_usable_size,                         \
+   .alloc_aligned = bump_alloc_aligned,                     \
+   .realloc_aligned = bump_realloc_aligned,                 \
+   .alloca_deinit = NULL,                                   \
+   .reset = bump_reset                                      \
+ }                                                          \
+)
+
+/* Public Datatypes */
+
+/**
+ * @brief State of a bump arena. Treat as opaque and set up with bump_init.
+ * @param start      Start of the buffer the arena hands out blocks from
+ * @param end        One past the end of that buffer
+ * @param bump_ptr   Next free byte
+ * @param last_block Start of the most recent block (NULL if none), which is
+ *                   the only one that can be resized in place
+ */
+struct BumpArena
+{
+   uint8_t * start;
+   uint8_t * end;
+   uint8_t * bump_ptr;
+   uint8_t * last_block;
+};
+
+/**
+ * @brief Savepoint in a bump arena (see bump_mark). Treat as opaque.
+ */
+struct BumpMark
+{
+   uint8_t * bump_ptr;
+   uint8_t * last_block;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Public Functions */
+
+/**
+ * @brief Sets up an arena over buf, which must outlive the arena.
+ * @param arena Arena to set up
+ * @param buf   Buffer to hand blocks out from
+ * @param sz    Size of buf (in bytes)
+ */
+void bump_init(struct BumpArena * arena, void * buf, size_t sz);
+
+/**
+ * @brief Empties the arena in one go, invalidating every block allocated from
+ *        it. Serves as the allocator's reset hook.
+ * @note Vectors using this arena must not be used afterwards (free them first,
+ *       or all at once with VectorFreeAllWith).
+ * @param arena Arena (struct BumpArena *) set up with bump_init
+ */
+void bump_reset(void * arena);
+
+/**
+ * @brief Takes a savepoint to bump_rewind to later.
+ * @note Blocks allocated before the savepoint can no longer grow in place
+ *       until the rewind, so that none of them grows into the scratch space.
+ */
+struct BumpMark bump_mark(struct BumpArena * arena);
+
+/**
+ * @brief Gives back every block allocated since the savepoint was taken (and
+ *        invalidates any savepoints taken since).
+ * @note Vectors using those blocks must not be used afterwards. Freeing them
+ *       is still needed to give their handles back, and may come before or
+ *       after the rewind.
+ */
+void bump_rewind(struct BumpArena * arena, struct BumpMark mark);
+
+/**
+ * @brief Number of bytes currently handed out from the arena (incl. padding).
+ */
+size_t bump_used(const struct BumpArena * arena);
+
+void * bump_alloc(size_t req_sz, void * arena);
+void * bump_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena);
+void   bump_reclaim(void * old_ptr, size_t old_sz, void * arena);
+bool   bump_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena);
+size_t bump_usable_size(void * ptr, size_t req_sz, void * arena);
+void * bump_alloc_aligned(size_t req_sz, size_t alignment, void * arena);
+void * bump_realloc_aligned(void * old_ptr, size_t new_sz, size_t old_sz, size_t alignment, void * arena);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // ALLOC_BUMP_H
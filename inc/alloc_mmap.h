@@ -0,0 +1,104 @@
+/**
+ * @file alloc_mmap.h
+ * @brief Allocator that backs large blocks with anonymous memory mappings.
+ *
+ * Blocks below a size threshold are handed off to the stdlib (malloc & co.),
+ * while blocks at or above the threshold are mapped directly from the OS. The
+ * point of the latter is growth: resizing a mapped block is done with mremap,
+ * which moves page table entries around rather than copying bytes, so doubling
+ * a multi-hundred-MB vector doesn't memcpy the whole thing.
+ *
+ * Mapped blocks can optionally be backed by huge pages, which cuts down on TLB
+ * misses when scanning through big buffers (see enum MmapHugePages).
+ *
+ * @note Only Linux provides mremap. On other platforms, every block is handed
+ *       off to the stdlib regardless of size.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+#ifndef ALLOC_MMAP_H
+#define ALLOC_MMAP_H
+
+/* File Inclusions */
+#include <stddef.h>
+#include <stdbool.h>
+#include "ccol_shared.h"
+#include "alloc_mmap_cfg.h"
+
+/* Public Macro Definitions */
+
+/**
+ * @brief Allocator over an optional struct MmapArena (NULL for the defaults in
+ *        cfg/alloc_mmap_cfg.h).
+ * @note The arena, if given, must outlive every block allocated through it,
+ *       and its threshold must not change while any block is live.
+ */
+#define MMAP_ALLOCATOR(arena_ptr)                           \
+(                                                           \
+ (struct Allocator){                                        \
+   .alloc = mmap_alloc,                                     \
+   .realloc = mmap_realloc,                                 \
+   .reclaim = mmap_reclaim,                                 \
+   .alloca_init = NULL,                                     \
+   .arena = (arena_ptr),                                    \
+   .alloc_zeroed = mmap_alloc_zeroed,                       \
+   .try_expand_in_place = mmap_try_expand_in_place,         \
+   .usable_size = mmap_usable_size,                         \
+   .alloc_aligned = mmap_alloc_aligned,                     \
+   .realloc_aligned = mmap_realloc_aligned,                 \
+   .alloca_deinit = NULL,                                   \
+   .reset = NULL                                            \
+ }                                                          \
+)
+
+/* Public Datatypes */
+
+/**
+ * @brief How mapped blocks of at least MMAP_HUGE_PAGE_SIZE bytes are backed.
+ *        Either way, such blocks are rounded up to a multiple of the huge page
+ *        size and start on a huge page boundary.
+ */
+enum MmapHugePages
+{
+   MmapHugePages_Off,         //!< Regular pages
+   MmapHugePages_Transparent, //!< madvise(MADV_HUGEPAGE): the kernel backs the
+                              //!< block with huge pages as it sees fit
+   MmapHugePages_Explicit     //!< MAP_HUGETLB from the reserved huge page pool
+                              //!< (vm.nr_hugepages), or Transparent if that fails
+};
+
+/**
+ * @brief Optional configuration for the mmap allocator.
+ * @param threshold  Blocks of at least this many bytes are mapped from the OS;
+ *                   smaller ones go to malloc. Must be non-zero.
+ * @param huge_pages Huge page policy for mapped blocks (see enum MmapHugePages)
+ */
+struct MmapArena
+{
+   size_t threshold;
+   enum MmapHugePages huge_pages;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Public Functions */
+
+void * mmap_alloc(size_t req_sz, void * arena);
+void * mmap_alloc_zeroed(size_t req_sz, void * arena);
+void * mmap_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena);
+void   mmap_reclaim(void * old_ptr, size_t old_sz, void * arena);
+bool   mmap_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena);
+size_t mmap_usable_size(void * ptr, size_t req_sz, void * arena);
+void * mmap_alloc_aligned(size_t req_sz, size_t alignment, void * arena);
+void * mmap_realloc_aligned(void * old_ptr, size_t new_sz, size_t old_sz, size_t alignment, void * arena);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // ALLOC_MMAP_H
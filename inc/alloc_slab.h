@@ -0,0 +1,102 @@
+/**
+ * @file alloc_slab.h
+ * @brief Size-class slab allocator that recycles freed vector buffers.
+ *
+ * Requests are rounded up to a power-of-two size class, and each class keeps a
+ * free list of blocks that were given back. A block is only carved out of a
+ * fresh chunk when its class's free list is empty, so vectors that keep getting
+ * created, grown and freed end up recycling each other's buffers without
+ * calling into malloc at all. Since vectors grow by doubling, rounding up to a
+ * power of two costs next to nothing: the slack is absorbed as capacity.
+ *
+ * Requests above the largest class are passed through to malloc.
+ *
+ * @note Not thread-safe: each arena must only be used from one thread at a time.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+#ifndef ALLOC_SLAB_H
+#define ALLOC_SLAB_H
+
+/* File Inclusions */
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "ccol_shared.h"
+#include "alloc_slab_cfg.h"
+
+/* Public Macro Definitions */
+
+#define SLAB_NUM_CLASSES ( SLAB_MAX_CLASS_SHIFT - SLAB_MIN_CLASS_SHIFT + 1 )
+
+/**
+ * @brief Allocator over a struct SlabArena previously set up with slab_init.
+ * @note The arena must outlive every block allocated through it.
+ */
+#define SLAB_ALLOCATOR(arena_ptr)                           \
+(                                                           \
+ (struct Allocator){                                        \
+   .alloc = slab_alloc,                                     \
+   .realloc = slab_realloc,                                 \
+   .reclaim = slab_reclaim,                                 \
+   .alloca_init = NULL,                                     \
+   .arena = (arena_ptr),                                    \
+   .alloc_zeroed = NULL,                                    \
+   .try_expand_in_place = slab_try_expand_in_place,         \
+   .usable_size = slab_usable_size,                         \
+   .alloc_aligned = NULL,                                   \
+   .realloc_aligned = NULL,                                 \
+   .alloca_deinit = NULL,                                   \
+   .reset = NULL                                            \
+ }                                                          \
+)
+
+/* Public Datatypes */
+
+struct SlabChunk;
+struct SlabFreeBlock;
+
+/**
+ * @brief State of a slab arena. Treat as opaque and set up with slab_init.
+ * @param free_lists Per size class, the most recently freed block (each free
+ *                   block holds a pointer to the next one)
+ * @param chunks     Every chunk obtained so far, for slab_destroy
+ * @param carve_ptr  Next unused byte of the current chunk
+ * @param carve_end  End of the current chunk
+ */
+struct SlabArena
+{
+   struct SlabFreeBlock * free_lists[SLAB_NUM_CLASSES];
+   struct SlabChunk * chunks;
+   uint8_t * carve_ptr;
+   uint8_t * carve_end;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Public Functions */
+
+void slab_init(struct SlabArena * arena);
+
+/**
+ * @brief Gives every chunk back to malloc, invalidating every block allocated
+ *        from the arena. The arena may be reused after another slab_init.
+ */
+void slab_destroy(struct SlabArena * arena);
+
+void * slab_alloc(size_t req_sz, void * arena);
+void * slab_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena);
+void   slab_reclaim(void * old_ptr, size_t old_sz, void * arena);
+bool   slab_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena);
+size_t slab_usable_size(void * ptr, size_t req_sz, void * arena);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // ALLOC_SLAB_H
@@ -0,0 +1,91 @@
+/**
+ * @file alloc_tlheap.h
+ * @brief Allocator that serves each thread from a heap of its own.
+ *
+ * Every thread that allocates through this allocator gets a private heap (a
+ * slab arena, see alloc_slab.h) the first time it does so, and from then on
+ * allocates and frees without taking any lock or touching memory that other
+ * threads allocate from. The arena member of the allocator is unused: each
+ * call resolves to the calling thread's heap.
+ *
+ * A block freed by a thread other than the one that allocated it is pushed onto
+ * a lock-free queue belonging to the owning heap, and the owner takes it back
+ * the next time it allocates. So vectors may be handed between threads freely.
+ *
+ * When a thread exits, its heap is abandoned rather than destroyed, since other
+ * threads may still hold blocks from it, and the next thread that needs a heap
+ * adopts it. All heaps are given back to the system with tlheap_destroy_all.
+ *
+ * Requires GCC-style __thread and __atomic support on a POSIX platform. Where
+ * those are missing, every call simply falls through to malloc and friends.
+ *
+ * @note Vectors themselves come from a shared pool: define VEC_POOL_THREAD_SAFE
+ *       (see vector_cfg.h) when creating/freeing vectors from several threads.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+#ifndef ALLOC_TLHEAP_H
+#define ALLOC_TLHEAP_H
+
+/* File Inclusions */
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "ccol_shared.h"
+#include "alloc_tlheap_cfg.h"
+
+/* Public Macro Definitions */
+
+#define TLHEAP_ALLOCATOR                                    \
+(                                                           \
+ (struct Allocator){                                        \
+   .alloc = tlheap_alloc,                                   \
+   .realloc = tlheap_realloc,                               \
+   .reclaim = tlheap_reclaim,                               \
+   .alloca_init = NULL,                                     \
+   .arena = NULL,                                           \
+   .alloc_zeroed = NULL,                                    \
+   .try_expand_in_place = tlheap_try_expand_in_place,       \
+   .usable_size = tlheap_usable_size,                       \
+   .alloc_aligned = NULL,                                   \
+   .realloc_aligned = NULL,                                 \
+   .alloca_deinit = NULL,                                   \
+   .reset = NULL                                            \
+ }                                                          \
+)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Public Functions */
+
+/**
+ * @brief Takes back the blocks other threads have freed to the calling thread's
+ *        heap and abandons it, for the next thread needing a heap to adopt.
+ * @note Only needed with TLHEAP_AUTO_DETACH set to 0, or to give up a heap
+ *       before the thread exits. Does nothing if the thread has no heap.
+ */
+void tlheap_thread_detach(void);
+
+/**
+ * @brief Gives every heap's memory back to the system.
+ * @note Only call once no thread is allocating through this allocator anymore,
+ *       and every block allocated through it has been freed.
+ */
+void tlheap_destroy_all(void);
+
+void * tlheap_alloc(size_t req_sz, void * arena);
+void * tlheap_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena);
+void   tlheap_reclaim(void * old_ptr, size_t old_sz, void * arena);
+bool   tlheap_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena);
+size_t tlheap_usable_size(void * ptr, size_t req_sz, void * arena);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // ALLOC_TLHEAP_H
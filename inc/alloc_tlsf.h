@@ -0,0 +1,154 @@
+/**
+ * @file alloc_tlsf.h
+ * @brief Two-Level Segregated Fit (TLSF) allocator over a user-provided region.
+ *
+ * Free blocks are kept in a two-level array of segregated free lists: the first
+ * level picks the power-of-two range a size falls in, and the second level
+ * splits that range linearly into 2^TLSF_SL_LOG2 lists. Two bitmaps record
+ * which lists are non-empty, so finding a fitting block is a couple of
+ * find-first-set instructions rather than a search. Freed blocks are merged
+ * with their physical neighbours right away.
+ *
+ * Every operation (alloc, reclaim, in-place growth/shrinkage) runs in constant
+ * time, independent of how many blocks are live or how fragmented the region
+ * is. The one exception is a realloc that can't be done in place, which also
+ * has to copy the block's contents. This makes the allocator suited to
+ * real-time paths where a bounded worst case matters more than the average.
+ *
+ * The price of never searching a list is that requests are rounded up to the
+ * smallest size of the next list (by at most 1/2^TLSF_SL_LOG2 of the request),
+ * so a request can fail even though a free block of exactly that size exists.
+ *
+ * @note Not thread-safe: each arena must only be used from one thread at a time.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+#ifndef ALLOC_TLSF_H
+#define ALLOC_TLSF_H
+
+/* File Inclusions */
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "ccol_shared.h"
+#include "alloc_tlsf_cfg.h"
+
+/* Public Macro Definitions */
+
+#define TLSF_ALIGNMENT  ( (size_t)16 )   // Every block handed out is aligned to this
+#define TLSF_SL_COUNT   ( 1u << TLSF_SL_LOG2 )
+#define TLSF_FL_COUNT   ( TLSF_MAX_BLOCK_SHIFT - (TLSF_SL_LOG2 + 4) + 1 )
+
+/**
+ * @brief An arena over sz bytes at buf_ptr, which must outlive the arena. The
+ *        region is only carved up when tlsf_init is called on the arena.
+ */
+#define TLSF_ARENA(buf_ptr, sz)                             \
+(                                                           \
+ (struct TlsfArena){                                        \
+   .region = (uint8_t *)(buf_ptr),                          \
+   .region_sz = (sz),                                       \
+   .initialized = false                                     \
+ }                                                          \
+)
+
+/**
+ * @brief Allocator over a struct TlsfArena created with TLSF_ARENA.
+ * @note The arena must outlive every block allocated through it.
+ */
+#define TLSF_ALLOCATOR(arena_ptr)                           \
+(                                                           \
+ (struct Allocator){                                        \
+   .alloc = tlsf_alloc,                                     \
+   .realloc = tlsf_realloc,                                 \
+   .reclaim = tlsf_reclaim,                                 \
+   .alloca_init = tlsf_init,                                \
+   .arena = (arena_ptr),                                    \
+   .alloc_zeroed = NULL,                                    \
+   .try_expand_in_place = tlsf_try_expand_in_place,         \
+   .usable_size = tlsf_usable_size,                         \
+   .alloc_aligned = NULL,                                   \
+   .realloc_aligned = NULL,                                 \
+   .alloca_deinit = tlsf_deinit,                            \
+   .reset = tlsf_reset                                      \
+ }                                                          \
+)
+
+/* Public Datatypes */
+
+struct TlsfBlock;
+
+/**
+ * @brief State of a TLSF arena. Treat as opaque and create with TLSF_ARENA.
+ * @param fl_bitmap   Bit i is set iff any list in sl_bitmap[i] is non-empty
+ * @param sl_bitmap   Per first-level range, bit j is set iff free_lists[i][j]
+ *                    is non-empty
+ * @param free_lists  Heads of the segregated free lists
+ * @param region      Start of the user-provided region
+ * @param region_sz   Size of the region (in bytes)
+ * @param initialized Whether tlsf_init has carved up the region yet
+ */
+struct TlsfArena
+{
+   uint32_t fl_bitmap;
+   uint32_t sl_bitmap[TLSF_FL_COUNT];
+   struct TlsfBlock * free_lists[TLSF_FL_COUNT][TLSF_SL_COUNT];
+   uint8_t * region;
+   size_t region_sz;
+   bool initialized;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Public Functions */
+
+/**
+ * @brief Carves the arena's region up into one big free block. Serves as the
+ *        allocator's alloca_init hook.
+ *
+ * Only the first call on an arena does anything (until tlsf_deinit): later
+ * calls return right away, so the arena also survives being shared by vectors
+ * whose allocator wasn't passed to AllocatorInit. If the region is too small to
+ * hold a block, the arena is left empty and every allocation from it fails.
+ *
+ * @param arena Arena (struct TlsfArena *) created with TLSF_ARENA
+ */
+void tlsf_init(void * arena);
+
+/**
+ * @brief Empties the arena, invalidating every block allocated from it, so that
+ *        the next tlsf_init carves the region up afresh. Serves as the
+ *        allocator's alloca_deinit hook.
+ */
+void tlsf_deinit(void * arena);
+
+/**
+ * @brief Empties the arena and carves the region up afresh in one go,
+ *        invalidating every block allocated from it. Serves as the allocator's
+ *        reset hook.
+ */
+void tlsf_reset(void * arena);
+
+/**
+ * @brief Number of payload bytes in the arena's free blocks.
+ * @note O(number of free blocks) - meant for diagnostics and tests, not for
+ *       the real-time path.
+ */
+size_t tlsf_free_bytes(const struct TlsfArena * arena);
+
+void * tlsf_alloc(size_t req_sz, void * arena);
+void * tlsf_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena);
+void   tlsf_reclaim(void * old_ptr, size_t old_sz, void * arena);
+bool   tlsf_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena);
+size_t tlsf_usable_size(void * ptr, size_t req_sz, void * arena);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // ALLOC_TLSF_H
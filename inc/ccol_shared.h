@@ -12,6 +12,8 @@
 
 /* File Inclusions */
 #include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 
 /* Public Macro Definitions */
 #define DEFAULT_ALLOCATOR              \
@@ -21,7 +23,14 @@
    .realloc = default_realloc,         \
    .reclaim = default_reclaim,         \
    .alloca_init = NULL,                \
-   .arena = NULL                       \
+   .arena = NULL,                      \
+   .alloc_zeroed = default_alloc_zeroed, \
+   .try_expand_in_place = default_try_expand_in_place, \
+   .usable_size = default_usable_size, \
+   .alloc_aligned = default_alloc_aligned, \
+   .realloc_aligned = default_realloc_aligned, \
+   .alloca_deinit = NULL,              \
+   .reset = NULL                       \
  }                                     \
 )
 
@@ -65,8 +74,44 @@
  * @param alloca_init A init fcn for the allocator - e.g., may be used to
  *                    initialize subdivisions of the arena argument and compute
  *                    free lists, from which allocations, splitting, coalescence,
- *                    etc., may be done.
+ *                    etc., may be done. Run once by AllocatorInit. (For an
+ *                    allocator that was never passed to AllocatorInit, each
+ *                    VectorNew runs it instead, so it must then tolerate
+ *                    being called again on an arena that's in use.)
  * @param arena   The pool of memory from which allocations are made from.
+ * @param alloc_zeroed (Optional) Fcn that allocates memory that is guaranteed
+ *                     to read as all zeros. Allocators that can obtain zeroed
+ *                     memory cheaply (e.g., calloc, fresh mmap pages) should
+ *                     provide this so that zero-initialized vectors don't
+ *                     have to touch every page up front. If NULL, alloc is
+ *                     used and the memory is zeroed manually.
+ * @param try_expand_in_place (Optional) Fcn that attempts to grow a previously
+ *                            allocated block to new_sz bytes _without_ moving
+ *                            it, returning true on success. On failure, the
+ *                            block must be left untouched, and realloc will
+ *                            be used instead.
+ * @param usable_size (Optional) Fcn that reports how many bytes of the block
+ *                    pointed to by ptr are actually usable, which may be more
+ *                    than the req_sz it was allocated with. A vector will
+ *                    absorb that slack as extra capacity before reallocating.
+ *                    Allocators that provide this must accept any size
+ *                    between the requested and usable size as the old_sz
+ *                    argument to realloc and reclaim.
+ * @param alloc_aligned (Optional) Like alloc, but the returned block starts at
+ *                      a multiple of alignment (a power of two). Blocks from
+ *                      here are given back through reclaim like any other.
+ *                      Required for vectors created with an alignment.
+ * @param realloc_aligned (Optional) Like realloc, but the resized block keeps
+ *                        starting at a multiple of alignment. Required for
+ *                        vectors created with an alignment.
+ * @param alloca_deinit (Optional) Counterpart to alloca_init, run by
+ *                      AllocatorRelease once the last reference is dropped.
+ * @param reset (Optional) Fcn that empties the arena in one go, invalidating
+ *              every block allocated from it, and leaves it ready for new
+ *              allocations. Lets VectorFreeAllWith skip reclaiming each block.
+ * @param refs Number of references held to a managed allocator (0 if the
+ *             allocator isn't managed). Owned by AllocatorInit/Retain/Release;
+ *             leave it zero-initialized.
  */
 struct Allocator
 {
@@ -75,14 +120,118 @@ struct Allocator
    void   (*reclaim)(void * old_ptr, size_t old_sz, void * arena);
    void   (*alloca_init)(void * arena);
    void * arena;
+
+   // Optional hooks (may be left NULL)
+   void * (*alloc_zeroed)(size_t req_sz, void * arena);
+   bool   (*try_expand_in_place)(void * ptr, size_t new_sz, size_t old_sz, void * arena);
+   size_t (*usable_size)(void * ptr, size_t req_sz, void * arena);
+   void * (*alloc_aligned)(size_t req_sz, size_t alignment, void * arena);
+   void * (*realloc_aligned)(void * old_ptr, size_t new_sz, size_t old_sz, size_t alignment, void * arena);
+   void   (*alloca_deinit)(void * arena);
+   void   (*reset)(void * arena);
+
+   // Lifecycle state
+   size_t refs;
 };
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /* Public Functions */
 
+// An allocator passed to AllocatorInit becomes "managed": its arena is set up
+// exactly once, and every vector created with it holds a reference to it (the
+// struct itself, not a copy), so it must stay put until the last reference is
+// dropped. The caller of AllocatorInit owns the first reference. Allocators
+// that are never passed to AllocatorInit are simply copied into each vector.
+
+/**
+ * @brief Runs the allocator's alloca_init (if any) and makes it managed, with
+ *        one reference held by the caller.
+ * @return true on success, false if the allocator is incomplete (missing alloc,
+ *         realloc or reclaim) or was already initialized.
+ */
+bool AllocatorInit(struct Allocator * self);
+
+/**
+ * @brief Takes another reference to a managed allocator.
+ * @return true on success, false if the allocator isn't managed.
+ */
+bool AllocatorRetain(struct Allocator * self);
+
+/**
+ * @brief Drops a reference to a managed allocator, running its alloca_deinit
+ *        (if any) when the last one goes. Does nothing for unmanaged ones.
+ */
+void AllocatorRelease(struct Allocator * self);
+
+/**
+ * @brief Whether the allocator has been through AllocatorInit and still has
+ *        references held to it.
+ */
+bool AllocatorIsManaged(const struct Allocator * self);
+
 // These will simply be wrappers around the common stdlib fcns, ignoring the
 // unused parameters as needed.
 void * default_alloc(size_t req_sz, void *);
+void * default_alloc_zeroed(size_t req_sz, void *);
 void * default_realloc(void * old_ptr, size_t new_sz, size_t, void *);
 void   default_reclaim(void * old_ptr, size_t, void *);
+bool   default_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void *);
+size_t default_usable_size(void * ptr, size_t req_sz, void *);
+void * default_alloc_aligned(size_t req_sz, size_t alignment, void *);
+void * default_realloc_aligned(void * old_ptr, size_t new_sz, size_t old_sz, size_t alignment, void *);
+
+// Thin wrappers around the OS's virtual memory facilities, for the parts of
+// the library that manage pages directly rather than through an allocator.
+// On platforms without such facilities, reservations simply fail (NULL).
+
+/**
+ * @brief Size of a virtual memory page (in bytes).
+ */
+size_t ccol_page_size(void);
+
+/**
+ * @brief Rounds sz up to a whole number of pages.
+ */
+size_t ccol_page_round(size_t sz);
+
+/**
+ * @brief Reserves sz bytes of address space without backing it with memory.
+ * @note Accessing reserved memory before committing it faults.
+ * @return Page-aligned start of the reservation, or NULL on failure.
+ */
+void * ccol_vm_reserve(size_t sz);
+
+/**
+ * @brief Backs sz bytes starting at ptr (both page-aligned, and within a
+ *        reservation) with readable/writable memory that reads as zeros.
+ * @return true on success, false otherwise.
+ */
+bool ccol_vm_commit(void * ptr, size_t sz);
+
+/**
+ * @brief Releases a reservation of sz bytes starting at ptr, committed or not.
+ */
+void ccol_vm_release(void * ptr, size_t sz);
+
+/**
+ * @brief Locks the pages spanned by sz bytes starting at ptr into RAM, so that
+ *        they are never paged out (nor faulted in on first touch).
+ * @note Locks aren't counted: unlocking a page unlocks it for every block that
+ *       shares it.
+ * @return true on success, false otherwise (e.g., over RLIMIT_MEMLOCK).
+ */
+bool ccol_vm_lock(void * ptr, size_t sz);
+
+/**
+ * @brief Undoes ccol_vm_lock over the same range.
+ */
+void ccol_vm_unlock(void * ptr, size_t sz);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
 
 #endif // CCOL_SHARED_H
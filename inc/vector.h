@@ -18,11 +18,172 @@
 
 /* Public Macro Definitions */
 
+//! First bytes of a trace file written by VectorTraceStart
+#define VECTOR_TRACE_MAGIC         "CCOLTR01"
+#define VECTOR_TRACE_MAGIC_LEN     (8u)
+
+//! Most bytes one encoded trace record takes (see VectorTraceDecode)
+#define VECTOR_TRACE_RECORD_MAX    (1u + (5u * 10u))
+
+//! Bits of the flags argument of a VectorTraceOp_NewAttr record
+#define VECTOR_TRACE_ATTR_STABLE_ADDRESSES   (1u << 0)
+#define VECTOR_TRACE_ATTR_REALTIME           (1u << 1)
+#define VECTOR_TRACE_ATTR_LOCK_MEMORY        (1u << 2)
+
 /* Public Datatypes */
 
 // Opaque type declaration to act as a handle for the user to pass into the API
 struct Vector;
 
+/**
+ * @brief Optional construction-time attributes of a vector (see VectorNewWithAttr)
+ * @note Zero-initialize and set only the fields of interest. An all-zero struct
+ *       gives the same vector as VectorNew would.
+ *
+ * @param stable_addresses Reserve address space for max_capacity elements up
+ *                         front and commit pages within it as the vector grows,
+ *                         so that the array never moves and growth never copies.
+ *                         Element pointers then stay valid until the vector is
+ *                         hard-reset, moved from, or freed. Capacity is tracked
+ *                         in whole pages, and the allocator isn't used for the
+ *                         array. Vectors derived from this one (duplicates
+ *                         excepted) are regular vectors.
+ * @param alignment Alignment (in bytes, a power of two) of the start of the
+ *                  vector's array, kept across growth and inherited by vectors
+ *                  derived from this one. When element_size is a multiple
+ *                  of the alignment (e.g., 64-byte records in a 64-byte aligned
+ *                  vector), every element is aligned too. Requires an allocator
+ *                  with the alloc_aligned/realloc_aligned hooks. 0 for whatever
+ *                  the allocator gives by default.
+ * @param realtime  Allocate all max_capacity elements up front and prefault
+ *                  every page, so that no later operation on the vector calls
+ *                  the allocator or takes a page fault: pushes/inserts that
+ *                  don't fit fail right away and are counted (see
+ *                  VectorRealtimeViolations), and VectorHardReset keeps the
+ *                  array. Duplicates are realtime too; other derived vectors
+ *                  are regular vectors.
+ * @param lock_memory With realtime, also lock the array into RAM (mlock), so
+ *                    that it can't be paged out. Construction fails if the
+ *                    system won't allow it (see RLIMIT_MEMLOCK).
+ */
+struct VectorAttr
+{
+   bool stable_addresses;
+   size_t alignment;
+   bool realtime;
+   bool lock_memory;
+};
+
+/**
+ * @brief Operation counts of a vector, or totals across all vectors (see
+ *        VectorStatsGet). Only gathered in a CCOL_STATS build.
+ * @param pushes         Successful push calls (single or range)
+ * @param inserts        Successful insert calls (single or range)
+ * @param removes        Successful remove calls (single or range)
+ * @param expansions     Times the array was grown
+ * @param shift_bytes    Bytes moved to open or close gaps for inserts/removes
+ * @param copy_bytes     Bytes copied out by duplicating, concatenating,
+ *                       splitting and slicing (counted against the source)
+ * @param pool_exhausted Vectors that couldn't be created for lack of a handle
+ *                       (totals only: always 0 for a single vector)
+ */
+struct VectorStats
+{
+   uint64_t pushes;
+   uint64_t inserts;
+   uint64_t removes;
+   uint64_t expansions;
+   uint64_t shift_bytes;
+   uint64_t copy_bytes;
+   uint64_t pool_exhausted;
+};
+
+/**
+ * @brief Occupancy of the vector handle pool, and the memory held by the
+ *        vectors handed out of it (see VectorPoolInfoGet).
+ * @param pool_size      Handles in the pool (VEC_STRUCT_POOL_SIZE)
+ * @param pool_bytes     Static memory the pool takes, handles in use or not
+ * @param in_use         Handles currently handed out
+ * @param high_water     Most handles handed out at once (since startup, or the
+ *                       last VectorPoolHighWaterReset)
+ * @param capacity_bytes Bytes of array capacity held by live vectors
+ * @param length_bytes   Of those, the bytes holding elements
+ * @param slack_bytes    Of those, the bytes not holding elements
+ */
+struct VectorPoolInfo
+{
+   size_t pool_size;
+   size_t pool_bytes;
+   size_t in_use;
+   size_t high_water;
+   size_t capacity_bytes;
+   size_t length_bytes;
+   size_t slack_bytes;
+};
+
+/**
+ * @brief Kinds of call in a trace (see VectorTraceStart). The values are part
+ *        of the file format, so they never change.
+ *
+ * Each record has the handle of the vector called on, and up to four
+ * arguments, listed here (any others are 0). A handle is the vector's slot in
+ * the handle pool + 1, so it's reused once its vector is freed. 0 means none,
+ * and only shows up as an argument (e.g., for a duplicate that failed to be
+ * created): calls on no vector at all aren't recorded.
+ *
+ * A vector created by VectorNewWithAttr with any attribute set has a NewAttr
+ * record right after its New one, with the same handle, so that a replay can
+ * rebuild its struct VectorAttr.
+ */
+enum VectorTraceOp
+{
+   VectorTraceOp_New             = 1,  // New handle; element size, capacity, max capacity, length
+   VectorTraceOp_Free            = 2,
+   VectorTraceOp_Duplicate       = 3,  // New handle
+   VectorTraceOp_Move            = 4,  // Source handle (the destination is the record's handle)
+   VectorTraceOp_AreEqual        = 5,  // Other handle
+   VectorTraceOp_Push            = 6,
+   VectorTraceOp_Insert          = 7,  // Index
+   VectorTraceOp_Get             = 8,  // Index
+   VectorTraceOp_LastElement     = 9,
+   VectorTraceOp_CpyElementAt    = 10, // Index
+   VectorTraceOp_CpyLastElement  = 11,
+   VectorTraceOp_Set             = 12, // Index
+   VectorTraceOp_Remove          = 13, // Index, whether the element was copied out
+   VectorTraceOp_ClearElementAt  = 14, // Index
+   VectorTraceOp_Reset           = 15,
+   VectorTraceOp_HardReset       = 16,
+   VectorTraceOp_SplitAt         = 17, // Index, new handle
+   VectorTraceOp_Slice           = 18, // Start, end, new handle
+   VectorTraceOp_Concatenate     = 19, // Other handle, new handle
+   VectorTraceOp_RangePush       = 20, // Number of elements
+   VectorTraceOp_RangeInsert     = 21, // Index, number of elements
+   VectorTraceOp_RangeCpy        = 22, // Start, end
+   VectorTraceOp_RangeSetWithArr = 23, // Start, end
+   VectorTraceOp_RangeSetToVal   = 24, // Start, end
+   VectorTraceOp_RangeRemove     = 25, // Start, end, whether the elements were copied out
+   VectorTraceOp_RangeClear      = 26, // Start, end
+   VectorTraceOp_NewAttr         = 27, // VECTOR_TRACE_ATTR_* flags, alignment (see below)
+   VectorTraceOp_Count
+};
+
+/**
+ * @brief One decoded trace record (see VectorTraceDecode).
+ * @param op     What was called
+ * @param handle Vector it was called on (or created, for VectorTraceOp_New)
+ * @param args   Arguments, as listed for op in enum VectorTraceOp
+ */
+struct VectorTraceRecord
+{
+   enum VectorTraceOp op;
+   uint64_t handle;
+   uint64_t args[4];
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /* Public API */
 
 /*************************** Constructor/Destructor ***************************/
@@ -34,6 +195,8 @@ struct Vector;
  * @param max_capacity     Maximum number of elements the vector can hold ever
  * @param initial_len      Number of initial (zero) elements
  * @param mem_mgr          Allocator that the user provides; if NULL, defaults to stdlib
+ * @note If mem_mgr went through AllocatorInit, the vector holds a reference to
+ *       it until VectorFree. Otherwise, it's copied and its alloca_init is run.
  * @return A pointer to the initialized vector, or NULL if allocation fails.
  */
 struct Vector * VectorNew( size_t element_size,
@@ -42,16 +205,45 @@ struct Vector * VectorNew( size_t element_size,
                            size_t initial_len,
                            const struct Allocator * mem_mgr );
 
+/**
+ * @brief Constructor with additional attributes
+ * @note Same parameters and defaults as VectorNew, plus:
+ * @param attr Attributes of the vector (if NULL, same as VectorNew)
+ * @return A pointer to the initialized vector, or NULL if allocation fails or
+ *         the attributes aren't supported on this platform.
+ */
+struct Vector * VectorNewWithAttr( size_t element_size,
+                                   size_t initial_capacity,
+                                   size_t max_capacity,
+                                   size_t initial_len,
+                                   const struct Allocator * mem_mgr,
+                                   const struct VectorAttr * attr );
+
 /**
  * @brief Destructor
+ * @note Drops the vector's reference to its allocator, if it holds one.
  * @param self Vector handle (if NULL, nothing happens)
  */
 void VectorFree( struct Vector * self );
 
+/**
+ * @brief Frees every vector using the given allocator in one pass, e.g., at the
+ *        end of a request whose vectors all came from one arena.
+ * @note If the allocator has a reset hook, the arena is reset once instead of
+ *       each array being reclaimed, so this costs the same however many arrays
+ *       there were. Without one, each array is reclaimed as VectorFree would.
+ * @note Vectors match if they hold a reference to mem_mgr (when it's managed),
+ *       or were created with an identical unmanaged allocator.
+ * @param mem_mgr The allocator (if NULL, nothing happens)
+ * @return Number of vectors freed
+ */
+size_t VectorFreeAllWith( const struct Allocator * mem_mgr );
+
 /******************** Vector-Vector Operations (Copy/Move) ********************/
 
 /**
  * @brief Copy constructor (deep).
+ * @note The duplicate keeps the attributes of the original (see VectorAttr).
  * @param self Vector handle (if NULL, nothing happens)
  */
 struct Vector * VectorDuplicate( const struct Vector * self );
@@ -59,7 +251,10 @@ struct Vector * VectorDuplicate( const struct Vector * self );
 /**
  * @brief Move constructor.
  * @note No memory is allocated for the destination vector.
- * @note dest needs to have the same element size and allocator as src
+ * @note dest needs to have the same element size, allocator, and attributes
+ *       (see VectorAttr) as src
+ * @note A realtime src is left empty with dest's former array (and max
+ *       capacity) rather than none, so that it stays usable without allocating.
  * @param self Vector handle (if NULL, nothing happens)
  */
 bool VectorMove( struct Vector * dest, struct Vector * src );
@@ -86,6 +281,15 @@ bool VectorsAreEqual( const struct Vector * a, const struct Vector * b );
 struct Vector * VectorConcatenate( const struct Vector * v1,
                                    const struct Vector * v2 );
 
+/**
+ * @brief Same as VectorConcatenate, but the result is allocated with mem_mgr
+ *        (e.g., a scratch arena for a short-lived result).
+ * @param mem_mgr Allocator for the result (if NULL, v1's)
+ */
+struct Vector * VectorConcatenateWith( const struct Vector * v1,
+                                       const struct Vector * v2,
+                                       const struct Allocator * mem_mgr );
+
 /******************************** Basic Stats *********************************/
 
 /**
@@ -126,6 +330,14 @@ bool VectorIsEmpty( const struct Vector * self );
  */
 bool VectorIsFull( const struct Vector * self );
 
+/**
+ * @brief Number of operations on a realtime vector (see VectorAttr) that were
+ *        refused because they needed more room than was allocated up front.
+ * @param self Vector handle (if NULL, nothing happens)
+ * @return The count, or 0 for a regular vector.
+ */
+size_t VectorRealtimeViolations( const struct Vector * self );
+
 /******************************** Vector Ops **********************************/
 
 /**
@@ -150,7 +362,8 @@ bool VectorInsert( struct Vector * self, size_t idx, const void * element );
 
 /**
  * @brief Retrieves a pointer to the element at the specified index in the vector.
- * @note Future vector operations may render this pointer stale
+ * @note Future vector operations may render this pointer stale, unless the
+ *       vector was created with stable addresses (see VectorAttr)
  * @param self Vector handle (if NULL, nothing happens)
  * @param idx The index of the element to retrieve, 0-indexed.
  * @return A pointer to the element if the retrieval was successful; NULL otherwise
@@ -233,6 +446,8 @@ bool VectorReset( struct Vector * self );
 
 /**
  * @brief Zeros elements first, then frees, then resets the vector length and capacity to zero.
+ * @note Realtime vectors (see VectorAttr) keep their array: only the zeroing
+ *       and the length reset apply.
  * @param self Vector handle (if NULL, nothing happens)
  */
 bool VectorHardReset( struct Vector * self );
@@ -251,6 +466,13 @@ bool VectorHardReset( struct Vector * self );
  */
 struct Vector * VectorSplitAt( struct Vector * self, size_t idx );
 
+/**
+ * @brief Same as VectorSplitAt, but the second half is allocated with mem_mgr.
+ * @param mem_mgr Allocator for the new vector (if NULL, self's)
+ */
+struct Vector * VectorSplitAtWith( struct Vector * self, size_t idx,
+                                   const struct Allocator * mem_mgr );
+
 /**
  * @brief Creates a slice (subvector) from the given vector.
  * @param self Pointer to the original Vector structure.
@@ -260,6 +482,14 @@ struct Vector * VectorSplitAt( struct Vector * self, size_t idx );
  */
 struct Vector * VectorSlice( const struct Vector * self, size_t idx_start, size_t idx_end );
 
+/**
+ * @brief Same as VectorSlice, but the slice is allocated with mem_mgr (e.g., a
+ *        scratch arena, for a slice that dies before the function returns).
+ * @param mem_mgr Allocator for the slice (if NULL, self's)
+ */
+struct Vector * VectorSliceWith( const struct Vector * self, size_t idx_start, size_t idx_end,
+                                 const struct Allocator * mem_mgr );
+
 /**
  * @brief Pushes several elements into the vector.
  * @param self Vector handle (if NULL, nothing happens)
@@ -360,3 +590,144 @@ bool VectorRangeRemove( struct Vector * self, size_t idx_start, size_t idx_end,
  * @return true if the operation was successful, false otherwise
  */
 bool VectorRangeClear( struct Vector * self, size_t idx_start, size_t idx_end );
+
+/***************************** Buffer Recycling *******************************/
+
+/**
+ * @brief Sets how many bytes of freed vector arrays are kept around for reuse
+ *        (VEC_RECYCLE_BUDGET to begin with; 0 turns recycling off).
+ * @note A freed array is reused by the next vector that has the same element
+ *       size, alignment and allocator and whose capacity it fits, when that
+ *       vector is constructed, duplicated, or first grown. The smallest array
+ *       that fits is picked, and the vector gets its whole capacity. The
+ *       oldest arrays are given back to their allocator to make room.
+ * @note Only arrays from unmanaged allocators without an arena (e.g.,
+ *       DEFAULT_ALLOCATOR, TLHEAP_ALLOCATOR) are kept, since an arena or a
+ *       managed allocator may go away at any time after the vector is freed.
+ * @param budget_bytes Arrays already kept beyond the new budget are given back
+ */
+void VectorRecycleSetBudget( size_t budget_bytes );
+
+/**
+ * @brief Gives every array kept for reuse back to its allocator.
+ */
+void VectorRecycleFlush( void );
+
+/**
+ * @brief Bytes of freed vector arrays currently kept for reuse.
+ */
+size_t VectorRecycledBytes( void );
+
+/**************************** Operation Counters ******************************/
+
+/**
+ * @brief Copies the operation counts of a vector, or the totals across every
+ *        vector ever created (and every thread) if self is NULL.
+ * @note The point is to find the vectors that do a lot of O(n) shifting or
+ *       copying, without attaching a profiler: see VectorStatsExport.
+ * @return true on success; false if self isn't a vector, or the library was
+ *         built without CCOL_STATS (in which case stats is zeroed).
+ */
+bool VectorStatsGet( const struct Vector * self, struct VectorStats * stats );
+
+/**
+ * @brief Zeroes the operation counts of a vector, or the totals and the counts
+ *        of every live vector if self is NULL.
+ * @note Counts that other threads add while the totals are being zeroed may
+ *       survive it.
+ */
+void VectorStatsReset( struct Vector * self );
+
+/**
+ * @brief Writes the totals, then the counts of every live vector, as text: one
+ *        line each, of space-separated name=value pairs (see VectorStats).
+ * @param buf    Where the text goes (NUL-terminated, truncated to fit)
+ * @param buf_sz Size of buf, which may be 0 (buf may then be NULL)
+ * @return Length of the whole text (excl. the NUL), like snprintf, so that a
+ *         return value of buf_sz or more means the text was truncated.
+ */
+size_t VectorStatsExport( char * buf, size_t buf_sz );
+
+/**************************** Pool Introspection ******************************/
+
+/**
+ * @brief Fills info with how full the handle pool is, and how much memory the
+ *        live vectors hold: for sizing VEC_STRUCT_POOL_SIZE, and for spotting
+ *        memory held but unused.
+ * @note Capacity counts what a vector may hold without growing: for a vector
+ *       with stable addresses, what has been committed of its reservation.
+ *       Arrays kept for reuse aren't counted (see VectorRecycledBytes).
+ * @note Vectors being changed by other threads meanwhile may be counted as
+ *       they were before or after the change.
+ * @return true on success; false if info is NULL.
+ */
+bool VectorPoolInfoGet( struct VectorPoolInfo * info );
+
+/**
+ * @brief Restarts the high-water mark from the number of handles in use now.
+ */
+void VectorPoolHighWaterReset( void );
+
+/**
+ * @brief Lists the (up to) n live vectors holding the most bytes of capacity,
+ *        most first. Vectors holding none aren't listed.
+ * @param largest Where the handles go (room for n of them)
+ * @return Number of handles listed
+ */
+size_t VectorPoolLargest( struct Vector ** largest, size_t n );
+
+/**
+ * @brief Lists the (up to) n live vectors holding the most bytes of slack
+ *        (capacity not holding elements), most first. Vectors with no slack
+ *        aren't listed.
+ * @param slackest Where the handles go (room for n of them)
+ * @return Number of handles listed
+ */
+size_t VectorPoolMostSlack( struct Vector ** slackest, size_t n );
+
+/***************************** Operation Tracing ******************************/
+
+/**
+ * @brief Starts recording every call made on a vector to a binary trace file,
+ *        for replaying later (see benchmark/bench_replay.c). The library must
+ *        be built with CCOL_TRACE.
+ * @note Calls that only ask about a vector's metadata (e.g., VectorLength)
+ *       aren't recorded. Calls that only pass on to another call are recorded
+ *       as that call (e.g., VectorClear as VectorTraceOp_RangeClear).
+ *       Element contents and allocators aren't recorded either.
+ * @note Calls on vectors created before tracing started are recorded too,
+ *       under their handles, but those handles have no VectorTraceOp_New
+ *       record, so a replay has nothing to make the calls on.
+ * @param path File to write the trace to (truncated if it exists)
+ * @return true if tracing started; false if the file couldn't be opened, a
+ *         trace is already being recorded, or the library was built without
+ *         CCOL_TRACE.
+ */
+bool VectorTraceStart( const char * path );
+
+/**
+ * @brief Stops recording and closes the trace file.
+ * @return true if the whole trace was written; false if a write failed (or
+ *         nothing was being recorded).
+ */
+bool VectorTraceStop( void );
+
+/**
+ * @brief Decodes the trace record at the start of buf.
+ *
+ * A trace file is VECTOR_TRACE_MAGIC followed by records. A record is one byte
+ * holding the op (low 5 bits) and how many fields follow (high 3 bits), then
+ * that many LEB128-encoded fields: the handle, then the arguments in order.
+ * Trailing fields that are 0 are left out.
+ *
+ * @param buf    Encoded records (what follows the magic, to begin with)
+ * @param buf_sz Bytes available in buf
+ * @param rec    Where the record goes
+ * @return Bytes the record took up, or 0 if buf doesn't start with a whole,
+ *         valid record.
+ */
+size_t VectorTraceDecode( const void * buf, size_t buf_sz, struct VectorTraceRecord * rec );
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
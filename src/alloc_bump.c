@@ -0,0 +1,212 @@
+/**
+ * @file alloc_bump.c
+ * @brief Implementation of the bump (arena) allocator.
+ *
+ * Every block is sized up to a multiple of BUMP_DEFAULT_ALIGNMENT, so that the
+ * bump pointer itself stays aligned for the common case, and so that the slack
+ * reported by bump_usable_size is really there.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ccol_shared.h"
+#include "alloc_bump.h"
+
+/* Private Function Prototypes */
+
+static bool fits_at(const struct BumpArena * arena, const uint8_t * at,
+                    size_t req_sz, size_t * rounded_sz);
+
+/* Public Function Definitions */
+
+void bump_init(struct BumpArena * arena, void * buf, size_t sz)
+{
+   assert(arena != NULL);
+   assert( (buf != NULL) || (0 == sz) );
+
+   arena->start = buf;
+   arena->end = arena->start + sz;
+   arena->bump_ptr = arena->start;
+   arena->last_block = NULL;
+}
+
+void bump_reset(void * arena)
+{
+   assert(arena != NULL);
+
+   struct BumpArena * self = arena;
+   self->bump_ptr = self->start;
+   self->last_block = NULL;
+}
+
+struct BumpMark bump_mark(struct BumpArena * arena)
+{
+   assert(arena != NULL);
+
+   struct BumpMark mark = { .bump_ptr = arena->bump_ptr, .last_block = arena->last_block };
+   arena->last_block = NULL;
+   return mark;
+}
+
+void bump_rewind(struct BumpArena * arena, struct BumpMark mark)
+{
+   assert(arena != NULL);
+   // Rewinding to a savepoint that an outer rewind already gave back would
+   // hand its space out twice
+   assert( (mark.bump_ptr >= arena->start) && (mark.bump_ptr <= arena->bump_ptr) );
+
+   arena->bump_ptr = mark.bump_ptr;
+   arena->last_block = mark.last_block;
+}
+
+size_t bump_used(const struct BumpArena * arena)
+{
+   assert(arena != NULL);
+
+   return (size_t)(arena->bump_ptr - arena->start);
+}
+
+void * bump_alloc(size_t req_sz, void * arena)
+{
+   return bump_alloc_aligned(req_sz, BUMP_DEFAULT_ALIGNMENT, arena);
+}
+
+void * bump_alloc_aligned(size_t req_sz, size_t alignment, void * arena)
+{
+   assert(arena != NULL);
+   assert( (alignment & (alignment - 1)) == 0 );
+
+   struct BumpArena * self = arena;
+   if ( alignment < BUMP_DEFAULT_ALIGNMENT )
+   {
+      alignment = BUMP_DEFAULT_ALIGNMENT;
+   }
+
+   size_t avail = (size_t)(self->end - self->bump_ptr);
+   size_t pad = (alignment - ((uintptr_t)self->bump_ptr & (alignment - 1))) & (alignment - 1);
+   size_t rounded_sz;
+   if ( (pad > avail) || !fits_at(self, self->bump_ptr + pad, req_sz, &rounded_sz) )
+   {
+      return NULL;
+   }
+
+   uint8_t * block = self->bump_ptr + pad;
+   self->bump_ptr = block + rounded_sz;
+   self->last_block = block;
+
+   return block;
+}
+
+void * bump_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   return bump_realloc_aligned(old_ptr, new_sz, old_sz, BUMP_DEFAULT_ALIGNMENT, arena);
+}
+
+void * bump_realloc_aligned(void * old_ptr, size_t new_sz, size_t old_sz, size_t alignment, void * arena)
+{
+   assert(arena != NULL);
+
+   struct BumpArena * self = arena;
+   if ( NULL == old_ptr )
+   {
+      return bump_alloc_aligned(new_sz, alignment, arena);
+   }
+
+   // The last block can move the bump pointer either way, which covers both
+   // growing and shrinking. Its start is already aligned as requested.
+   size_t rounded_sz;
+   if ( (old_ptr == self->last_block) && fits_at(self, old_ptr, new_sz, &rounded_sz) )
+   {
+      self->bump_ptr = self->last_block + rounded_sz;
+      return old_ptr;
+   }
+
+   if ( new_sz <= bump_usable_size(old_ptr, old_sz, arena) )
+   {
+      return old_ptr;
+   }
+
+   void * new_ptr = bump_alloc_aligned(new_sz, alignment, arena);
+   if ( new_ptr != NULL )
+   {
+      // Nothing to give back: the old block stays put until the next reset
+      memcpy( new_ptr, old_ptr, (old_sz < new_sz) ? old_sz : new_sz );
+   }
+   return new_ptr;
+}
+
+void bump_reclaim(void * old_ptr, size_t old_sz, void * arena)
+{
+   // Blocks are only ever given back all at once (see bump_reset)
+   (void)old_ptr;
+   (void)old_sz;
+   (void)arena;
+}
+
+bool bump_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   assert(arena != NULL);
+   assert(ptr != NULL);
+
+   struct BumpArena * self = arena;
+   if ( new_sz <= bump_usable_size(ptr, old_sz, arena) )
+   {
+      return true;
+   }
+
+   size_t rounded_sz;
+   if ( (ptr == self->last_block) && fits_at(self, ptr, new_sz, &rounded_sz) )
+   {
+      self->bump_ptr = self->last_block + rounded_sz;
+      return true;
+   }
+
+   return false;
+}
+
+size_t bump_usable_size(void * ptr, size_t req_sz, void * arena)
+{
+   (void)ptr;
+   (void)arena;
+
+   if ( req_sz > (SIZE_MAX - (BUMP_DEFAULT_ALIGNMENT - 1)) )
+   {
+      return req_sz;
+   }
+   return (req_sz + (BUMP_DEFAULT_ALIGNMENT - 1)) & ~(BUMP_DEFAULT_ALIGNMENT - 1);
+}
+
+/* Private Function Definitions */
+
+/**
+ * @brief Checks if a block of req_sz bytes (rounded up to the default
+ *        alignment) starting at at would fit in the arena.
+ * @param rounded_sz Where to put the rounded size (only set if it fits)
+ * @return true if it fits; false otherwise.
+ */
+static bool fits_at(const struct BumpArena * arena, const uint8_t * at,
+                    size_t req_sz, size_t * rounded_sz)
+{
+   assert( (at >= arena->start) && (at <= arena->end) );
+
+   // The rounded size must fit as well, since it's what usable_size reports
+   size_t avail = (size_t)(arena->end - at);
+   size_t sz = bump_usable_size(NULL, req_sz, NULL);
+   if ( (req_sz > avail) || (sz > avail) )
+   {
+      return false;
+   }
+
+   *rounded_sz = sz;
+   return true;
+}
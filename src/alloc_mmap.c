@@ -0,0 +1,396 @@
+/**
+ * @file alloc_mmap.c
+ * @brief Implementation of the mmap-backed allocator.
+ *
+ * The allocator doesn't keep any per-block bookkeeping. Instead, it relies on
+ * the invariant that a block is mapped from the OS _iff_ its size is at or
+ * above the threshold. Since callers always pass in the block's size on
+ * realloc/reclaim, that is enough to tell which of the two backends owns it.
+ * For that to hold for any size between the requested and usable size, the
+ * usable size reported for malloc'd blocks is capped just below the threshold.
+ * Likewise, whether a mapped block is rounded to huge pages depends on nothing
+ * but its size, so the same rounding can be recomputed on remap/unmap.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+#if defined(__linux__)
+#define _GNU_SOURCE // mremap, MAP_ANONYMOUS
+#endif
+
+/* File Inclusions */
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#define MMAP_SUPPORTED
+#endif
+
+#include "ccol_shared.h"
+#include "alloc_mmap.h"
+
+/* Private Function Prototypes */
+
+static size_t threshold_of(const void * arena);
+#ifdef MMAP_SUPPORTED
+static enum MmapHugePages huge_pages_of(const void * arena);
+static bool   is_huge(const void * arena, size_t sz);
+static size_t map_size(const void * arena, size_t sz);
+static void * map_block(const void * arena, size_t sz, size_t alignment);
+static void * remap_block(void * old_ptr, size_t old_sz, size_t new_sz, const void * arena);
+static void * map_pages(size_t sz);
+static void * map_pages_aligned(size_t sz, size_t alignment);
+#endif
+
+/* Public Function Definitions */
+
+void * mmap_alloc(size_t req_sz, void * arena)
+{
+#ifdef MMAP_SUPPORTED
+   if ( req_sz >= threshold_of(arena) )
+   {
+      return map_block(arena, req_sz, 0);
+   }
+#endif
+   (void)arena;
+   return malloc(req_sz);
+}
+
+void * mmap_alloc_zeroed(size_t req_sz, void * arena)
+{
+#ifdef MMAP_SUPPORTED
+   if ( req_sz >= threshold_of(arena) )
+   {
+      // Fresh anonymous mappings are already zero
+      return map_block(arena, req_sz, 0);
+   }
+#endif
+   (void)arena;
+   return calloc(1, req_sz);
+}
+
+void * mmap_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   if ( NULL == old_ptr )
+   {
+      return mmap_alloc(new_sz, arena);
+   }
+
+#ifdef MMAP_SUPPORTED
+   size_t threshold = threshold_of(arena);
+   bool was_mapped = (old_sz >= threshold);
+   bool is_mapped  = (new_sz >= threshold);
+
+   if ( was_mapped && is_mapped )
+   {
+      return remap_block(old_ptr, old_sz, new_sz, arena);
+   }
+   else if ( was_mapped || is_mapped )
+   {
+      // Crossing the threshold means switching backends, which unavoidably
+      // involves a copy. This happens at most once on the way up.
+      void * new_ptr = mmap_alloc(new_sz, arena);
+      if ( new_ptr != NULL )
+      {
+         memcpy( new_ptr, old_ptr, (old_sz < new_sz) ? old_sz : new_sz );
+         mmap_reclaim(old_ptr, old_sz, arena);
+      }
+      return new_ptr;
+   }
+#else
+   (void)old_sz;
+   (void)arena;
+#endif
+
+   return realloc(old_ptr, new_sz);
+}
+
+void mmap_reclaim(void * old_ptr, size_t old_sz, void * arena)
+{
+   if ( NULL == old_ptr )
+   {
+      return;
+   }
+
+#ifdef MMAP_SUPPORTED
+   if ( old_sz >= threshold_of(arena) )
+   {
+      int rc = munmap( old_ptr, map_size(arena, old_sz) );
+      assert(0 == rc);
+      (void)rc;
+      return;
+   }
+#else
+   (void)old_sz;
+   (void)arena;
+#endif
+
+   free(old_ptr);
+}
+
+bool mmap_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   assert(ptr != NULL);
+
+   if ( new_sz <= mmap_usable_size(ptr, old_sz, arena) )
+   {
+      return true;
+   }
+
+#ifdef MMAP_SUPPORTED
+   if ( (old_sz >= threshold_of(arena)) &&
+        ( !is_huge(arena, new_sz) || (0 == ((uintptr_t)ptr % MMAP_HUGE_PAGE_SIZE)) ) )
+   {
+      // Without MREMAP_MAYMOVE, the kernel only succeeds if it can extend the
+      // mapping right where it is. (Blocks growing into huge pages are left to
+      // realloc if they don't start on a huge page boundary.)
+      return mremap( ptr, map_size(arena, old_sz), map_size(arena, new_sz), 0 ) != MAP_FAILED;
+   }
+#endif
+
+   return false;
+}
+
+size_t mmap_usable_size(void * ptr, size_t req_sz, void * arena)
+{
+#ifdef MMAP_SUPPORTED
+   size_t threshold = threshold_of(arena);
+   if ( req_sz >= threshold )
+   {
+      return map_size(arena, req_sz);
+   }
+
+   // Cap the slack so that the block is never mistaken for a mapped one
+   size_t usable = default_usable_size(ptr, req_sz, NULL);
+   return (usable >= threshold) ? (threshold - 1) : usable;
+#else
+   (void)arena;
+   return default_usable_size(ptr, req_sz, NULL);
+#endif
+}
+
+void * mmap_alloc_aligned(size_t req_sz, size_t alignment, void * arena)
+{
+#ifdef MMAP_SUPPORTED
+   if ( req_sz >= threshold_of(arena) )
+   {
+      return map_block(arena, req_sz, alignment);
+   }
+#endif
+   (void)arena;
+   return default_alloc_aligned(req_sz, alignment, NULL);
+}
+
+void * mmap_realloc_aligned(void * old_ptr, size_t new_sz, size_t old_sz, size_t alignment, void * arena)
+{
+   if ( NULL == old_ptr )
+   {
+      return mmap_alloc_aligned(new_sz, alignment, arena);
+   }
+
+#ifdef MMAP_SUPPORTED
+   size_t threshold = threshold_of(arena);
+   if ( (old_sz >= threshold) && (new_sz >= threshold) &&
+        ( (alignment <= ccol_page_size()) ||
+          (is_huge(arena, new_sz) && (alignment <= MMAP_HUGE_PAGE_SIZE)) ) )
+   {
+      // Mappings always start on a page boundary, wherever mremap puts them,
+      // and remap_block keeps huge page mappings on a huge page boundary
+      return remap_block(old_ptr, old_sz, new_sz, arena);
+   }
+#endif
+
+   void * new_ptr = mmap_alloc_aligned(new_sz, alignment, arena);
+   if ( new_ptr != NULL )
+   {
+      memcpy( new_ptr, old_ptr, (old_sz < new_sz) ? old_sz : new_sz );
+      mmap_reclaim(old_ptr, old_sz, arena);
+   }
+   return new_ptr;
+}
+
+/* Private Function Definitions */
+
+static size_t threshold_of(const void * arena)
+{
+   if ( NULL == arena )
+   {
+      return MMAP_DEFAULT_THRESHOLD;
+   }
+
+   const struct MmapArena * cfg = arena;
+   assert(cfg->threshold > 0);
+   return cfg->threshold;
+}
+
+#ifdef MMAP_SUPPORTED
+static enum MmapHugePages huge_pages_of(const void * arena)
+{
+   if ( NULL == arena )
+   {
+      return MMAP_DEFAULT_HUGE_PAGES;
+   }
+
+   const struct MmapArena * cfg = arena;
+   return cfg->huge_pages;
+}
+
+/**
+ * @brief Whether a mapped block of sz bytes is to be backed by huge pages.
+ */
+static bool is_huge(const void * arena, size_t sz)
+{
+   return (huge_pages_of(arena) != MmapHugePages_Off) && (sz >= MMAP_HUGE_PAGE_SIZE);
+}
+
+/**
+ * @brief Actual length of the mapping behind a mapped block of sz bytes.
+ */
+static size_t map_size(const void * arena, size_t sz)
+{
+   if ( is_huge(arena, sz) && (sz <= (SIZE_MAX - MMAP_HUGE_PAGE_SIZE)) )
+   {
+      return (sz + (MMAP_HUGE_PAGE_SIZE - 1)) & ~(MMAP_HUGE_PAGE_SIZE - 1);
+   }
+   return ccol_page_round(sz);
+}
+
+/**
+ * @brief Maps a fresh block of sz bytes, starting on an alignment boundary (0
+ *        for no more than a page boundary), backed by huge pages if need be.
+ */
+static void * map_block(const void * arena, size_t sz, size_t alignment)
+{
+   if ( !is_huge(arena, sz) )
+   {
+      return map_pages_aligned(sz, alignment);
+   }
+
+   sz = map_size(arena, sz);
+#ifdef MAP_HUGETLB
+   if ( (MmapHugePages_Explicit == huge_pages_of(arena)) && (alignment <= MMAP_HUGE_PAGE_SIZE) )
+   {
+      void * ptr = mmap( NULL, sz, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+      if ( ptr != MAP_FAILED )
+      {
+         return ptr;
+      }
+      // The huge page pool is likely empty (or not set up): settle for THP
+   }
+#endif
+
+   // The kernel can only back the block with huge pages where those fall
+   // entirely within it, so start it on a huge page boundary
+   uint8_t * ptr = map_pages_aligned( sz, (alignment > MMAP_HUGE_PAGE_SIZE) ? alignment : MMAP_HUGE_PAGE_SIZE );
+#ifdef MADV_HUGEPAGE
+   if ( ptr != NULL )
+   {
+      (void)madvise(ptr, sz, MADV_HUGEPAGE);
+   }
+#endif
+   return ptr;
+}
+
+/**
+ * @brief Resizes a mapped block (to a size that still gets mapped) without
+ *        copying it, if the kernel lets us.
+ */
+static void * remap_block(void * old_ptr, size_t old_sz, size_t new_sz, const void * arena)
+{
+   size_t old_map_sz = map_size(arena, old_sz);
+   size_t new_map_sz = map_size(arena, new_sz);
+
+   if ( !is_huge(arena, new_sz) )
+   {
+      void * new_ptr = mremap( old_ptr, old_map_sz, new_map_sz, MREMAP_MAYMOVE );
+      return (MAP_FAILED == new_ptr) ? NULL : new_ptr;
+   }
+
+   // Letting mremap pick where to move the block would likely lose its huge
+   // page alignment. So grow it where it is if it's already aligned and there
+   // is room, and otherwise move its pages over to an aligned spot ourselves.
+   void * new_ptr;
+   if ( 0 == ((uintptr_t)old_ptr % MMAP_HUGE_PAGE_SIZE) )
+   {
+      new_ptr = mremap( old_ptr, old_map_sz, new_map_sz, 0 );
+      if ( new_ptr != MAP_FAILED )
+      {
+         return new_ptr;
+      }
+   }
+
+   uint8_t * target = map_pages_aligned(new_map_sz, MMAP_HUGE_PAGE_SIZE);
+   if ( NULL == target )
+   {
+      return NULL;
+   }
+   new_ptr = mremap( old_ptr, old_map_sz, new_map_sz, MREMAP_MAYMOVE | MREMAP_FIXED, target );
+   if ( new_ptr != MAP_FAILED )
+   {
+#ifdef MADV_HUGEPAGE
+      // The pages brought over their old mapping's advice (or lack thereof)
+      (void)madvise(new_ptr, new_map_sz, MADV_HUGEPAGE);
+#endif
+      return new_ptr;
+   }
+
+   // Some mappings (e.g., older kernels' MAP_HUGETLB ones) can't be moved
+   (void)munmap(target, new_map_sz);
+   new_ptr = map_block(arena, new_sz, 0);
+   if ( new_ptr != NULL )
+   {
+      memcpy( new_ptr, old_ptr, (old_sz < new_sz) ? old_sz : new_sz );
+      (void)munmap(old_ptr, old_map_sz);
+   }
+   return new_ptr;
+}
+
+static void * map_pages(size_t sz)
+{
+   void * ptr = mmap( NULL, ccol_page_round(sz), PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+   return (MAP_FAILED == ptr) ? NULL : ptr;
+}
+
+static void * map_pages_aligned(size_t sz, size_t alignment)
+{
+   size_t page_sz = ccol_page_size();
+   if ( alignment <= page_sz )
+   {
+      return map_pages(sz);
+   }
+
+   // Map enough to be sure an aligned start lies within, then trim the excess
+   // on either side so that the block unmaps like any other.
+   sz = ccol_page_round(sz);
+   if ( sz > (SIZE_MAX - alignment) )
+   {
+      return NULL;
+   }
+   uint8_t * raw = map_pages(sz + alignment);
+   if ( NULL == raw )
+   {
+      return NULL;
+   }
+   uint8_t * aligned = (uint8_t *)( ((uintptr_t)raw + (alignment - 1)) & ~(uintptr_t)(alignment - 1) );
+   size_t head = (size_t)(aligned - raw);
+   size_t tail = alignment - head;
+   if ( head > 0 )
+   {
+      (void)munmap( raw, head );
+   }
+   if ( tail > 0 )
+   {
+      (void)munmap( aligned + sz, tail );
+   }
+   return aligned;
+}
+#endif
@@ -0,0 +1,243 @@
+/**
+ * @file alloc_slab.c
+ * @brief Implementation of the size-class slab allocator.
+ *
+ * Like the mmap allocator, no per-block bookkeeping is kept: the size class of
+ * a block is recomputed from the size the caller passes back in. Any size
+ * between the requested size and the class size maps to the same class, which
+ * is what makes reporting the class size as the usable size safe.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "ccol_shared.h"
+#include "alloc_slab.h"
+
+/* Local Macro Definitions */
+
+#define CLASS_SZ(cls)   ( (size_t)1 << ((cls) + SLAB_MIN_CLASS_SHIFT) )
+#define MIN_CLASS_SZ    CLASS_SZ(0)
+#define MAX_CLASS_SZ    CLASS_SZ(SLAB_NUM_CLASSES - 1)
+
+// Keeps blocks carved right after the chunk header 16-byte aligned
+#define CHUNK_HEADER_SZ (16u)
+
+/* Local Datatypes */
+
+struct SlabChunk
+{
+   struct SlabChunk * next;
+};
+
+struct SlabFreeBlock
+{
+   struct SlabFreeBlock * next;
+};
+
+/* Private Function Prototypes */
+
+static size_t class_of(size_t sz);
+static void * carve(struct SlabArena * self, size_t sz);
+static void   push_free(struct SlabArena * self, size_t cls, void * block);
+
+/* Public Function Definitions */
+
+void slab_init(struct SlabArena * arena)
+{
+   assert(arena != NULL);
+   assert(sizeof(struct SlabChunk) <= CHUNK_HEADER_SZ);
+
+   for ( size_t i = 0; i < SLAB_NUM_CLASSES; i++ )
+   {
+      arena->free_lists[i] = NULL;
+   }
+   arena->chunks = NULL;
+   arena->carve_ptr = NULL;
+   arena->carve_end = NULL;
+}
+
+void slab_destroy(struct SlabArena * arena)
+{
+   assert(arena != NULL);
+
+   struct SlabChunk * chunk = arena->chunks;
+   while ( chunk != NULL )
+   {
+      struct SlabChunk * next = chunk->next;
+      free(chunk);
+      chunk = next;
+   }
+   slab_init(arena);
+}
+
+void * slab_alloc(size_t req_sz, void * arena)
+{
+   assert(arena != NULL);
+
+   struct SlabArena * self = arena;
+   if ( req_sz > MAX_CLASS_SZ )
+   {
+      return malloc(req_sz);
+   }
+
+   size_t cls = class_of(req_sz);
+   struct SlabFreeBlock * block = self->free_lists[cls];
+   if ( block != NULL )
+   {
+      self->free_lists[cls] = block->next;
+      return block;
+   }
+
+   return carve(self, CLASS_SZ(cls));
+}
+
+void * slab_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   assert(arena != NULL);
+
+   if ( NULL == old_ptr )
+   {
+      return slab_alloc(new_sz, arena);
+   }
+
+   if ( (old_sz > MAX_CLASS_SZ) && (new_sz > MAX_CLASS_SZ) )
+   {
+      return realloc(old_ptr, new_sz);
+   }
+
+   if ( (old_sz <= MAX_CLASS_SZ) && (new_sz <= MAX_CLASS_SZ) &&
+        (class_of(old_sz) == class_of(new_sz)) )
+   {
+      return old_ptr;
+   }
+
+   void * new_ptr = slab_alloc(new_sz, arena);
+   if ( new_ptr != NULL )
+   {
+      memcpy( new_ptr, old_ptr, (old_sz < new_sz) ? old_sz : new_sz );
+      slab_reclaim(old_ptr, old_sz, arena);
+   }
+   return new_ptr;
+}
+
+void slab_reclaim(void * old_ptr, size_t old_sz, void * arena)
+{
+   assert(arena != NULL);
+
+   if ( NULL == old_ptr )
+   {
+      return;
+   }
+
+   if ( old_sz > MAX_CLASS_SZ )
+   {
+      free(old_ptr);
+      return;
+   }
+
+   push_free(arena, class_of(old_sz), old_ptr);
+}
+
+bool slab_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   return new_sz <= slab_usable_size(ptr, old_sz, arena);
+}
+
+size_t slab_usable_size(void * ptr, size_t req_sz, void * arena)
+{
+   (void)arena;
+
+   if ( req_sz > MAX_CLASS_SZ )
+   {
+      return default_usable_size(ptr, req_sz, NULL);
+   }
+   return CLASS_SZ( class_of(req_sz) );
+}
+
+/* Private Function Definitions */
+
+/**
+ * @brief Index of the smallest size class that fits sz (<= MAX_CLASS_SZ) bytes.
+ */
+static size_t class_of(size_t sz)
+{
+   assert(sz <= MAX_CLASS_SZ);
+
+   if ( sz <= MIN_CLASS_SZ )
+   {
+      return 0;
+   }
+
+#if defined(__GNUC__)
+   // ceil(log2(sz)) is the bit width of (sz - 1)
+   size_t width = (sizeof(unsigned long long) * CHAR_BIT) -
+                  (size_t)__builtin_clzll( (unsigned long long)(sz - 1) );
+   return width - SLAB_MIN_CLASS_SHIFT;
+#else
+   size_t cls = 0;
+   while ( CLASS_SZ(cls) < sz )
+   {
+      cls++;
+   }
+   return cls;
+#endif
+}
+
+/**
+ * @brief Carves a fresh block of sz bytes out of the current chunk, moving on
+ *        to a new chunk if the current one is used up.
+ */
+static void * carve(struct SlabArena * self, size_t sz)
+{
+   if ( (size_t)(self->carve_end - self->carve_ptr) < sz )
+   {
+      uint8_t * chunk = malloc(SLAB_CHUNK_SIZE);
+      if ( NULL == chunk )
+      {
+         return NULL;
+      }
+
+      // Rather than waste the tail of the old chunk, hand it out to the free
+      // lists of whichever classes it can be split into.
+      while ( (size_t)(self->carve_end - self->carve_ptr) >= MIN_CLASS_SZ )
+      {
+         size_t cls = class_of( (size_t)(self->carve_end - self->carve_ptr) );
+         if ( CLASS_SZ(cls) > (size_t)(self->carve_end - self->carve_ptr) )
+         {
+            cls--;
+         }
+         push_free(self, cls, self->carve_ptr);
+         self->carve_ptr += CLASS_SZ(cls);
+      }
+
+      struct SlabChunk * header = (struct SlabChunk *)(void *)chunk;
+      header->next = self->chunks;
+      self->chunks = header;
+      self->carve_ptr = chunk + CHUNK_HEADER_SZ;
+      self->carve_end = chunk + SLAB_CHUNK_SIZE;
+   }
+
+   void * block = self->carve_ptr;
+   self->carve_ptr += sz;
+   return block;
+}
+
+static void push_free(struct SlabArena * self, size_t cls, void * block)
+{
+   assert(cls < SLAB_NUM_CLASSES);
+
+   struct SlabFreeBlock * free_block = block;
+   free_block->next = self->free_lists[cls];
+   self->free_lists[cls] = free_block;
+}
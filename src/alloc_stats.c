@@ -0,0 +1,559 @@
+/**
+ * @file alloc_stats.c
+ * @brief Implementation of the statistics-gathering allocator.
+ *
+ * Nothing is kept per block: sizes come from the caller (or the inner
+ * allocator's usable_size), as with every other hook. So the bookkeeping per
+ * call is a few plain adds to the calling thread's slot and one relaxed atomic
+ * add to the live bytes, plus a clock read pair on the sampled calls.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+#if ( defined(__unix__) || defined(__APPLE__) ) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L // clock_gettime
+#endif
+
+/* File Inclusions */
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+#include "ccol_shared.h"
+#include "alloc_stats.h"
+
+/* Local Macro Definitions */
+
+#if STATS_THREAD_SAFE && defined(__GNUC__)
+#define STATS_ATOMIC
+#endif
+
+#if defined(__GNUC__)
+#define STATS_THREAD_LOCAL __thread
+#endif
+
+// Live and peak bytes, shared by every thread
+#ifdef STATS_ATOMIC
+#define STAT_ADD(field, n)    __atomic_add_fetch( &(field), (n), __ATOMIC_RELAXED )
+#define STAT_SUB(field, n)    __atomic_sub_fetch( &(field), (n), __ATOMIC_RELAXED )
+#define STAT_LOAD(field)      __atomic_load_n( &(field), __ATOMIC_RELAXED )
+#define STAT_STORE(field, v)  __atomic_store_n( &(field), (v), __ATOMIC_RELAXED )
+#else
+// Counts may be lost if several threads share the wrapper
+#define STAT_ADD(field, n)    ( (field) += (n) )
+#define STAT_SUB(field, n)    ( (field) -= (n) )
+#define STAT_LOAD(field)      (field)
+#define STAT_STORE(field, v)  ( (field) = (v) )
+#endif
+
+// Counters of a thread's slot (a struct StatsSlot). A thread alone in its slot
+// is the only one writing to it, so a plain add will do; the store is only
+// atomic so that a snapshot taken meanwhile can't read a torn value.
+#ifdef STATS_ATOMIC
+#define SLOT_ADD(slot, field, n) \
+   ( (slot).shared ? __atomic_add_fetch( &(slot).stats->field, (n), __ATOMIC_RELAXED ) \
+                   : ( __atomic_store_n( &(slot).stats->field, (slot).stats->field + (n), __ATOMIC_RELAXED ), \
+                       (slot).stats->field ) )
+#define SLOT_SUB(slot, field, n) \
+   ( (slot).shared ? __atomic_sub_fetch( &(slot).stats->field, (n), __ATOMIC_RELAXED ) \
+                   : ( __atomic_store_n( &(slot).stats->field, (slot).stats->field - (n), __ATOMIC_RELAXED ), \
+                       (slot).stats->field ) )
+#else
+#define SLOT_ADD(slot, field, n)   ( (slot).stats->field += (n) )
+#define SLOT_SUB(slot, field, n)   ( (slot).stats->field -= (n) )
+#endif
+
+#if defined(CLOCK_MONOTONIC) && (STATS_LATENCY_SAMPLE_PERIOD > 0)
+#define STATS_TIMED
+#endif
+
+#define ARENA_OF(arena) ( (struct StatsArena *)(arena) )
+#define INNER_OF(arena) ( &((struct StatsArena *)(arena))->inner )
+
+/* Local Datatypes */
+
+/**
+ * @brief The slot a thread counts into.
+ * @param stats  Its counters
+ * @param shared Whether other threads may count into it too
+ */
+struct StatsSlot
+{
+   struct AllocStats * stats;
+   bool shared;
+};
+
+/**
+ * @brief What stats_usable_size last returned on a thread, kept until that
+ *        thread's next call into a wrapper.
+ *
+ * Vectors ask for the usable size of their array right before they expand or
+ * realloc it, so the wrapper needn't ask the inner allocator again to know
+ * what the old block held. Since the entry doesn't outlive the next call, the
+ * block can't have changed hands in between.
+ */
+struct UsableSizeEntry
+{
+   const void * arena;
+   const void * ptr;
+   size_t sz;
+   size_t usable;
+};
+
+/* Local Variables */
+
+#ifdef STATS_ATOMIC
+static size_t SlotsClaimed = 0;
+static STATS_THREAD_LOCAL size_t ThisThreadSlot = 0; // Slot + 1, or 0 until claimed
+#endif
+
+#ifdef STATS_THREAD_LOCAL
+static STATS_THREAD_LOCAL struct UsableSizeEntry LastUsableSize = { NULL, NULL, 0, 0 };
+#endif
+
+/* Private Function Prototypes */
+
+static struct StatsSlot slot_of(void * arena);
+static bool     is_sampled(uint64_t call_no);
+static uint64_t now_ns(void);
+static void     record_latency(struct StatsSlot slot, uint64_t ns);
+static size_t   held_size(const struct Allocator * inner, void * ptr, size_t sz);
+static size_t   old_held_size(void * arena, void * ptr, size_t sz);
+static void     resize_live(struct StatsArena * arena, size_t old_sz, size_t new_sz);
+static void     after_alloc(void * arena, struct StatsSlot slot, void * ptr, size_t req_sz, uint64_t start);
+static void     after_realloc(void * arena, struct StatsSlot slot, void * new_ptr, size_t new_sz,
+                              size_t old_held, uint64_t start);
+static size_t   bucket_of(uint64_t val, size_t num_buckets);
+
+/* Public Function Definitions */
+
+struct Allocator stats_wrap(struct StatsArena * arena, const struct Allocator * inner)
+{
+   if ( (NULL == arena) || (NULL == inner) ||
+        (NULL == inner->alloc) || (NULL == inner->realloc) || (NULL == inner->reclaim) )
+   {
+      // TODO: Throw exception for an incomplete allocator
+      return (struct Allocator){ .alloc = NULL };
+   }
+
+   arena->inner = *inner;
+   arena->inner.refs = 0;
+   arena->live_bytes = 0;
+   arena->peak_bytes = 0;
+   memset(arena->slots, 0, sizeof(arena->slots));
+
+   // Only offer the optional hooks the inner allocator has, since vectors
+   // take a missing hook to mean something (e.g., that slack can't be used)
+   return (struct Allocator){
+      .alloc = stats_alloc,
+      .realloc = stats_realloc,
+      .reclaim = stats_reclaim,
+      .alloca_init = (inner->alloca_init != NULL) ? stats_alloca_init : NULL,
+      .arena = arena,
+      .alloc_zeroed = (inner->alloc_zeroed != NULL) ? stats_alloc_zeroed : NULL,
+      .try_expand_in_place = (inner->try_expand_in_place != NULL) ? stats_try_expand_in_place : NULL,
+      .usable_size = (inner->usable_size != NULL) ? stats_usable_size : NULL,
+      .alloc_aligned = (inner->alloc_aligned != NULL) ? stats_alloc_aligned : NULL,
+      .realloc_aligned = (inner->realloc_aligned != NULL) ? stats_realloc_aligned : NULL,
+      .alloca_deinit = (inner->alloca_deinit != NULL) ? stats_alloca_deinit : NULL,
+      .reset = (inner->reset != NULL) ? stats_reset : NULL
+   };
+}
+
+void stats_snapshot(const struct StatsArena * arena, struct AllocStats * snapshot)
+{
+   assert(arena != NULL);
+   assert(snapshot != NULL);
+
+   memset(snapshot, 0, sizeof(struct AllocStats));
+   snapshot->live_bytes = STAT_LOAD(arena->live_bytes);
+   snapshot->peak_bytes = STAT_LOAD(arena->peak_bytes);
+   for ( size_t slot = 0; slot < STATS_THREAD_SLOTS; slot++ )
+   {
+      const struct AllocStats * stats = &arena->slots[slot];
+      snapshot->allocs += STAT_LOAD(stats->allocs);
+      snapshot->reallocs += STAT_LOAD(stats->reallocs);
+      snapshot->reclaims += STAT_LOAD(stats->reclaims);
+      snapshot->expands_in_place += STAT_LOAD(stats->expands_in_place);
+      snapshot->failures += STAT_LOAD(stats->failures);
+      snapshot->resets += STAT_LOAD(stats->resets);
+      // A block may be freed on another thread than it was allocated on, so
+      // a slot's count can wrap below 0, but the sum comes out right
+      snapshot->live_blocks += STAT_LOAD(stats->live_blocks);
+      for ( size_t i = 0; i < STATS_SIZE_BUCKETS; i++ )
+      {
+         snapshot->realloc_sizes[i] += STAT_LOAD(stats->realloc_sizes[i]);
+      }
+      snapshot->latency_samples += STAT_LOAD(stats->latency_samples);
+      snapshot->latency_total_ns += STAT_LOAD(stats->latency_total_ns);
+      uint64_t max_ns = STAT_LOAD(stats->latency_max_ns);
+      snapshot->latency_max_ns = (max_ns > snapshot->latency_max_ns) ? max_ns : snapshot->latency_max_ns;
+      for ( size_t i = 0; i < STATS_LATENCY_BUCKETS; i++ )
+      {
+         snapshot->latency_ns[i] += STAT_LOAD(stats->latency_ns[i]);
+      }
+   }
+}
+
+void stats_clear(struct StatsArena * arena)
+{
+   assert(arena != NULL);
+
+   for ( size_t slot = 0; slot < STATS_THREAD_SLOTS; slot++ )
+   {
+      struct AllocStats * stats = &arena->slots[slot];
+      STAT_STORE(stats->allocs, 0);
+      STAT_STORE(stats->reallocs, 0);
+      STAT_STORE(stats->reclaims, 0);
+      STAT_STORE(stats->expands_in_place, 0);
+      STAT_STORE(stats->failures, 0);
+      STAT_STORE(stats->resets, 0);
+      for ( size_t i = 0; i < STATS_SIZE_BUCKETS; i++ )
+      {
+         STAT_STORE(stats->realloc_sizes[i], 0);
+      }
+      STAT_STORE(stats->latency_samples, 0);
+      STAT_STORE(stats->latency_total_ns, 0);
+      STAT_STORE(stats->latency_max_ns, 0);
+      for ( size_t i = 0; i < STATS_LATENCY_BUCKETS; i++ )
+      {
+         STAT_STORE(stats->latency_ns[i], 0);
+      }
+   }
+   STAT_STORE(arena->peak_bytes, STAT_LOAD(arena->live_bytes));
+}
+
+void * stats_alloc(size_t req_sz, void * arena)
+{
+   const struct Allocator * inner = INNER_OF(arena);
+   struct StatsSlot slot = slot_of(arena);
+   uint64_t start = is_sampled( SLOT_ADD(slot, allocs, 1) ) ? now_ns() : 0;
+   void * ptr = inner->alloc(req_sz, inner->arena);
+   after_alloc(arena, slot, ptr, req_sz, start);
+   return ptr;
+}
+
+void * stats_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   if ( NULL == old_ptr )
+   {
+      return stats_alloc(new_sz, arena);
+   }
+
+   const struct Allocator * inner = INNER_OF(arena);
+   struct StatsSlot slot = slot_of(arena);
+   size_t old_held = old_held_size(arena, old_ptr, old_sz);
+   uint64_t start = is_sampled( SLOT_ADD(slot, reallocs, 1) ) ? now_ns() : 0;
+   void * new_ptr = inner->realloc(old_ptr, new_sz, old_sz, inner->arena);
+   after_realloc(arena, slot, new_ptr, new_sz, old_held, start);
+   return new_ptr;
+}
+
+void stats_reclaim(void * old_ptr, size_t old_sz, void * arena)
+{
+   if ( NULL == old_ptr )
+   {
+      return;
+   }
+
+   const struct Allocator * inner = INNER_OF(arena);
+   struct StatsSlot slot = slot_of(arena);
+   SLOT_ADD(slot, reclaims, 1);
+   SLOT_SUB(slot, live_blocks, 1);
+   STAT_SUB(ARENA_OF(arena)->live_bytes, old_held_size(arena, old_ptr, old_sz));
+   inner->reclaim(old_ptr, old_sz, inner->arena);
+}
+
+void stats_alloca_init(void * arena)
+{
+   const struct Allocator * inner = INNER_OF(arena);
+   inner->alloca_init(inner->arena);
+}
+
+void * stats_alloc_zeroed(size_t req_sz, void * arena)
+{
+   const struct Allocator * inner = INNER_OF(arena);
+   struct StatsSlot slot = slot_of(arena);
+   uint64_t start = is_sampled( SLOT_ADD(slot, allocs, 1) ) ? now_ns() : 0;
+   void * ptr = inner->alloc_zeroed(req_sz, inner->arena);
+   after_alloc(arena, slot, ptr, req_sz, start);
+   return ptr;
+}
+
+bool stats_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   const struct Allocator * inner = INNER_OF(arena);
+   size_t old_held = old_held_size(arena, ptr, old_sz);
+   if ( !inner->try_expand_in_place(ptr, new_sz, old_sz, inner->arena) )
+   {
+#ifdef STATS_THREAD_LOCAL
+      // Still the same block, for the realloc that usually follows
+      LastUsableSize = (struct UsableSizeEntry){ arena, ptr, old_sz, old_held };
+#endif
+      return false;
+   }
+
+   struct StatsSlot slot = slot_of(arena);
+   SLOT_ADD(slot, expands_in_place, 1);
+   resize_live( ARENA_OF(arena), old_held, held_size(inner, ptr, new_sz) );
+   return true;
+}
+
+size_t stats_usable_size(void * ptr, size_t req_sz, void * arena)
+{
+   const struct Allocator * inner = INNER_OF(arena);
+   size_t usable = inner->usable_size(ptr, req_sz, inner->arena);
+#ifdef STATS_THREAD_LOCAL
+   LastUsableSize = (struct UsableSizeEntry){ arena, ptr, req_sz, usable };
+#endif
+   return usable;
+}
+
+void * stats_alloc_aligned(size_t req_sz, size_t alignment, void * arena)
+{
+   const struct Allocator * inner = INNER_OF(arena);
+   struct StatsSlot slot = slot_of(arena);
+   uint64_t start = is_sampled( SLOT_ADD(slot, allocs, 1) ) ? now_ns() : 0;
+   void * ptr = inner->alloc_aligned(req_sz, alignment, inner->arena);
+   after_alloc(arena, slot, ptr, req_sz, start);
+   return ptr;
+}
+
+void * stats_realloc_aligned(void * old_ptr, size_t new_sz, size_t old_sz, size_t alignment, void * arena)
+{
+   if ( NULL == old_ptr )
+   {
+      return stats_alloc_aligned(new_sz, alignment, arena);
+   }
+
+   const struct Allocator * inner = INNER_OF(arena);
+   struct StatsSlot slot = slot_of(arena);
+   size_t old_held = old_held_size(arena, old_ptr, old_sz);
+   uint64_t start = is_sampled( SLOT_ADD(slot, reallocs, 1) ) ? now_ns() : 0;
+   void * new_ptr = inner->realloc_aligned(old_ptr, new_sz, old_sz, alignment, inner->arena);
+   after_realloc(arena, slot, new_ptr, new_sz, old_held, start);
+   return new_ptr;
+}
+
+void stats_alloca_deinit(void * arena)
+{
+   const struct Allocator * inner = INNER_OF(arena);
+   inner->alloca_deinit(inner->arena);
+}
+
+void stats_reset(void * arena)
+{
+   const struct Allocator * inner = INNER_OF(arena);
+   inner->reset(inner->arena);
+
+   struct StatsArena * stats_arena = ARENA_OF(arena);
+   struct StatsSlot slot = slot_of(arena);
+   SLOT_ADD(slot, resets, 1);
+   STAT_STORE(stats_arena->live_bytes, 0);
+   for ( size_t i = 0; i < STATS_THREAD_SLOTS; i++ )
+   {
+      STAT_STORE(stats_arena->slots[i].live_blocks, 0);
+   }
+}
+
+/* Private Function Definitions */
+
+/**
+ * @brief This thread's slot in arena. Threads are given slots in the order
+ *        they first call into any wrapper, and keep them.
+ */
+static struct StatsSlot slot_of(void * arena)
+{
+#ifdef STATS_ATOMIC
+   if ( 0 == ThisThreadSlot )
+   {
+      size_t claimed = __atomic_fetch_add( &SlotsClaimed, 1, __ATOMIC_RELAXED );
+      ThisThreadSlot = ( (claimed < STATS_THREAD_SLOTS) ? claimed : (STATS_THREAD_SLOTS - 1) ) + 1;
+   }
+   size_t idx = ThisThreadSlot - 1;
+   return (struct StatsSlot){ &ARENA_OF(arena)->slots[idx], (STATS_THREAD_SLOTS - 1) == idx };
+#else
+   return (struct StatsSlot){ &ARENA_OF(arena)->slots[0], false };
+#endif
+}
+
+/**
+ * @brief Whether the call_no'th call of its kind (counting from 1) is timed.
+ */
+static bool is_sampled(uint64_t call_no)
+{
+#ifdef STATS_TIMED
+   return 0 == (call_no % STATS_LATENCY_SAMPLE_PERIOD);
+#else
+   (void)call_no;
+   return false;
+#endif
+}
+
+/**
+ * @brief Monotonic clock reading, never 0 (which marks an untimed call).
+ */
+static uint64_t now_ns(void)
+{
+#ifdef STATS_TIMED
+   struct timespec ts;
+   (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ( (uint64_t)ts.tv_sec * UINT64_C(1000000000) + (uint64_t)ts.tv_nsec ) | 1u;
+#else
+   return 0;
+#endif
+}
+
+static void record_latency(struct StatsSlot slot, uint64_t ns)
+{
+   SLOT_ADD(slot, latency_samples, 1);
+   SLOT_ADD(slot, latency_total_ns, ns);
+   SLOT_ADD(slot, latency_ns[ bucket_of(ns, STATS_LATENCY_BUCKETS) ], 1);
+
+   uint64_t max = STAT_LOAD(slot.stats->latency_max_ns);
+#ifdef STATS_ATOMIC
+   while ( (ns > max) &&
+           !__atomic_compare_exchange_n( &slot.stats->latency_max_ns, &max, ns,
+                                         true, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+   {
+      // max was refreshed by the failed exchange; try again
+   }
+#else
+   if ( ns > max )
+   {
+      slot.stats->latency_max_ns = ns;
+   }
+#endif
+}
+
+/**
+ * @brief Bytes a block of sz bytes actually holds in the inner allocator.
+ * @note Any size between the requested and usable size maps to the same usable
+ *       size, so this is the same whichever of those the caller passes.
+ */
+static size_t held_size(const struct Allocator * inner, void * ptr, size_t sz)
+{
+   if ( inner->usable_size != NULL )
+   {
+      return inner->usable_size(ptr, sz, inner->arena);
+   }
+   return sz;
+}
+
+/**
+ * @brief held_size of a block that's about to be expanded, realloc'd or
+ *        reclaimed, reusing what the caller was just told if it asked.
+ */
+static size_t old_held_size(void * arena, void * ptr, size_t sz)
+{
+#ifdef STATS_THREAD_LOCAL
+   struct UsableSizeEntry last = LastUsableSize;
+   LastUsableSize.ptr = NULL;
+   if ( (last.ptr == ptr) && (last.arena == arena) && (last.sz == sz) )
+   {
+      return last.usable;
+   }
+#endif
+   return held_size(INNER_OF(arena), ptr, sz);
+}
+
+/**
+ * @brief Accounts for a block (a new one if old_sz is 0) now holding new_sz
+ *        bytes, raising the peak if need be.
+ * @note A single update per call keeps the wrapper's overhead down, since this
+ *       is the one counter that every thread shares.
+ */
+static void resize_live(struct StatsArena * arena, size_t old_sz, size_t new_sz)
+{
+   if ( new_sz < old_sz )
+   {
+      STAT_SUB(arena->live_bytes, old_sz - new_sz);
+      return;
+   }
+
+   size_t live = STAT_ADD(arena->live_bytes, new_sz - old_sz);
+   size_t peak = STAT_LOAD(arena->peak_bytes);
+#ifdef STATS_ATOMIC
+   while ( (live > peak) &&
+           !__atomic_compare_exchange_n( &arena->peak_bytes, &peak, live,
+                                         true, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+   {
+      // peak was refreshed by the failed exchange; try again
+   }
+#else
+   if ( live > peak )
+   {
+      arena->peak_bytes = live;
+   }
+#endif
+}
+
+/**
+ * @param start Clock reading from before the call, or 0 if it wasn't timed
+ */
+static void after_alloc(void * arena, struct StatsSlot slot, void * ptr, size_t req_sz, uint64_t start)
+{
+   if ( start != 0 )
+   {
+      record_latency(slot, now_ns() - start);
+   }
+#ifdef STATS_THREAD_LOCAL
+   LastUsableSize.ptr = NULL;
+#endif
+
+   if ( NULL == ptr )
+   {
+      SLOT_ADD(slot, failures, 1);
+      return;
+   }
+   SLOT_ADD(slot, live_blocks, 1);
+   resize_live( ARENA_OF(arena), 0, held_size(INNER_OF(arena), ptr, req_sz) );
+}
+
+/**
+ * @param old_held Bytes the block held before the call
+ * @param start    Clock reading from before the call, or 0 if it wasn't timed
+ */
+static void after_realloc(void * arena, struct StatsSlot slot, void * new_ptr, size_t new_sz,
+                          size_t old_held, uint64_t start)
+{
+   if ( start != 0 )
+   {
+      record_latency(slot, now_ns() - start);
+   }
+
+   SLOT_ADD(slot, realloc_sizes[ bucket_of(new_sz, STATS_SIZE_BUCKETS) ], 1);
+   if ( NULL == new_ptr )
+   {
+      // The old block is left as it was
+      SLOT_ADD(slot, failures, 1);
+      return;
+   }
+   resize_live( ARENA_OF(arena), old_held, held_size(INNER_OF(arena), new_ptr, new_sz) );
+}
+
+/**
+ * @brief floor(log2(val)), capped to the last bucket (0 goes in bucket 0).
+ */
+static size_t bucket_of(uint64_t val, size_t num_buckets)
+{
+   size_t bucket = 0;
+#if defined(__GNUC__)
+   if ( val > 1 )
+   {
+      bucket = 63u - (size_t)__builtin_clzll(val);
+   }
+#else
+   while ( val > 1 )
+   {
+      val >>= 1;
+      bucket++;
+   }
+#endif
+   return (bucket < num_buckets) ? bucket : (num_buckets - 1);
+}
@@ -0,0 +1,400 @@
+/**
+ * @file alloc_tlheap.c
+ * @brief Implementation of the thread-local heap allocator.
+ *
+ * Each heap is a slab arena that only its owning thread ever touches, plus a
+ * lock-free stack that other threads push the blocks they free onto. Every
+ * block is prefixed with a small header naming its owning heap, since that is
+ * the one thing the size passed back in can't tell us.
+ *
+ * Heaps are never freed while the program runs (short of tlheap_destroy_all):
+ * a thread that exits leaves its heap marked abandoned, and the next thread in
+ * need of a heap claims it. So the global heap list only ever grows, and can be
+ * walked without a lock.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+#include "ccol_shared.h"
+#include "alloc_slab.h"
+#include "alloc_tlheap.h"
+
+#if defined(__GNUC__) && ( defined(__unix__) || defined(__APPLE__) )
+#include <pthread.h>
+#define TLHEAP_SUPPORTED
+#endif
+
+#if defined(TLHEAP_SUPPORTED)
+
+/* Local Macro Definitions */
+
+// Keeps payloads as aligned as the slab blocks (and malloc blocks) under them
+#define BLOCK_HEADER_SZ (16u)
+
+#define HEADER_OF(ptr)  ( (struct BlockHeader *)(void *)((uint8_t *)(ptr) - BLOCK_HEADER_SZ) )
+#define PAYLOAD_OF(hdr) ( (void *)((uint8_t *)(hdr) + BLOCK_HEADER_SZ) )
+
+#define LARGEST_SLAB_SZ ( (size_t)1 << SLAB_MAX_CLASS_SHIFT )
+
+/* Local Datatypes */
+
+/**
+ * @brief Prefix of every block handed out.
+ * @param link While the block is in use, the heap it came from. While it sits
+ *             on that heap's remote-free stack, the next block on the stack.
+ * @param sz   Size of the block as allocated from the slab, header included
+ */
+struct BlockHeader
+{
+   void * link;
+   size_t sz;
+};
+
+/**
+ * @param slab         Where the owning thread allocates from and frees to
+ * @param remote_frees Blocks freed by other threads, for the owner to take back
+ * @param abandoned    Set once the owning thread is done with the heap
+ * @param next         Next heap in AllHeaps
+ */
+struct TlHeap
+{
+   struct SlabArena slab;
+   struct BlockHeader * remote_frees;
+   bool abandoned;
+   struct TlHeap * next;
+};
+
+/* Private Function Prototypes */
+
+static struct TlHeap * this_thread_heap(void);
+static struct TlHeap * acquire_heap(void);
+static void abandon_heap(void * heap);
+static void drain_remote_frees(struct TlHeap * heap);
+static void push_remote_free(struct TlHeap * owner, struct BlockHeader * block);
+#if TLHEAP_AUTO_DETACH
+static void create_exit_key(void);
+#endif
+
+/* Private Variables */
+
+static __thread struct TlHeap * ThisThreadHeap = NULL;
+
+static struct TlHeap * AllHeaps = NULL;
+
+#if TLHEAP_AUTO_DETACH
+static pthread_once_t ExitKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t ExitKey;
+static bool ExitKeyCreated = false;
+#endif
+
+/* Public Function Definitions */
+
+void tlheap_thread_detach(void)
+{
+   struct TlHeap * heap = ThisThreadHeap;
+   if ( NULL == heap )
+   {
+      return;
+   }
+
+#if TLHEAP_AUTO_DETACH
+   if ( ExitKeyCreated )
+   {
+      (void)pthread_setspecific(ExitKey, NULL);
+   }
+#endif
+   ThisThreadHeap = NULL;
+   abandon_heap(heap);
+}
+
+void tlheap_destroy_all(void)
+{
+   tlheap_thread_detach();
+
+   struct TlHeap * heap = __atomic_exchange_n(&AllHeaps, NULL, __ATOMIC_ACQ_REL);
+   while ( heap != NULL )
+   {
+      struct TlHeap * next = heap->next;
+      slab_destroy(&heap->slab);
+      free(heap);
+      heap = next;
+   }
+}
+
+void * tlheap_alloc(size_t req_sz, void * arena)
+{
+   (void)arena;
+
+   if ( req_sz > (SIZE_MAX - BLOCK_HEADER_SZ) )
+   {
+      return NULL;
+   }
+
+   struct TlHeap * heap = this_thread_heap();
+   if ( NULL == heap )
+   {
+      return NULL;
+   }
+
+   // Blocks other threads gave back are the cheapest ones to hand out next
+   if ( __atomic_load_n(&heap->remote_frees, __ATOMIC_RELAXED) != NULL )
+   {
+      drain_remote_frees(heap);
+   }
+
+   size_t sz = req_sz + BLOCK_HEADER_SZ;
+   struct BlockHeader * block = slab_alloc(sz, &heap->slab);
+   if ( NULL == block )
+   {
+      return NULL;
+   }
+   block->link = heap;
+   block->sz = sz;
+   return PAYLOAD_OF(block);
+}
+
+void * tlheap_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   if ( NULL == old_ptr )
+   {
+      return tlheap_alloc(new_sz, arena);
+   }
+
+   if ( new_sz > (SIZE_MAX - BLOCK_HEADER_SZ) )
+   {
+      return NULL;
+   }
+
+   struct BlockHeader * block = HEADER_OF(old_ptr);
+   struct TlHeap * heap = this_thread_heap();
+   if ( (heap != NULL) && (block->link == heap) )
+   {
+      // The caller may have grown into the block's slack since it was
+      // allocated, in which case its size is the one that covers the contents.
+      if ( (old_sz + BLOCK_HEADER_SZ) > block->sz )
+      {
+         block->sz = old_sz + BLOCK_HEADER_SZ;
+      }
+
+      size_t sz = new_sz + BLOCK_HEADER_SZ;
+      struct BlockHeader * new_block = slab_realloc(block, sz, block->sz, &heap->slab);
+      if ( NULL == new_block )
+      {
+         return NULL;
+      }
+      new_block->link = heap;
+      new_block->sz = sz;
+      return PAYLOAD_OF(new_block);
+   }
+
+   // Someone else's block: move it into our heap, and give theirs back
+   void * new_ptr = tlheap_alloc(new_sz, arena);
+   if ( new_ptr != NULL )
+   {
+      memcpy( new_ptr, old_ptr, (old_sz < new_sz) ? old_sz : new_sz );
+      tlheap_reclaim(old_ptr, old_sz, arena);
+   }
+   return new_ptr;
+}
+
+void tlheap_reclaim(void * old_ptr, size_t old_sz, void * arena)
+{
+   (void)old_sz;
+   (void)arena;
+
+   if ( NULL == old_ptr )
+   {
+      return;
+   }
+
+   struct BlockHeader * block = HEADER_OF(old_ptr);
+   struct TlHeap * owner = block->link;
+   if ( owner == ThisThreadHeap )
+   {
+      slab_reclaim(block, block->sz, &owner->slab);
+   }
+   else if ( block->sz > LARGEST_SLAB_SZ )
+   {
+      // Came straight from malloc, which takes it back from any thread
+      free(block);
+   }
+   else
+   {
+      push_remote_free(owner, block);
+   }
+}
+
+bool tlheap_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   return new_sz <= tlheap_usable_size(ptr, old_sz, arena);
+}
+
+size_t tlheap_usable_size(void * ptr, size_t req_sz, void * arena)
+{
+   (void)req_sz;
+   (void)arena;
+
+   struct BlockHeader * block = HEADER_OF(ptr);
+   return slab_usable_size(block, block->sz, NULL) - BLOCK_HEADER_SZ;
+}
+
+/* Private Function Definitions */
+
+static struct TlHeap * this_thread_heap(void)
+{
+   if ( NULL == ThisThreadHeap )
+   {
+      ThisThreadHeap = acquire_heap();
+   }
+   return ThisThreadHeap;
+}
+
+/**
+ * @brief Claims an abandoned heap if there is one, or else sets up a new one.
+ */
+static struct TlHeap * acquire_heap(void)
+{
+   struct TlHeap * heap = __atomic_load_n(&AllHeaps, __ATOMIC_ACQUIRE);
+   while ( heap != NULL )
+   {
+      bool expected = true;
+      if ( __atomic_load_n(&heap->abandoned, __ATOMIC_RELAXED) &&
+           __atomic_compare_exchange_n( &heap->abandoned, &expected, false,
+                                        false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+      {
+         break;
+      }
+      heap = heap->next;
+   }
+
+   if ( NULL == heap )
+   {
+      heap = malloc(sizeof(struct TlHeap));
+      if ( NULL == heap )
+      {
+         // TODO: Throw exception
+         return NULL;
+      }
+      slab_init(&heap->slab);
+      heap->remote_frees = NULL;
+      heap->abandoned = false;
+
+      heap->next = __atomic_load_n(&AllHeaps, __ATOMIC_RELAXED);
+      while ( !__atomic_compare_exchange_n( &AllHeaps, &heap->next, heap,
+                                            true, __ATOMIC_RELEASE, __ATOMIC_RELAXED ) )
+      {
+         // heap->next was refreshed by the failed exchange; try again
+      }
+   }
+
+#if TLHEAP_AUTO_DETACH
+   (void)pthread_once(&ExitKeyOnce, create_exit_key);
+   if ( ExitKeyCreated )
+   {
+      (void)pthread_setspecific(ExitKey, heap);
+   }
+#endif
+
+   return heap;
+}
+
+/**
+ * @brief Takes back what other threads freed to the heap, and hands the heap
+ *        over to whichever thread claims it next.
+ * @note Also serves as the destructor of ExitKey, hence the void pointer.
+ */
+static void abandon_heap(void * heap)
+{
+   struct TlHeap * self = heap;
+   drain_remote_frees(self);
+   if ( ThisThreadHeap == self )
+   {
+      ThisThreadHeap = NULL;
+   }
+   __atomic_store_n(&self->abandoned, true, __ATOMIC_RELEASE);
+}
+
+static void drain_remote_frees(struct TlHeap * heap)
+{
+   struct BlockHeader * block = __atomic_exchange_n(&heap->remote_frees, NULL, __ATOMIC_ACQUIRE);
+   while ( block != NULL )
+   {
+      struct BlockHeader * next = block->link;
+      slab_reclaim(block, block->sz, &heap->slab);
+      block = next;
+   }
+}
+
+/**
+ * @brief Lock-free push onto the owner's remote-free stack.
+ * @note Since the owner only ever takes the whole stack at once, the ABA
+ *       problem of lock-free stacks can't arise.
+ */
+static void push_remote_free(struct TlHeap * owner, struct BlockHeader * block)
+{
+   struct BlockHeader * head = __atomic_load_n(&owner->remote_frees, __ATOMIC_RELAXED);
+   do
+   {
+      block->link = head;
+   } while ( !__atomic_compare_exchange_n( &owner->remote_frees, &head, block,
+                                           true, __ATOMIC_RELEASE, __ATOMIC_RELAXED ) );
+}
+
+#if TLHEAP_AUTO_DETACH
+static void create_exit_key(void)
+{
+   ExitKeyCreated = (0 == pthread_key_create(&ExitKey, abandon_heap));
+}
+#endif
+
+#else // !TLHEAP_SUPPORTED
+
+/* Public Function Definitions */
+
+// Without thread-local storage and atomics to build on, the best we can offer
+// is the system allocator, which is at least thread-safe.
+
+void tlheap_thread_detach(void)
+{
+}
+
+void tlheap_destroy_all(void)
+{
+}
+
+void * tlheap_alloc(size_t req_sz, void * arena)
+{
+   return default_alloc(req_sz, arena);
+}
+
+void * tlheap_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   return default_realloc(old_ptr, new_sz, old_sz, arena);
+}
+
+void tlheap_reclaim(void * old_ptr, size_t old_sz, void * arena)
+{
+   default_reclaim(old_ptr, old_sz, arena);
+}
+
+bool tlheap_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   return default_try_expand_in_place(ptr, new_sz, old_sz, arena);
+}
+
+size_t tlheap_usable_size(void * ptr, size_t req_sz, void * arena)
+{
+   return default_usable_size(ptr, req_sz, arena);
+}
+
+#endif // TLHEAP_SUPPORTED
@@ -0,0 +1,542 @@
+/**
+ * @file alloc_tlsf.c
+ * @brief Implementation of the Two-Level Segregated Fit allocator.
+ *
+ * Layout of the region: a sequence of physically adjacent blocks, each made up
+ * of a header followed by its payload, ending in a zero-sized "sentinel" block
+ * that is always marked as used so that the last real block never tries to
+ * merge past the end of the region. Every header records its block's payload
+ * size (with the low bit flagging a free block) and a pointer to the block
+ * physically before it, which is what makes merging with either neighbour O(1).
+ * Free blocks additionally thread their free list through their payload.
+ *
+ * @author Abdulla Almosalami (memphis242)
+ * @date Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "ccol_shared.h"
+#include "alloc_tlsf.h"
+
+/* Local Macro Definitions */
+
+#define ALIGN_LOG2      (4)
+#define FL_INDEX_SHIFT  ( TLSF_SL_LOG2 + ALIGN_LOG2 )
+#define SMALL_BLOCK_SZ  ( (size_t)1 << FL_INDEX_SHIFT )  // Below this, first level is 0 and second level is linear
+#define MAX_BLOCK_SZ    ( ((size_t)1 << TLSF_MAX_BLOCK_SHIFT) - TLSF_ALIGNMENT )
+
+#define ROUND_UP(sz)    ( ((sz) + (TLSF_ALIGNMENT - 1)) & ~(TLSF_ALIGNMENT - 1) )
+#define ROUND_DOWN(sz)  ( (sz) & ~(TLSF_ALIGNMENT - 1) )
+
+#define HDR_SZ          ROUND_UP( offsetof(struct TlsfBlock, next_free) )
+#define MIN_BLOCK_SZ    TLSF_ALIGNMENT
+
+#define BLOCK_FREE      ( (size_t)1 )
+
+/* Local Datatypes */
+
+/**
+ * @brief Header of a block. next_free and prev_free are only meaningful while
+ *        the block is free, and overlap the start of the payload otherwise.
+ */
+struct TlsfBlock
+{
+   struct TlsfBlock * prev_phys;
+   size_t size;
+   struct TlsfBlock * next_free;
+   struct TlsfBlock * prev_free;
+};
+
+/* Private Function Prototypes */
+
+static size_t block_size(const struct TlsfBlock * block);
+static bool   block_is_free(const struct TlsfBlock * block);
+static uint8_t * block_payload(const struct TlsfBlock * block);
+static struct TlsfBlock * block_from_payload(const void * ptr);
+static struct TlsfBlock * block_next(const struct TlsfBlock * block);
+
+static size_t adjust_size(size_t req_sz);
+static void   mapping_insert(size_t sz, size_t * fl, size_t * sl);
+static void   mapping_search(size_t sz, size_t * fl, size_t * sl);
+static struct TlsfBlock * find_suitable(const struct TlsfArena * self, size_t * fl, size_t * sl);
+
+static void   clear_free_lists(struct TlsfArena * self);
+static void   insert_free(struct TlsfArena * self, struct TlsfBlock * block);
+static void   remove_free(struct TlsfArena * self, struct TlsfBlock * block);
+static void   merge_next(struct TlsfArena * self, struct TlsfBlock * block);
+static struct TlsfBlock * merge_prev(struct TlsfArena * self, struct TlsfBlock * block);
+static void   trim(struct TlsfArena * self, struct TlsfBlock * block, size_t sz);
+static bool   grow_in_place(struct TlsfArena * self, struct TlsfBlock * block, size_t sz);
+
+static size_t lowest_bit(uint32_t bits);
+static size_t highest_bit(size_t bits);
+
+/* Public Function Definitions */
+
+void tlsf_init(void * arena)
+{
+   assert(arena != NULL);
+   assert(sizeof(struct TlsfBlock) <= (HDR_SZ + MIN_BLOCK_SZ));
+
+   struct TlsfArena * self = arena;
+   if ( self->initialized )
+   {
+      return;
+   }
+   self->initialized = true;
+   clear_free_lists(self);
+
+   if ( NULL == self->region )
+   {
+      return;
+   }
+
+   uintptr_t start = ROUND_UP( (uintptr_t)self->region );
+   uintptr_t end = (uintptr_t)self->region + self->region_sz;
+   if ( (start > end) || ((end - start) < ((2 * HDR_SZ) + MIN_BLOCK_SZ)) )
+   {
+      // TODO: Throw exception that the region is too small
+      return;
+   }
+
+   // Room for one big free block, plus the header of the sentinel
+   size_t avail = ROUND_DOWN( (size_t)(end - start) - (2 * HDR_SZ) );
+   if ( avail > MAX_BLOCK_SZ )
+   {
+      avail = MAX_BLOCK_SZ;
+   }
+
+   struct TlsfBlock * block = (struct TlsfBlock *)(void *)( self->region + (start - (uintptr_t)self->region) );
+   block->prev_phys = NULL;
+   block->size = avail | BLOCK_FREE;
+
+   struct TlsfBlock * sentinel = block_next(block);
+   sentinel->prev_phys = block;
+   sentinel->size = 0;
+
+   insert_free(self, block);
+}
+
+void tlsf_deinit(void * arena)
+{
+   assert(arena != NULL);
+
+   struct TlsfArena * self = arena;
+   clear_free_lists(self);
+   self->initialized = false;
+}
+
+void tlsf_reset(void * arena)
+{
+   tlsf_deinit(arena);
+   tlsf_init(arena);
+}
+
+size_t tlsf_free_bytes(const struct TlsfArena * arena)
+{
+   assert(arena != NULL);
+
+   size_t total = 0;
+   for ( size_t i = 0; i < TLSF_FL_COUNT; i++ )
+   {
+      for ( size_t j = 0; j < TLSF_SL_COUNT; j++ )
+      {
+         for ( const struct TlsfBlock * block = arena->free_lists[i][j];
+               block != NULL;
+               block = block->next_free )
+         {
+            total += block_size(block);
+         }
+      }
+   }
+   return total;
+}
+
+void * tlsf_alloc(size_t req_sz, void * arena)
+{
+   assert(arena != NULL);
+
+   struct TlsfArena * self = arena;
+   if ( req_sz > MAX_BLOCK_SZ )
+   {
+      return NULL;
+   }
+
+   size_t sz = adjust_size(req_sz);
+   size_t fl, sl;
+   mapping_search(sz, &fl, &sl);
+   struct TlsfBlock * block = find_suitable(self, &fl, &sl);
+   if ( NULL == block )
+   {
+      return NULL;
+   }
+
+   remove_free(self, block);
+   block->size &= ~BLOCK_FREE;
+   trim(self, block, sz);
+
+   return block_payload(block);
+}
+
+void * tlsf_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   assert(arena != NULL);
+
+   if ( NULL == old_ptr )
+   {
+      return tlsf_alloc(new_sz, arena);
+   }
+   if ( new_sz > MAX_BLOCK_SZ )
+   {
+      return NULL;
+   }
+
+   struct TlsfArena * self = arena;
+   struct TlsfBlock * block = block_from_payload(old_ptr);
+   size_t sz = adjust_size(new_sz);
+   size_t cur_sz = block_size(block);
+
+   if ( sz <= cur_sz )
+   {
+      trim(self, block, sz);
+      return old_ptr;
+   }
+
+   if ( grow_in_place(self, block, sz) )
+   {
+      return old_ptr;
+   }
+
+   void * new_ptr = tlsf_alloc(new_sz, arena);
+   if ( new_ptr != NULL )
+   {
+      memcpy( new_ptr, old_ptr, (old_sz < cur_sz) ? old_sz : cur_sz );
+      tlsf_reclaim(old_ptr, old_sz, arena);
+   }
+   return new_ptr;
+}
+
+void tlsf_reclaim(void * old_ptr, size_t old_sz, void * arena)
+{
+   assert(arena != NULL);
+   (void)old_sz;
+
+   if ( NULL == old_ptr )
+   {
+      return;
+   }
+
+   struct TlsfArena * self = arena;
+   struct TlsfBlock * block = block_from_payload(old_ptr);
+   assert( !block_is_free(block) );
+
+   block->size |= BLOCK_FREE;
+   block = merge_prev(self, block);
+   merge_next(self, block);
+   insert_free(self, block);
+}
+
+bool tlsf_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   assert(arena != NULL);
+   (void)old_sz;
+
+   if ( (NULL == ptr) || (new_sz > MAX_BLOCK_SZ) )
+   {
+      return false;
+   }
+
+   struct TlsfBlock * block = block_from_payload(ptr);
+   size_t sz = adjust_size(new_sz);
+   if ( sz <= block_size(block) )
+   {
+      return true;
+   }
+   return grow_in_place(arena, block, sz);
+}
+
+size_t tlsf_usable_size(void * ptr, size_t req_sz, void * arena)
+{
+   (void)arena;
+
+   if ( NULL == ptr )
+   {
+      return req_sz;
+   }
+   return block_size( block_from_payload(ptr) );
+}
+
+/* Private Function Definitions */
+
+static size_t block_size(const struct TlsfBlock * block)
+{
+   return block->size & ~BLOCK_FREE;
+}
+
+static bool block_is_free(const struct TlsfBlock * block)
+{
+   return (block->size & BLOCK_FREE) != 0;
+}
+
+static uint8_t * block_payload(const struct TlsfBlock * block)
+{
+   return (uint8_t *)block + HDR_SZ;
+}
+
+static struct TlsfBlock * block_from_payload(const void * ptr)
+{
+   return (struct TlsfBlock *)(void *)( (uint8_t *)ptr - HDR_SZ );
+}
+
+/**
+ * @brief Block physically after the given one (never called on the sentinel).
+ */
+static struct TlsfBlock * block_next(const struct TlsfBlock * block)
+{
+   return (struct TlsfBlock *)(void *)( block_payload(block) + block_size(block) );
+}
+
+/**
+ * @brief Payload size of the block that will serve a request of req_sz bytes.
+ */
+static size_t adjust_size(size_t req_sz)
+{
+   size_t sz = ROUND_UP(req_sz);
+   return (sz < MIN_BLOCK_SZ) ? MIN_BLOCK_SZ : sz;
+}
+
+/**
+ * @brief Free list that a free block of sz bytes belongs in.
+ */
+static void mapping_insert(size_t sz, size_t * fl, size_t * sl)
+{
+   if ( sz < SMALL_BLOCK_SZ )
+   {
+      *fl = 0;
+      *sl = sz / (SMALL_BLOCK_SZ / TLSF_SL_COUNT);
+   }
+   else
+   {
+      size_t msb = highest_bit(sz);
+      *sl = (sz >> (msb - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+      *fl = msb - (FL_INDEX_SHIFT - 1);
+   }
+}
+
+/**
+ * @brief First free list whose blocks are _all_ large enough for sz bytes.
+ *
+ * Rounding sz up to the start of the next list is what avoids having to walk a
+ * list looking for a block that fits (good fit rather than best fit).
+ */
+static void mapping_search(size_t sz, size_t * fl, size_t * sl)
+{
+   if ( sz >= SMALL_BLOCK_SZ )
+   {
+      sz += ((size_t)1 << (highest_bit(sz) - TLSF_SL_LOG2)) - 1;
+   }
+   mapping_insert(sz, fl, sl);
+}
+
+/**
+ * @brief Head of the first non-empty free list at or above (fl, sl), updating
+ *        fl and sl to that list. NULL if there is none.
+ */
+static struct TlsfBlock * find_suitable(const struct TlsfArena * self, size_t * fl, size_t * sl)
+{
+   if ( *fl >= TLSF_FL_COUNT )
+   {
+      return NULL;
+   }
+
+   uint32_t sl_map = self->sl_bitmap[*fl] & (uint32_t)(UINT32_MAX << *sl);
+   if ( 0 == sl_map )
+   {
+      uint32_t fl_map = self->fl_bitmap & (uint32_t)(UINT32_MAX << (*fl + 1));
+      if ( 0 == fl_map )
+      {
+         return NULL;
+      }
+      *fl = lowest_bit(fl_map);
+      sl_map = self->sl_bitmap[*fl];
+   }
+   *sl = lowest_bit(sl_map);
+
+   return self->free_lists[*fl][*sl];
+}
+
+static void clear_free_lists(struct TlsfArena * self)
+{
+   self->fl_bitmap = 0;
+   for ( size_t i = 0; i < TLSF_FL_COUNT; i++ )
+   {
+      self->sl_bitmap[i] = 0;
+      for ( size_t j = 0; j < TLSF_SL_COUNT; j++ )
+      {
+         self->free_lists[i][j] = NULL;
+      }
+   }
+}
+
+static void insert_free(struct TlsfArena * self, struct TlsfBlock * block)
+{
+   size_t fl, sl;
+   mapping_insert(block_size(block), &fl, &sl);
+
+   struct TlsfBlock * head = self->free_lists[fl][sl];
+   block->next_free = head;
+   block->prev_free = NULL;
+   if ( head != NULL )
+   {
+      head->prev_free = block;
+   }
+   self->free_lists[fl][sl] = block;
+
+   self->fl_bitmap |= (uint32_t)1 << fl;
+   self->sl_bitmap[fl] |= (uint32_t)1 << sl;
+}
+
+static void remove_free(struct TlsfArena * self, struct TlsfBlock * block)
+{
+   size_t fl, sl;
+   mapping_insert(block_size(block), &fl, &sl);
+
+   if ( block->next_free != NULL )
+   {
+      block->next_free->prev_free = block->prev_free;
+   }
+   if ( block->prev_free != NULL )
+   {
+      block->prev_free->next_free = block->next_free;
+   }
+   else
+   {
+      self->free_lists[fl][sl] = block->next_free;
+      if ( NULL == block->next_free )
+      {
+         self->sl_bitmap[fl] &= ~((uint32_t)1 << sl);
+         if ( 0 == self->sl_bitmap[fl] )
+         {
+            self->fl_bitmap &= ~((uint32_t)1 << fl);
+         }
+      }
+   }
+}
+
+/**
+ * @brief Absorbs the next physical block into this one if it's free.
+ */
+static void merge_next(struct TlsfArena * self, struct TlsfBlock * block)
+{
+   struct TlsfBlock * next = block_next(block);
+   if ( block_is_free(next) )
+   {
+      remove_free(self, next);
+      block->size += HDR_SZ + block_size(next);
+      block_next(block)->prev_phys = block;
+   }
+}
+
+/**
+ * @brief Absorbs this block into the previous physical block if that one is
+ *        free, returning whichever block now starts the merged range.
+ */
+static struct TlsfBlock * merge_prev(struct TlsfArena * self, struct TlsfBlock * block)
+{
+   struct TlsfBlock * prev = block->prev_phys;
+   if ( (prev != NULL) && block_is_free(prev) )
+   {
+      remove_free(self, prev);
+      prev->size += HDR_SZ + block_size(block);
+      block_next(prev)->prev_phys = prev;
+      return prev;
+   }
+   return block;
+}
+
+/**
+ * @brief Shrinks a used block to sz bytes, giving the tail back as a free block
+ *        if it's large enough to be one.
+ */
+static void trim(struct TlsfArena * self, struct TlsfBlock * block, size_t sz)
+{
+   assert( !block_is_free(block) && (sz <= block_size(block)) );
+
+   size_t excess = block_size(block) - sz;
+   if ( excess < (HDR_SZ + MIN_BLOCK_SZ) )
+   {
+      return;
+   }
+
+   block->size = sz;
+   struct TlsfBlock * rest = block_next(block);
+   rest->prev_phys = block;
+   rest->size = (excess - HDR_SZ) | BLOCK_FREE;
+   block_next(rest)->prev_phys = rest;
+
+   merge_next(self, rest);
+   insert_free(self, rest);
+}
+
+/**
+ * @brief Grows a used block to (at least) sz bytes by absorbing the next
+ *        physical block, if that one is free and large enough.
+ */
+static bool grow_in_place(struct TlsfArena * self, struct TlsfBlock * block, size_t sz)
+{
+   struct TlsfBlock * next = block_next(block);
+   if ( !block_is_free(next) || ((block_size(block) + HDR_SZ + block_size(next)) < sz) )
+   {
+      return false;
+   }
+
+   merge_next(self, block);
+   trim(self, block, sz);
+   return true;
+}
+
+/**
+ * @brief Index of the lowest set bit (bits must be non-zero).
+ */
+static size_t lowest_bit(uint32_t bits)
+{
+   assert(bits != 0);
+#if defined(__GNUC__)
+   return (size_t)__builtin_ctzl( (unsigned long)bits );
+#else
+   size_t idx = 0;
+   while ( 0 == (bits & 1u) )
+   {
+      bits >>= 1;
+      idx++;
+   }
+   return idx;
+#endif
+}
+
+/**
+ * @brief Index of the highest set bit (bits must be non-zero).
+ */
+static size_t highest_bit(size_t bits)
+{
+   assert(bits != 0);
+#if defined(__GNUC__)
+   return ((sizeof(unsigned long long) * CHAR_BIT) - 1) -
+          (size_t)__builtin_clzll( (unsigned long long)bits );
+#else
+   size_t idx = 0;
+   while ( bits >>= 1 )
+   {
+      idx++;
+   }
+   return idx;
+#endif
+}
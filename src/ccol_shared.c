@@ -7,18 +7,116 @@
  * @copyright MIT License
  */
 
+#if defined(__linux__)
+#define _GNU_SOURCE // MAP_ANONYMOUS, MAP_NORESERVE
+#endif
+
 /* File Inclusions */
 #include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define CCOL_VM_POSIX
+#elif defined(_WIN32)
+#include <windows.h>
+#define CCOL_VM_WIN32
+#endif
 #include "ccol_shared.h"
 
+/* Local Macro Definitions */
+
+#if defined(CCOL_VM_POSIX) && !defined(MAP_NORESERVE)
+#define MAP_NORESERVE 0
+#endif
+
+// Fallback for platforms we can't ask
+#define CCOL_DEFAULT_PAGE_SIZE 4096
+
 /* Public Function Definitions */
 
+bool AllocatorInit(struct Allocator * self)
+{
+   if ( (NULL == self) ||
+        (NULL == self->alloc) || (NULL == self->realloc) || (NULL == self->reclaim) )
+   {
+      // TODO: Throw exception for an incomplete allocator
+      return false;
+   }
+
+   if ( self->refs > 0 )
+   {
+      // TODO: Throw exception for initializing an allocator twice
+      return false;
+   }
+
+   if ( self->alloca_init != NULL )
+   {
+      self->alloca_init( self->arena );
+   }
+   self->refs = 1;
+   return true;
+}
+
+bool AllocatorRetain(struct Allocator * self)
+{
+   if ( !AllocatorIsManaged(self) )
+   {
+      return false;
+   }
+
+#if defined(__GNUC__)
+   (void)__atomic_add_fetch(&self->refs, 1, __ATOMIC_RELAXED);
+#else
+   self->refs++;
+#endif
+   return true;
+}
+
+void AllocatorRelease(struct Allocator * self)
+{
+   if ( !AllocatorIsManaged(self) )
+   {
+      return;
+   }
+
+#if defined(__GNUC__)
+   // Vectors sharing an allocator may be freed from different threads
+   size_t refs = __atomic_sub_fetch(&self->refs, 1, __ATOMIC_ACQ_REL);
+#else
+   size_t refs = --self->refs;
+#endif
+   if ( (0 == refs) && (self->alloca_deinit != NULL) )
+   {
+      self->alloca_deinit( self->arena );
+   }
+}
+
+bool AllocatorIsManaged(const struct Allocator * self)
+{
+   return (self != NULL) && (self->refs > 0);
+}
+
 void * default_alloc(size_t req_sz, void * arena)
 {
    (void)arena;
    return malloc(req_sz);
 }
 
+void * default_alloc_zeroed(size_t req_sz, void * arena)
+{
+   (void)arena;
+   // calloc is preferred over malloc + memset because large requests are
+   // typically serviced straight from the OS as fresh (already zero) pages, in
+   // which case the libc skips the memset and pages only get faulted in once
+   // they are actually touched.
+   return calloc(1, req_sz);
+}
+
 void * default_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * arena)
 {
    (void)old_sz;
@@ -32,3 +130,161 @@ void default_reclaim(void * old_ptr, size_t old_sz, void * arena)
    (void)arena;
    free(old_ptr);
 }
+
+bool default_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * arena)
+{
+   // The stdlib has no way to grow a block without potentially moving it, but
+   // we can at least tell when the block malloc handed back is already big
+   // enough.
+   return new_sz <= default_usable_size(ptr, old_sz, arena);
+}
+
+size_t default_usable_size(void * ptr, size_t req_sz, void * arena)
+{
+   (void)arena;
+#if defined(__GLIBC__)
+   (void)req_sz;
+   return malloc_usable_size(ptr);
+#else
+   // No portable way to ask, so all we know for sure is what was requested
+   (void)ptr;
+   return req_sz;
+#endif
+}
+
+void * default_alloc_aligned(size_t req_sz, size_t alignment, void * arena)
+{
+   (void)arena;
+   assert( (alignment & (alignment - 1)) == 0 );
+#if defined(CCOL_VM_POSIX)
+   // posix_memalign'd blocks can be handed to free(), and so to default_reclaim
+   if ( alignment < sizeof(void *) )
+   {
+      alignment = sizeof(void *);
+   }
+   void * ptr = NULL;
+   return (0 == posix_memalign(&ptr, alignment, req_sz)) ? ptr : NULL;
+#else
+   // Nothing in C99 hands out aligned blocks that free() can take back
+   (void)req_sz;
+   (void)alignment;
+   return NULL;
+#endif
+}
+
+void * default_realloc_aligned(void * old_ptr, size_t new_sz, size_t old_sz, size_t alignment, void * arena)
+{
+   // realloc only promises malloc's own alignment, and if it moves the block
+   // somewhere misaligned, the original is already gone by the time we'd find
+   // out. So move it ourselves. Growth that fits in the block's slack never
+   // makes it here anyways (see default_try_expand_in_place).
+   void * new_ptr = default_alloc_aligned(new_sz, alignment, arena);
+   if ( (new_ptr != NULL) && (old_ptr != NULL) )
+   {
+      memcpy( new_ptr, old_ptr, (old_sz < new_sz) ? old_sz : new_sz );
+      free(old_ptr);
+   }
+   return new_ptr;
+}
+
+size_t ccol_page_size(void)
+{
+   static size_t page_sz = 0;
+   if ( 0 == page_sz )
+   {
+#if defined(CCOL_VM_POSIX)
+      long sz = sysconf(_SC_PAGESIZE);
+      page_sz = (sz > 0) ? (size_t)sz : CCOL_DEFAULT_PAGE_SIZE;
+#elif defined(CCOL_VM_WIN32)
+      SYSTEM_INFO info;
+      GetSystemInfo(&info);
+      page_sz = (size_t)info.dwPageSize;
+#else
+      page_sz = CCOL_DEFAULT_PAGE_SIZE;
+#endif
+   }
+   return page_sz;
+}
+
+size_t ccol_page_round(size_t sz)
+{
+   size_t page_sz = ccol_page_size();
+   return (sz + (page_sz - 1)) & ~(page_sz - 1);
+}
+
+void * ccol_vm_reserve(size_t sz)
+{
+#if defined(CCOL_VM_POSIX)
+   void * ptr = mmap( NULL, ccol_page_round(sz), PROT_NONE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+   return (MAP_FAILED == ptr) ? NULL : ptr;
+#elif defined(CCOL_VM_WIN32)
+   return VirtualAlloc( NULL, ccol_page_round(sz), MEM_RESERVE, PAGE_NOACCESS );
+#else
+   (void)sz;
+   return NULL;
+#endif
+}
+
+bool ccol_vm_commit(void * ptr, size_t sz)
+{
+   assert( ((uintptr_t)ptr & (ccol_page_size() - 1)) == 0 );
+#if defined(CCOL_VM_POSIX)
+   return 0 == mprotect( ptr, ccol_page_round(sz), PROT_READ | PROT_WRITE );
+#elif defined(CCOL_VM_WIN32)
+   return VirtualAlloc( ptr, ccol_page_round(sz), MEM_COMMIT, PAGE_READWRITE ) != NULL;
+#else
+   (void)ptr;
+   (void)sz;
+   return false;
+#endif
+}
+
+void ccol_vm_release(void * ptr, size_t sz)
+{
+   if ( NULL == ptr )
+   {
+      return;
+   }
+#if defined(CCOL_VM_POSIX)
+   int rc = munmap( ptr, ccol_page_round(sz) );
+   assert(0 == rc);
+   (void)rc;
+#elif defined(CCOL_VM_WIN32)
+   (void)sz;
+   (void)VirtualFree( ptr, 0, MEM_RELEASE );
+#else
+   (void)ptr;
+   (void)sz;
+#endif
+}
+
+bool ccol_vm_lock(void * ptr, size_t sz)
+{
+   // Page-align the range ourselves, as not every platform does it for us
+   uintptr_t start = (uintptr_t)ptr & ~(uintptr_t)(ccol_page_size() - 1);
+   size_t len = ccol_page_round( sz + (size_t)((uintptr_t)ptr - start) );
+#if defined(CCOL_VM_POSIX)
+   return 0 == mlock( (void *)start, len );
+#elif defined(CCOL_VM_WIN32)
+   return VirtualLock( (void *)start, len ) != 0;
+#else
+   (void)start;
+   (void)len;
+   return false;
+#endif
+}
+
+void ccol_vm_unlock(void * ptr, size_t sz)
+{
+   uintptr_t start = (uintptr_t)ptr & ~(uintptr_t)(ccol_page_size() - 1);
+   size_t len = ccol_page_round( sz + (size_t)((uintptr_t)ptr - start) );
+#if defined(CCOL_VM_POSIX)
+   (void)munlock( (void *)start, len );
+#elif defined(CCOL_VM_WIN32)
+   (void)VirtualUnlock( (void *)start, len );
+#else
+   (void)start;
+   (void)len;
+#endif
+}
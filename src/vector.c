@@ -19,6 +19,10 @@
 #include <stdint.h>
 #include <assert.h>
 #include <limits.h>
+#include <stdio.h>
+#ifdef CCOL_USDT
+#include <sys/sdt.h>
+#endif
 
 #include "ccol_shared.h"
 #include "vector_cfg.h"
@@ -58,15 +62,99 @@
 #define IS_EMPTY(self) ( 0 == (self)->len )
 #define PTR_TO_IDX(vec, idx) ( (uint8_t *)((vec)->arr) + ((vec)->element_size * (idx)) )
 
+#ifdef VEC_COMPACT_HEADER
+#define MEM_MGR(vec) ( (vec)->mem_mgr )
+#else
+#define MEM_MGR(vec) ( &(vec)->mem_mgr )
+#endif
+
+#ifdef CCOL_STATS
+#define VEC_STAT(vec, stat, n)   vec_stat( (vec), (stat), (uint64_t)(n) )
+#define VEC_STATS_CLEAR(vec)     memset( (vec)->stats, 0, sizeof((vec)->stats) )
+#else
+#define VEC_STAT(vec, stat, n)   ( (void)0 )
+#define VEC_STATS_CLEAR(vec)     ( (void)0 )
+#endif
+
+// Records a call in the trace, if one is being recorded (see VectorTraceStart).
+// Calls made from within another recorded call are wrapped in VEC_TRACE_NESTED,
+// since replaying the outer call makes them again.
+#ifdef CCOL_TRACE
+#define VEC_TRACE(op, vec, a, b, c, d) \
+   vec_trace( VectorTraceOp_##op, (vec), (uint64_t)(a), (uint64_t)(b), (uint64_t)(c), (uint64_t)(d) )
+#define VEC_TRACE_NEW(vec, a, b, c, d, attr) \
+   vec_trace_new( (vec), (uint64_t)(a), (uint64_t)(b), (uint64_t)(c), (uint64_t)(d), (attr) )
+#define VEC_TRACE_HANDLE(vec)    vec_trace_handle(vec)
+#define VEC_TRACE_NESTED(call)   do { vec_trace_nest(true); call; vec_trace_nest(false); } while (0)
+#else
+#define VEC_TRACE(op, vec, a, b, c, d)   ( (void)0 )
+#define VEC_TRACE_NEW(vec, a, b, c, d, attr)   ( (void)0 )
+#define VEC_TRACE_HANDLE(vec)            (0u)
+#define VEC_TRACE_NESTED(call)           call
+#endif
+
+// USDT probes, all under the ccol provider (e.g., usdt:<binary>:ccol:vec_expand)
+#ifdef CCOL_USDT
+#define VEC_PROBE1(name, a)          STAP_PROBE1(ccol, name, a)
+#define VEC_PROBE2(name, a, b)       STAP_PROBE2(ccol, name, a, b)
+#define VEC_PROBE4(name, a, b, c, d) STAP_PROBE4(ccol, name, a, b, c, d)
+#else
+#define VEC_PROBE1(name, a)          ( (void)0 )
+#define VEC_PROBE2(name, a, b)       ( (void)0 )
+#define VEC_PROBE4(name, a, b, c, d) ( (void)0 )
+#endif
+
 /* Local Datatypes */
+
+// Lengths and capacities (in elements)
+#if defined(VEC_COMPACT_HEADER) && (MAX_VEC_LEN <= UINT32_MAX)
+typedef uint32_t vec_len_t;
+#else
+typedef size_t vec_len_t;
+#endif
+
+// Operation counters (see struct VectorStats), in the same order
+enum VecStat
+{
+   VecStat_Pushes,
+   VecStat_Inserts,
+   VecStat_Removes,
+   VecStat_Expansions,
+   VecStat_ShiftBytes,
+   VecStat_CopyBytes,
+   VecStat_PerVector, // Those above are also counted per vector
+   VecStat_PoolExhausted = VecStat_PerVector,
+   VecStat_Count
+};
+
 struct Vector
 {
+   // What nearly every operation touches comes first (within 32 bytes)
    void * arr;
+   vec_len_t len;
+   vec_len_t capacity;
    size_t element_size;
-   size_t len;
-   size_t capacity;
-   size_t max_capacity;
+
+   vec_len_t max_capacity;
+   uint8_t flags; // enum VecFlag
+   uint32_t rt_violations; // Ops a realtime vector refused (saturates)
+   size_t alignment; // 0 for whatever the allocator gives by default
+#ifdef VEC_COMPACT_HEADER
+   struct Allocator * mem_mgr; // Managed allocator, or a copy shared through MemMgrTable
+#else
    struct Allocator mem_mgr;
+   struct Allocator * mem_mgr_ref; // Managed allocator we hold a reference to (NULL if unmanaged)
+#endif
+#ifdef CCOL_STATS
+   uint64_t stats[VecStat_PerVector]; // Indexed by enum VecStat
+#endif
+};
+
+enum VecFlag
+{
+   VecFlag_StableAddresses = 0x01u, // arr is a reservation of max_capacity elements
+   VecFlag_Realtime        = 0x02u, // arr holds max_capacity elements, prefaulted
+   VecFlag_Locked          = 0x04u, // arr is locked into RAM
 };
 
 enum ShiftDir
@@ -81,10 +169,40 @@ enum ShiftDir
 static struct Vector * vec_pool_dispatch(void);
 static void            vec_pool_reclaim(const struct Vector *);
 static bool            vec_isalloc(const struct Vector *);
+static size_t          vec_pool_live(struct Vector **);
+static bool            mem_mgr_same(const struct Allocator *, const struct Allocator *);
+#ifdef VEC_COMPACT_HEADER
+static struct Allocator * mem_mgr_share(const struct Allocator *);
+static void               mem_mgr_unshare(struct Allocator *);
+#endif
 
+static struct Vector * vec_new( size_t, size_t, size_t, size_t,
+                                const struct Allocator *,
+                                const struct VectorAttr *, bool );
+static const struct Allocator * vec_allocator(const struct Vector *);
+static bool vec_uses_mem_mgr(const struct Vector *, const struct Allocator *);
+static bool vec_attach_mem_mgr(struct Vector *, const struct Allocator *, bool);
+static void vec_detach_mem_mgr(struct Vector *);
+static void * vec_alloc(const struct Vector *, size_t);
+static void vec_release_arr(struct Vector *);
 static bool vec_expand(struct Vector *);
 static bool vec_expandby(struct Vector *, size_t);
+static bool vec_grow(struct Vector *, size_t, size_t);
+static bool vec_stable_commit(struct Vector *, size_t);
+static bool vec_rt_prepare(struct Vector *, bool);
+static void vec_rt_violation(struct Vector *);
+static bool vec_recycle_put(struct Vector *);
+static bool vec_recycle_take(struct Vector *, size_t, size_t);
 static void shiftn( struct Vector *, size_t, enum ShiftDir, size_t);
+#ifdef CCOL_STATS
+static void vec_stat(const struct Vector *, enum VecStat, uint64_t);
+#endif
+#ifdef CCOL_TRACE
+static void     vec_trace(enum VectorTraceOp, const struct Vector *, uint64_t, uint64_t, uint64_t, uint64_t);
+static void     vec_trace_new(const struct Vector *, uint64_t, uint64_t, uint64_t, uint64_t, const struct VectorAttr *);
+static uint64_t vec_trace_handle(const struct Vector *);
+static void     vec_trace_nest(bool);
+#endif
 
 /* Public API Implementations */
 
@@ -95,98 +213,93 @@ struct Vector * VectorNew( size_t element_size,
                            size_t initial_len,
                            const struct Allocator * mem_mgr )
 {
-   // Invalid inputs
-   if ( (0 == element_size) ||
-        (initial_capacity > MAX_VEC_LEN) ||
-        (0 == max_capacity) ||
-        (initial_capacity > max_capacity) ||
-        (initial_len > initial_capacity) )
-   {
-      // TODO: Vector constructor exception
-      return NULL;
-   }
+   struct Vector * vec = vec_new( element_size, initial_capacity, max_capacity,
+                                  initial_len, mem_mgr, NULL, true );
+   VEC_TRACE( New, vec, element_size, initial_capacity, max_capacity, initial_len );
+   return vec;
+}
 
-   struct Vector * new_vec = vec_pool_dispatch();
-   if ( NULL == new_vec )
-   {
-      return NULL;
-   }
+/******************************************************************************/
+struct Vector * VectorNewWithAttr( size_t element_size,
+                                   size_t initial_capacity,
+                                   size_t max_capacity,
+                                   size_t initial_len,
+                                   const struct Allocator * mem_mgr,
+                                   const struct VectorAttr * attr )
+{
+   struct Vector * vec = vec_new( element_size, initial_capacity, max_capacity,
+                                  initial_len, mem_mgr, attr, true );
+   VEC_TRACE_NEW( vec, element_size, initial_capacity, max_capacity, initial_len, attr );
+   return vec;
+}
 
-   if ( (NULL == mem_mgr) ||
-        (NULL == mem_mgr->alloc) || (NULL == mem_mgr->realloc) || (NULL == mem_mgr->reclaim) )
-   {
-      // TODO: Throw exception if user passed in a partially complete memory manager
-      new_vec->mem_mgr = DEFAULT_ALLOCATOR;
-   }
-   else
+/******************************************************************************/
+void VectorFree( struct Vector * self )
+{
+   if ( (self != NULL) && vec_isalloc(self) )
    {
-      new_vec->mem_mgr = *mem_mgr;
+      VEC_TRACE( Free, self, 0, 0, 0, 0 );
+      VEC_PROBE4( vector_free, self, (size_t)self->len, (size_t)self->capacity, self->element_size );
+      if ( !vec_recycle_put(self) )
+      {
+         vec_release_arr(self);
+      }
+      // After the array is given back, since dropping the last reference to
+      // the allocator may tear down its arena
+      vec_detach_mem_mgr(self);
+      vec_pool_reclaim(self);
    }
+}
 
-   if ( new_vec->mem_mgr.alloca_init != NULL )
+/******************************************************************************/
+size_t VectorFreeAllWith( const struct Allocator * mem_mgr )
+{
+   if ( NULL == mem_mgr )
    {
-      // The arena pointer may be NULL, but I won't let that stop me from calling
-      // the allocator's init fcn, because it may not need it.
-      new_vec->mem_mgr.alloca_init( new_vec->mem_mgr.arena );
+      return 0;
    }
 
-   if ( 0 == initial_capacity )
-   {
-      new_vec->arr = NULL;
-   }
-   else
-   {
-      new_vec->arr = new_vec->mem_mgr.alloc( element_size * initial_capacity,
-                                             new_vec->mem_mgr.arena );
-   }
+   struct Vector * live[VEC_STRUCT_POOL_SIZE];
+   size_t n_live = vec_pool_live(live);
+   bool resetting = (mem_mgr->reset != NULL);
 
-   // If we failed to allocate space for the array...
-   if ( (initial_capacity > 0) && (NULL == new_vec->arr) )
-   {
-      // TODO: Throw exception to inform user...
-      new_vec->capacity = 0;
-      new_vec->len = 0;
-   }
-   else
+   size_t n = 0;
+   for ( size_t i = 0; i < n_live; i++ )
    {
-      new_vec->capacity = initial_capacity;
-      if ( initial_len > 0 )
+      struct Vector * vec = live[i];
+      if ( !vec_uses_mem_mgr(vec, mem_mgr) )
       {
-         memset( new_vec->arr, 0, (element_size * initial_len) );
-         new_vec->len = initial_len;
+         continue;
       }
-      else
+      live[n++] = vec;
+      VEC_TRACE( Free, vec, 0, 0, 0, 0 );
+
+      if ( (vec->arr != NULL) && (vec->flags & VecFlag_Locked) )
       {
-         new_vec->len = 0;
+         ccol_vm_unlock( vec->arr, vec->capacity * vec->element_size );
+      }
+      vec->flags &= (uint8_t)~VecFlag_Locked;
+      // Stable arrays are reservations of our own, which no reset covers
+      if ( !resetting || (vec->flags & VecFlag_StableAddresses) )
+      {
+         vec_release_arr(vec);
       }
+      vec->arr = NULL;
    }
 
-   new_vec->element_size = element_size;
-
-   if ( max_capacity > MAX_VEC_LEN )
-   {
-      // TODO: Throw exception for max_capacity too large
-      new_vec->max_capacity = MAX_VEC_LEN;
-   }
-   else
+   if ( resetting )
    {
-      new_vec->max_capacity = max_capacity;
+      // Before the references go, since dropping the last one may tear the
+      // arena down
+      mem_mgr->reset( mem_mgr->arena );
    }
 
-   return new_vec;
-}
-
-/******************************************************************************/
-void VectorFree( struct Vector * self )
-{
-   if ( (self != NULL) && vec_isalloc(self) )
+   for ( size_t i = 0; i < n; i++ )
    {
-      if ( (self->mem_mgr.reclaim != NULL) && (self->arr != NULL) )
-      {
-         self->mem_mgr.reclaim(self->arr, self->capacity * self->element_size, self->mem_mgr.arena );
-      }
-      vec_pool_reclaim(self);
+      vec_detach_mem_mgr(live[i]);
+      vec_pool_reclaim(live[i]);
    }
+   return n;
 }
 
 /******************************************************************************/
@@ -198,7 +311,10 @@ struct Vector * VectorDuplicate( const struct Vector * self )
         (self->len > self->capacity) ||
         (self->capacity > self->max_capacity) ||
         ( (self->len > 0) && (NULL == self->arr) )
-        || (NULL == self->mem_mgr.alloc)
+        || (NULL == MEM_MGR(self)->alloc) ||
+        // A realtime vector always holds its whole array
+        ( (self->flags & VecFlag_Realtime) &&
+          ( (NULL == self->arr) || (self->capacity != self->max_capacity) ) )
       )
    {
       return NULL;
@@ -212,16 +328,44 @@ struct Vector * VectorDuplicate( const struct Vector * self )
    }
 
    memcpy( dup, self, sizeof(struct Vector) );
+   if ( !vec_attach_mem_mgr(dup, vec_allocator(self), false) )
+   {
+      vec_pool_reclaim(dup);
+      return NULL;
+   }
 
    dup->arr = NULL;
-   if ( dup->len > 0 )
+   dup->flags &= (uint8_t)~VecFlag_Locked; // Not until vec_rt_prepare locks it
+   dup->rt_violations = 0;
+   VEC_STATS_CLEAR(dup);
+   if ( self->flags & VecFlag_StableAddresses )
+   {
+      // The duplicate gets a reservation of its own
+      dup->capacity = 0;
+      if ( (self->capacity > 0) && vec_stable_commit(dup, self->capacity) )
+      {
+         memcpy( dup->arr, self->arr, dup->len * dup->element_size );
+         VEC_STAT(self, VecStat_CopyBytes, dup->len * dup->element_size);
+      }
+      else
+      {
+         // TODO: Throw exception that underlying data failed to get duplicated.
+         dup->len = 0;
+      }
+   }
+   else if ( (dup->len > 0) || (dup->flags & VecFlag_Realtime) )
    {
-      dup->arr = self->mem_mgr.alloc( dup->capacity * dup->element_size, self->mem_mgr.arena );
+      // Exactly as big, so that the duplicate compares equal
+      if ( !vec_recycle_take(dup, dup->capacity, dup->capacity) )
+      {
+         dup->arr = vec_alloc( dup, dup->capacity * dup->element_size );
+      }
       if ( dup->arr != NULL )
       {
          memcpy( dup->arr,
                  self->arr,
                  dup->len * dup->element_size );
+         VEC_STAT(self, VecStat_CopyBytes, dup->len * dup->element_size);
       }
       else
       {
@@ -229,28 +373,60 @@ struct Vector * VectorDuplicate( const struct Vector * self )
       }
    }
 
+   if ( (dup->flags & VecFlag_Realtime) &&
+        ( (NULL == dup->arr) || !vec_rt_prepare(dup, self->flags & VecFlag_Locked) ) )
+   {
+      // A realtime vector without its whole array up front isn't one
+      VEC_TRACE_NESTED( VectorFree(dup) );
+      return NULL;
+   }
+
    // dupd vector _must not_ reference original vector's data!
    assert( dup->arr != self->arr );
 
+   VEC_TRACE( Duplicate, self, VEC_TRACE_HANDLE(dup), 0, 0, 0 );
    return dup;
 }
 
 /******************************************************************************/
 bool VectorMove( struct Vector * dest, struct Vector * src )
 {
-   assert( dest == NULL || (dest != NULL && dest->mem_mgr.reclaim != NULL) );
+   assert( dest == NULL || (dest != NULL && MEM_MGR(dest)->reclaim != NULL) );
    if ( (NULL == src) || (NULL == dest) ||
         (dest->element_size != src->element_size) ||
-        (dest->mem_mgr.alloc   != src->mem_mgr.alloc) ||
-        (dest->mem_mgr.realloc != src->mem_mgr.realloc) ||
-        (dest->mem_mgr.reclaim != src->mem_mgr.reclaim) ||
-        (dest->mem_mgr.arena   != src->mem_mgr.arena) )
+        (MEM_MGR(dest)->alloc   != MEM_MGR(src)->alloc) ||
+        (MEM_MGR(dest)->realloc != MEM_MGR(src)->realloc) ||
+        (MEM_MGR(dest)->reclaim != MEM_MGR(src)->reclaim) ||
+        (MEM_MGR(dest)->arena   != MEM_MGR(src)->arena) ||
+        // The reservation size of a stable vector follows its max capacity, and
+        // a regular vector's array can't be grown in place like a reservation.
+        (dest->flags != src->flags) ||
+        (dest->alignment != src->alignment) )
    {
       return false;
    }
+   VEC_TRACE( Move, dest, VEC_TRACE_HANDLE(src), 0, 0, 0 );
+
+   if ( src->flags & VecFlag_Realtime )
+   {
+      // A realtime vector must keep a whole prefaulted array to stay usable,
+      // so src takes over the one dest had rather than being left without.
+      void * dest_arr = dest->arr;
+      vec_len_t dest_capacity = dest->capacity;
+      vec_len_t dest_max_capacity = dest->max_capacity;
+      dest->arr = src->arr;
+      dest->capacity = src->capacity;
+      dest->max_capacity = src->max_capacity;
+      dest->len = src->len;
+      src->arr = dest_arr;
+      src->capacity = dest_capacity;
+      src->max_capacity = dest_max_capacity;
+      src->len = 0;
+      return true;
+   }
 
    // Free resources of existing destination vector, if applicable
-   dest->mem_mgr.reclaim(dest->arr, dest->element_size * dest->capacity, dest->mem_mgr.arena);
+   vec_release_arr(dest);
 
    // Move resources over
    dest->capacity = src->capacity;
@@ -274,6 +450,7 @@ bool VectorsAreEqual( const struct Vector * a, const struct Vector * b )
 {
    // Check for NULL pointers
    if ( (NULL == a) || (NULL == b) )   return false;
+   VEC_TRACE( AreEqual, a, VEC_TRACE_HANDLE(b), 0, 0, 0 );
 
    // First check lengths
    if (a->len != b->len) return false;
@@ -306,6 +483,14 @@ bool VectorsAreEqual( const struct Vector * a, const struct Vector * b )
 /******************************************************************************/
 struct Vector * VectorConcatenate( const struct Vector * v1,
                                    const struct Vector * v2 )
+{
+   return VectorConcatenateWith(v1, v2, NULL);
+}
+
+/******************************************************************************/
+struct Vector * VectorConcatenateWith( const struct Vector * v1,
+                                       const struct Vector * v2,
+                                       const struct Allocator * mem_mgr )
 {
    if ( (NULL == v1) || (NULL == v2) ||
         (v1->element_size != v2->element_size) ||
@@ -327,25 +512,53 @@ struct Vector * VectorConcatenate( const struct Vector * v1,
    assert(v2->element_size > 0);
    assert(v1->element_size == v2->element_size);
 
+   if ( NULL == mem_mgr )
+   {
+      mem_mgr = vec_allocator(v1);
+   }
+
    struct Vector * NewVec = NULL;
    // If one of the vectors is empty, simply create a duplicate of the non-empty
    // vector. If both vectors are empty, create an empty vector.
    if ( (0 == v1->len) && (0 == v2->len) )
    {
-      NewVec = VectorNew( v1->element_size,
-                           DEFAULT_INITIAL_CAPACITY,
-                           DEFAULT_INITIAL_CAPACITY * DEFAULT_MAX_CAPACITY_FACTOR,
-                           0,
-                           &v1->mem_mgr );
+      NewVec = vec_new( v1->element_size,
+                        DEFAULT_INITIAL_CAPACITY,
+                        DEFAULT_INITIAL_CAPACITY * DEFAULT_MAX_CAPACITY_FACTOR,
+                        0,
+                        mem_mgr,
+                        &(struct VectorAttr){ .alignment = v1->alignment },
+                        true );
    }
 
-   else if ( (v1->len > 0)  && (v2->len == 0) )
-   {
-      NewVec = VectorDuplicate(v1);
-   }
-   else if ( (v1->len == 0) && (v2->len > 0) )
+   else if ( (v1->len == 0) || (v2->len == 0) )
    {
-      NewVec = VectorDuplicate(v2);
+      const struct Vector * src = (v1->len > 0) ? v1 : v2;
+      if ( mem_mgr == vec_allocator(src) )
+      {
+         VEC_TRACE_NESTED( NewVec = VectorDuplicate(src) );
+      }
+      else
+      {
+         // A duplicate in all but the allocator
+         NewVec = vec_new( src->element_size,
+                           src->capacity,
+                           src->max_capacity,
+                           src->len,
+                           mem_mgr,
+                           &(struct VectorAttr){ .alignment = src->alignment },
+                           false );
+         if ( (NewVec != NULL) && (NewVec->arr != NULL) )
+         {
+            memcpy( NewVec->arr, src->arr, (src->len * src->element_size) );
+            VEC_STAT(src, VecStat_CopyBytes, src->len * src->element_size);
+         }
+         else
+         {
+            VEC_TRACE_NESTED( VectorFree(NewVec) );
+            NewVec = NULL;
+         }
+      }
    }
 
    else  // Both must be non-empty
@@ -362,24 +575,29 @@ struct Vector * VectorConcatenate( const struct Vector * v1,
          new_vec_max_cap = v1->max_capacity + v2->max_capacity;
       }
 
-      NewVec = VectorNew( v1->element_size,
-                           new_vec_cap,
-                           new_vec_max_cap,
-                           new_vec_len,
-                           &v1->mem_mgr );
+      NewVec = vec_new( v1->element_size,
+                        new_vec_cap,
+                        new_vec_max_cap,
+                        new_vec_len,
+                        mem_mgr,
+                        &(struct VectorAttr){ .alignment = v1->alignment },
+                        false );
       if ( (NewVec != NULL) && (NewVec->arr != NULL) )
       {
          memcpy( NewVec->arr,                 v1->arr, (v1->len * v1->element_size) );
          memcpy( PTR_TO_IDX(NewVec, v1->len), v2->arr, (v2->len * v2->element_size) );
+         VEC_STAT(v1, VecStat_CopyBytes, v1->len * v1->element_size);
+         VEC_STAT(v2, VecStat_CopyBytes, v2->len * v2->element_size);
       }
       else
       {
          // Something failed in creating the vector...
-         VectorFree(NewVec);
+         VEC_TRACE_NESTED( VectorFree(NewVec) );
          NewVec = NULL; // We'll return NULL
       }
    }
 
+   VEC_TRACE( Concatenate, v1, VEC_TRACE_HANDLE(v2), VEC_TRACE_HANDLE(NewVec), 0, 0 );
    return NewVec;
 }
 
@@ -443,9 +661,21 @@ bool VectorIsFull( const struct Vector * self )
    return self->len == self->max_capacity;
 }
 
+/******************************************************************************/
+size_t VectorRealtimeViolations( const struct Vector * self )
+{
+   if ( NULL == self )
+   {
+      return 0;
+   }
+   return self->rt_violations;
+}
+
 /******************************************************************************/
 bool VectorPush( struct Vector * self, const void * element )
 {
+   VEC_TRACE( Push, self, 0, 0, 0, 0 );
+
    // Early return op
    // Invalid inputs
    if ( (NULL == self) || (NULL == element) )
@@ -474,6 +704,7 @@ bool VectorPush( struct Vector * self, const void * element )
       void * insertion_spot = (void *)PTR_TO_IDX(self, self->len);
       memcpy( insertion_spot, element, self->element_size );
       self->len++;
+      VEC_STAT(self, VecStat_Pushes, 1);
    }
    else
    {
@@ -490,6 +721,7 @@ bool VectorInsert( struct Vector * self,
 {
    // Early return op
    // Invalid inputs
+   VEC_TRACE( Insert, self, idx, 0, 0, 0 );
    if ( (NULL == self) || (NULL == element) || (idx > self->len) )
    {
       // TODO: Throw exception
@@ -518,6 +750,7 @@ bool VectorInsert( struct Vector * self,
       void * insertion_spot = (void *)PTR_TO_IDX(self, idx);
       memcpy( insertion_spot, element, self->element_size );
       self->len++;
+      VEC_STAT(self, VecStat_Inserts, 1);
    }
    else
    {
@@ -530,6 +763,7 @@ bool VectorInsert( struct Vector * self,
 /******************************************************************************/
 void * VectorGet( const struct Vector * self, size_t idx )
 {
+   VEC_TRACE( Get, self, idx, 0, 0, 0 );
    if ( (NULL == self) || (idx >= self->len) )
    {
       return NULL;
@@ -543,6 +777,7 @@ void * VectorGet( const struct Vector * self, size_t idx )
 /******************************************************************************/
 void * VectorLastElement( const struct Vector * self )
 {
+   VEC_TRACE( LastElement, self, 0, 0, 0, 0 );
    if ( (NULL == self) || (0 == self->len) )
    {
       return NULL;
@@ -559,6 +794,7 @@ void * VectorLastElement( const struct Vector * self )
 /******************************************************************************/
 bool VectorCpyElementAt( const struct Vector * self, size_t idx, void * data )
 {
+   VEC_TRACE( CpyElementAt, self, idx, 0, 0, 0 );
    if ( (NULL == self) || (idx >= self->len) || (NULL == data))
    {
       return false;
@@ -575,6 +811,7 @@ bool VectorCpyElementAt( const struct Vector * self, size_t idx, void * data )
 /******************************************************************************/
 bool VectorCpyLastElement( const struct Vector * self, void * data )
 {
+   VEC_TRACE( CpyLastElement, self, 0, 0, 0, 0 );
    if ( (NULL == self) || (0 == self->len) || (NULL == data) )
    {
       return false;
@@ -586,9 +823,9 @@ bool VectorCpyLastElement( const struct Vector * self, void * data )
    assert( (self->element_size * self->len) <= PTRDIFF_MAX );
    assert( self->arr != NULL );
 
-   (void)memcpy( data,
-                 VectorLastElement(self),
-                 self->element_size );
+   void * last = NULL;
+   VEC_TRACE_NESTED( last = VectorLastElement(self) );
+   (void)memcpy( data, last, self->element_size );
    
    return true;
 }
@@ -598,6 +835,7 @@ bool VectorSet( struct Vector * self,
                            size_t idx,
                            const void * element )
 {
+   VEC_TRACE( Set, self, idx, 0, 0, 0 );
    if ( (NULL == self) || (idx >= self->len) || (NULL == element) )
    {
       return false;
@@ -614,6 +852,7 @@ bool VectorSet( struct Vector * self,
 /******************************************************************************/
 bool VectorRemove( struct Vector * self, size_t idx, void * data )
 {
+   VEC_TRACE( Remove, self, idx, (data != NULL), 0, 0 );
    if ( (NULL == self) || (idx >= self->len) || (self->len == 0) )
    {
       return false;
@@ -633,6 +872,7 @@ bool VectorRemove( struct Vector * self, size_t idx, void * data )
       shiftn(self, idx + 1, ShiftDir_Left, 1);
    }
    self->len--;
+   VEC_STAT(self, VecStat_Removes, 1);
 
    return true;
 }
@@ -647,6 +887,7 @@ bool VectorRemoveLastElement( struct Vector * self, void * data )
 /******************************************************************************/
 bool VectorClearElementAt( struct Vector * self, size_t idx )
 {
+   VEC_TRACE( ClearElementAt, self, idx, 0, 0, 0 );
    if ( (NULL == self) || (NULL == self->arr) ||
         (0 == self->len) || (idx >= self->len) )
    {
@@ -673,6 +914,7 @@ bool VectorClear( struct Vector * self )
 /******************************************************************************/
 bool VectorReset( struct Vector * self )
 {
+   VEC_TRACE( Reset, self, 0, 0, 0, 0 );
    if ( NULL == self )
    {
       return false;
@@ -685,6 +927,7 @@ bool VectorReset( struct Vector * self )
 /******************************************************************************/
 bool VectorHardReset( struct Vector * self )
 {
+   VEC_TRACE( HardReset, self, 0, 0, 0, 0 );
    if ( NULL == self )
    {
       return false;
@@ -700,10 +943,16 @@ bool VectorHardReset( struct Vector * self )
 
    assert(self->arr != NULL);
    assert(self->element_size > 0);
-   assert(self->mem_mgr.reclaim != NULL);
+   assert(MEM_MGR(self)->reclaim != NULL);
 
    memset( self->arr, 0, self->capacity * self->element_size );
-   self->mem_mgr.reclaim( self->arr, self->capacity * self->element_size, self->mem_mgr.arena );
+   if ( self->flags & VecFlag_Realtime )
+   {
+      // Giving the array back would mean allocating it again on the next push
+      self->len = 0;
+      return true;
+   }
+   vec_release_arr(self);
    self->arr = NULL; // After freeing memory, clear out stale pointers!
    self->len = 0;
    self->capacity = 0;
@@ -717,6 +966,13 @@ bool VectorHardReset( struct Vector * self )
 /******************************************************************************/
 
 struct Vector * VectorSplitAt( struct Vector * self, size_t idx )
+{
+   return VectorSplitAtWith(self, idx, NULL);
+}
+
+/******************************************************************************/
+struct Vector * VectorSplitAtWith( struct Vector * self, size_t idx,
+                                   const struct Allocator * mem_mgr )
 {
    if ( (NULL == self) || (self->len == 0) || (self->capacity == 0) ||
         (idx >= self->len) || (idx == 0) )
@@ -730,11 +986,13 @@ struct Vector * VectorSplitAt( struct Vector * self, size_t idx )
    assert(self->element_size > 0);
 
    size_t new_vec_len = self->len - idx;
-   struct Vector * new_vec = VectorNew( self->element_size,
-                                           new_vec_len * 2,
-                                           new_vec_len * 4,
-                                           new_vec_len,
-                                           &self->mem_mgr );
+   struct Vector * new_vec = vec_new( self->element_size,
+                                      new_vec_len * 2,
+                                      new_vec_len * 4,
+                                      new_vec_len,
+                                      (NULL == mem_mgr) ? vec_allocator(self) : mem_mgr,
+                                      &(struct VectorAttr){ .alignment = self->alignment },
+                                      false );
    if ( (NULL == new_vec) || (NULL == new_vec->arr) )
    {
       return NULL;
@@ -742,15 +1000,17 @@ struct Vector * VectorSplitAt( struct Vector * self, size_t idx )
 
    // NOTE: Don't mutate the original vector until after we've successfully
    //       initialized the new vector!
-   self->len = idx;    // Does not include original element at idx
+   self->len = (vec_len_t)idx;    // Does not include original element at idx
    memcpy( new_vec->arr,
            PTR_TO_IDX(self, idx),
            new_vec_len * self->element_size );
+   VEC_STAT(self, VecStat_CopyBytes, new_vec_len * self->element_size);
    
    #ifdef NO_DATA_LEFT_BEHIND
    memset( PTR_TO_IDX(self, idx), 0, new_vec_len * self->element_size );
    #endif
 
+   VEC_TRACE( SplitAt, self, idx, VEC_TRACE_HANDLE(new_vec), 0, 0 );
    return new_vec;
 }
 
@@ -759,6 +1019,15 @@ struct Vector * VectorSplitAt( struct Vector * self, size_t idx )
 struct Vector * VectorSlice( const struct Vector * self,
                                size_t idx_start,
                                size_t idx_end )
+{
+   return VectorSliceWith(self, idx_start, idx_end, NULL);
+}
+
+/******************************************************************************/
+struct Vector * VectorSliceWith( const struct Vector * self,
+                                 size_t idx_start,
+                                 size_t idx_end,
+                                 const struct Allocator * mem_mgr )
 {
    if ( (NULL == self) || (self->len == 0) || (self->capacity == 0) ||
         (idx_start >= self->len) || (idx_end > self->len) ||
@@ -768,10 +1037,18 @@ struct Vector * VectorSlice( const struct Vector * self,
       return NULL;
    }
 
+   if ( NULL == mem_mgr )
+   {
+      mem_mgr = vec_allocator(self);
+   }
+
    // Slicing the whole vector is the same as duplication
-   if ( (0 == idx_start) && (self->len == idx_end) )
+   if ( (0 == idx_start) && (self->len == idx_end) && (mem_mgr == vec_allocator(self)) )
    {
-      return VectorDuplicate(self);
+      struct Vector * dup = NULL;
+      VEC_TRACE_NESTED( dup = VectorDuplicate(self) );
+      VEC_TRACE( Slice, self, idx_start, idx_end, VEC_TRACE_HANDLE(dup), 0 );
+      return dup;
    }
 
    assert(self->len > 0);
@@ -779,11 +1056,13 @@ struct Vector * VectorSlice( const struct Vector * self,
    assert(self->element_size > 0);
 
    size_t new_vec_len = idx_end - idx_start;
-   struct Vector * new_vec = VectorNew( self->element_size,
-                                           new_vec_len * 2,
-                                           new_vec_len * 4,
-                                           new_vec_len,
-                                           &self->mem_mgr );
+   struct Vector * new_vec = vec_new( self->element_size,
+                                      new_vec_len * 2,
+                                      new_vec_len * 4,
+                                      new_vec_len,
+                                      mem_mgr,
+                                      &(struct VectorAttr){ .alignment = self->alignment },
+                                      false );
    if ( (NULL == new_vec) || (NULL == new_vec->arr) )
    {
       return NULL;
@@ -792,7 +1071,9 @@ struct Vector * VectorSlice( const struct Vector * self,
    memcpy( new_vec->arr,
            PTR_TO_IDX(self, idx_start),
            new_vec_len * self->element_size );
+   VEC_STAT(self, VecStat_CopyBytes, new_vec_len * self->element_size);
    
+   VEC_TRACE( Slice, self, idx_start, idx_end, VEC_TRACE_HANDLE(new_vec), 0 );
    return new_vec;
 }
 
@@ -801,10 +1082,16 @@ struct Vector * VectorSlice( const struct Vector * self,
 
 bool VectorRangePush( struct Vector * self, const void * data, size_t dlen )
 {
-   if ( (NULL == self) || (NULL == data) ||
-        ( (self->len + dlen) > self->max_capacity ) || (dlen == 0) )
+   VEC_TRACE( RangePush, self, dlen, 0, 0, 0 );
+   if ( (NULL == self) || (NULL == data) || (dlen == 0) )
+   {
+      // TODO: Throw exception
+      return false;
+   }
+   if ( (self->len + dlen) > self->max_capacity )
    {
       // TODO: Throw exception
+      vec_rt_violation(self);
       return false;
    }
 
@@ -826,7 +1113,8 @@ bool VectorRangePush( struct Vector * self, const void * data, size_t dlen )
    {
       void * insertion_spot = (void *)PTR_TO_IDX(self, self->len);
       memcpy( insertion_spot, data, (self->element_size * dlen) );
-      self->len += dlen;
+      self->len = (vec_len_t)(self->len + dlen);
+      VEC_STAT(self, VecStat_Pushes, 1);
    }
    else
    {
@@ -843,13 +1131,18 @@ bool VectorRangeInsert( struct Vector * self,
                         const void * data,
                         size_t dlen )
 {
-   if ( (NULL == self) || (NULL == data) ||
-        ( (self->len + dlen) > self->max_capacity ) || (dlen == 0) ||
-        (idx > self->len) )
+   VEC_TRACE( RangeInsert, self, idx, dlen, 0, 0 );
+   if ( (NULL == self) || (NULL == data) || (dlen == 0) || (idx > self->len) )
    {
       // TODO: Throw exception
       return false;
    }
+   if ( (self->len + dlen) > self->max_capacity )
+   {
+      // TODO: Throw exception
+      vec_rt_violation(self);
+      return false;
+   }
 
    assert( self->len <= self->capacity );
    assert( self->capacity <= self->max_capacity );
@@ -857,7 +1150,9 @@ bool VectorRangeInsert( struct Vector * self,
 
    if ( dlen == 1 )
    {
-      return VectorInsert(self, idx, data);
+      bool inserted = false;
+      VEC_TRACE_NESTED( inserted = VectorInsert(self, idx, data) );
+      return inserted;
    }
 
    // Ensure there's space
@@ -878,7 +1173,8 @@ bool VectorRangeInsert( struct Vector * self,
       }
       void * insertion_spot = (void *)PTR_TO_IDX(self, idx);
       memcpy( insertion_spot, data, (self->element_size * dlen) );
-      self->len += dlen;
+      self->len = (vec_len_t)(self->len + dlen);
+      VEC_STAT(self, VecStat_Inserts, 1);
    }
    else
    {
@@ -895,6 +1191,7 @@ bool VectorRangeCpy( const struct Vector * self,
                      size_t idx_end,
                      void * buffer )
 {
+   VEC_TRACE( RangeCpy, self, idx_start, idx_end, 0, 0 );
    if ( (NULL == self) || (NULL == buffer) ||
         (idx_start >= self->len) || (idx_end > self->len) ||
         (idx_start >= idx_end)
@@ -932,6 +1229,7 @@ bool VectorRangeSetWithArr( struct Vector * self,
                      size_t idx_end,
                      const void * arr )
 {
+   VEC_TRACE( RangeSetWithArr, self, idx_start, idx_end, 0, 0 );
    if ( (NULL == self) || (NULL == arr) ||
         (idx_start >= self->len) || (idx_end > self->len) ||
         (idx_start >= idx_end) ) 
@@ -954,6 +1252,7 @@ bool VectorRangeSetWithArr( struct Vector * self,
 
 bool VectorRangeSetToVal( struct Vector * self, size_t idx_start, size_t idx_end, const void * val )
 {
+   VEC_TRACE( RangeSetToVal, self, idx_start, idx_end, 0, 0 );
    if ( (NULL == self) || (NULL == val) ||
         (idx_start >= self->len) || (idx_end > self->len) ||
         (idx_start >= idx_end) ) 
@@ -979,6 +1278,7 @@ bool VectorRangeRemove( struct Vector * self,
                         size_t idx_end,
                         void * buf )
 {
+   VEC_TRACE( RangeRemove, self, idx_start, idx_end, (buf != NULL), 0 );
    if ( (NULL == self) || (NULL == self->arr) ||
         (idx_start >= self->len) || (idx_end > self->len) ||
         (idx_start >= idx_end) || (self->len == 0) ) 
@@ -992,13 +1292,15 @@ bool VectorRangeRemove( struct Vector * self,
 
    if ( idx_start == (idx_end - 1) )
    {
-      return VectorRemove(self, idx_start, buf);
+      bool removed = false;
+      VEC_TRACE_NESTED( removed = VectorRemove(self, idx_start, buf) );
+      return removed;
    }
 
    size_t num_of_removed = idx_end - idx_start;
    if ( NULL != buf )
    {
-      VectorRangeCpy(self, idx_start, idx_end, buf);
+      VEC_TRACE_NESTED( VectorRangeCpy(self, idx_start, idx_end, buf) );
    }
    // Only need to shift over if the removal does not include the end
    if ( idx_end < self->len )
@@ -1009,10 +1311,11 @@ bool VectorRangeRemove( struct Vector * self,
    else
    {
       // Zero out that leftover data
-      VectorRangeClear(self, idx_start, idx_end);
+      VEC_TRACE_NESTED( VectorRangeClear(self, idx_start, idx_end) );
    }
 #endif
-   self->len -= num_of_removed;
+   self->len = (vec_len_t)(self->len - num_of_removed);
+   VEC_STAT(self, VecStat_Removes, 1);
 
    return true;
 }
@@ -1024,6 +1327,7 @@ bool VectorRangeClear( struct Vector * self,
                        size_t idx_start,
                        size_t idx_end )
 {
+   VEC_TRACE( RangeClear, self, idx_start, idx_end, 0, 0 );
    assert( (self == NULL) ||
            (self != NULL &&
             ( (self->capacity == 0 && self->arr == NULL) ||
@@ -1055,267 +1359,1765 @@ bool VectorRangeClear( struct Vector * self,
 /* Private Function Implementations */
 
 /**
- * @brief Expands the capacity of the vector to accommodate additional elements.
- * 
- * @param self Vector handle.
- * @return true if the expansion was successful, false otherwise.
+ * @brief Common constructor behind VectorNew and the API functions that create
+ *        vectors internally.
+ *
+ * @note When zero_init is false, the first initial_len elements are left
+ *       uninitialized. This is meant for callers that are about to overwrite
+ *       them anyways (e.g., VectorConcatenate, VectorSlice), so that we don't
+ *       pay for zeroing (and faulting in) memory that is immediately clobbered.
+ * @param attr Optional attributes (see VectorAttr); NULL for none
+ * @param zero_init Whether the initial_len elements need to read as zeros
+ * @return A pointer to the initialized vector, or NULL if allocation fails.
  */
-static bool vec_expand( struct Vector * self )
+static struct Vector * vec_new( size_t element_size,
+                                size_t initial_capacity,
+                                size_t max_capacity,
+                                size_t initial_len,
+                                const struct Allocator * mem_mgr,
+                                const struct VectorAttr * attr,
+                                bool zero_init )
 {
-   // Since this is a purely internal function, I will destructively assert at any invalid inputs
-   assert(self != NULL);
-   assert(self->element_size != 0);
-   assert( (self->capacity == 0 && self->arr == NULL) ||
-           (self->capacity >  0 && self->arr != NULL) );
-   assert(self->len <= self->capacity);
-   assert(self->len <= self->max_capacity);
-   assert(self->mem_mgr.realloc != NULL);
+   // Invalid inputs
+   if ( (0 == element_size) ||
+        (initial_capacity > MAX_VEC_LEN) ||
+        (0 == max_capacity) ||
+        (initial_capacity > max_capacity) ||
+        (initial_len > initial_capacity) )
+   {
+      // TODO: Vector constructor exception
+      return NULL;
+   }
 
-   // If we're already at max capacity, can't expand further.
-   if ( self->capacity == self->max_capacity )
+   if ( max_capacity > MAX_VEC_LEN )
    {
-      return false;
+      // TODO: Throw exception for max_capacity too large
+      max_capacity = MAX_VEC_LEN;
    }
 
-   // First determine new capacity, and then realloc.
-   if ( 0 == self->capacity )
+   bool stable = (attr != NULL) && attr->stable_addresses;
+   if ( stable && (max_capacity > ((SIZE_MAX - ccol_page_size()) / element_size)) )
    {
-      size_t new_capacity = (self->max_capacity < DEFAULT_INITIAL_CAPACITY) ?
-                             self->max_capacity : DEFAULT_INITIAL_CAPACITY;
-      self->arr = self->mem_mgr.alloc( new_capacity * self->element_size, self->mem_mgr.arena );
-      if ( self->arr != NULL )
-      {
-         self->capacity = new_capacity;
-         return true;
-      }
+      // The whole reservation must be addressable
+      return NULL;
    }
-   else
+
+   bool realtime = (attr != NULL) && attr->realtime;
+   bool lock_memory = realtime && attr->lock_memory;
+   if ( realtime )
    {
-      size_t new_capacity;
-      if ( (self->capacity * EXPANSION_FACTOR) < self->max_capacity )
+      if ( max_capacity > (SIZE_MAX / element_size) )
       {
-         new_capacity = self->capacity * EXPANSION_FACTOR;
-      }
-      else
-      {
-         new_capacity = self->max_capacity;
-      }
-      void * new_ptr = self->mem_mgr.realloc( self->arr,
-                                              self->element_size * new_capacity,
-                                              self->element_size * self->capacity,
-                                              self->mem_mgr.arena );
-      if ( new_ptr != NULL )
-      {
-         self->arr = new_ptr;
-         self->capacity = new_capacity;
-         return true;
+         return NULL;
       }
+      initial_capacity = max_capacity;
    }
 
-   return false;
-}
-
-/**
- * @brief Expands the capacity of the vector by a specified number of elements.
- *
- * @param self Vector handle.
- * @param add_len The number of additional elements to expand the capacity by.
- * @return true if the expansion was successful; false otherwise.
- */
-static bool vec_expandby( struct Vector * self, size_t add_cap )
-{
-   // Since this is a purely internal function, I will destructively assert at any invalid inputs
-   assert(self != NULL);
-   assert(self->element_size != 0);
-   assert( (self->capacity == 0 && self->arr == NULL) ||
-           (self->capacity >  0 && self->arr != NULL) );
-   assert(self->len <= self->capacity);
-   assert(self->len <= self->max_capacity); 
-   assert(self->mem_mgr.realloc != NULL);
-
-   // If there's no space in the vector, we can't expand
-   if ( add_cap > (self->max_capacity - self->capacity) )
+   size_t alignment = (attr != NULL) ? attr->alignment : 0;
+   if ( (alignment & (alignment - 1)) != 0 )
    {
-      return false;
+      // TODO: Throw exception for an alignment that isn't a power of two
+      return NULL;
+   }
+   if ( stable && (alignment > ccol_page_size()) )
+   {
+      // Reservations are only page-aligned
+      return NULL;
    }
 
-   if ( 0 == self->capacity )
+   const struct Allocator default_mem_mgr = DEFAULT_ALLOCATOR;
+   if ( (NULL == mem_mgr) ||
+        (NULL == mem_mgr->alloc) || (NULL == mem_mgr->realloc) || (NULL == mem_mgr->reclaim) )
    {
-      size_t new_capacity = add_cap;
-      self->arr = self->mem_mgr.alloc( new_capacity * self->element_size, self->mem_mgr.arena );
-      if ( self->arr != NULL )
-      {
-         self->capacity = new_capacity;
-         return true;
-      }
+      // TODO: Throw exception if user passed in a partially complete memory manager
+      mem_mgr = &default_mem_mgr;
    }
-   else
+
+   if ( (alignment > 0) && !stable &&
+        ( (NULL == mem_mgr->alloc_aligned) || (NULL == mem_mgr->realloc_aligned) ) )
    {
-      size_t new_capacity = self->capacity + add_cap;
-      void * new_ptr = self->mem_mgr.realloc( self->arr,
-                                              self->element_size * new_capacity,
-                                              self->element_size * self->capacity,
-                                              self->mem_mgr.arena );
-      if ( new_ptr != NULL )
-      {
-         self->arr = new_ptr;
-         self->capacity = new_capacity;
-         return true;
-      }
+      // TODO: Throw exception that the allocator can't honor the alignment
+      return NULL;
    }
 
-   return false;
+   struct Vector * new_vec = vec_pool_dispatch();
+   if ( NULL == new_vec )
+   {
+      return NULL;
+   }
+
+   if ( !vec_attach_mem_mgr(new_vec, mem_mgr, true) )
+   {
+      vec_pool_reclaim(new_vec);
+      return NULL;
+   }
+
+   new_vec->element_size = element_size;
+   new_vec->max_capacity = (vec_len_t)max_capacity;
+   new_vec->alignment = alignment;
+   new_vec->flags = (uint8_t)( (stable ? VecFlag_StableAddresses : 0u) |
+                               (realtime ? VecFlag_Realtime : 0u) );
+   new_vec->rt_violations = 0;
+   VEC_STATS_CLEAR(new_vec);
+
+   bool is_zeroed = false;
+   if ( stable )
+   {
+      // Reserve right away, even for an initial capacity of 0, so that a
+      // platform that can't reserve address space is caught here rather than
+      // at the first push. Fresh pages read as zeros.
+      new_vec->arr = NULL;
+      new_vec->capacity = 0;
+      if ( !vec_stable_commit( new_vec, (initial_capacity > 0) ? initial_capacity : 1 ) )
+      {
+         vec_detach_mem_mgr(new_vec);
+         vec_pool_reclaim(new_vec);
+         return NULL;
+      }
+      new_vec->len = (vec_len_t)initial_len;
+      if ( realtime && !vec_rt_prepare(new_vec, lock_memory) )
+      {
+         VEC_TRACE_NESTED( VectorFree(new_vec) );
+         return NULL;
+      }
+      return new_vec;
+   }
+   else if ( 0 == initial_capacity )
+   {
+      new_vec->arr = NULL;
+   }
+   else if ( vec_recycle_take(new_vec, initial_capacity, max_capacity) )
+   {
+      initial_capacity = new_vec->capacity;
+   }
+   else if ( zero_init && (initial_len > 0) && (0 == alignment) &&
+             (MEM_MGR(new_vec)->alloc_zeroed != NULL) )
+   {
+      // Let the allocator hand us zeroed memory rather than memset'ing it
+      // ourselves, which would fault in every page of a large vector up front.
+      new_vec->arr = MEM_MGR(new_vec)->alloc_zeroed( element_size * initial_capacity,
+                                                    MEM_MGR(new_vec)->arena );
+      is_zeroed = true;
+   }
+   else
+   {
+      new_vec->arr = vec_alloc( new_vec, element_size * initial_capacity );
+   }
+
+   // If we failed to allocate space for the array...
+   if ( (initial_capacity > 0) && (NULL == new_vec->arr) )
+   {
+      // TODO: Throw exception to inform user...
+      new_vec->capacity = 0;
+      new_vec->len = 0;
+   }
+   else
+   {
+      new_vec->capacity = (vec_len_t)initial_capacity;
+      if ( initial_len > 0 )
+      {
+         if ( zero_init && !is_zeroed )
+         {
+            memset( new_vec->arr, 0, (element_size * initial_len) );
+         }
+         new_vec->len = (vec_len_t)initial_len;
+      }
+      else
+      {
+         new_vec->len = 0;
+      }
+   }
+
+   if ( realtime && ( (NULL == new_vec->arr) || !vec_rt_prepare(new_vec, lock_memory) ) )
+   {
+      // TODO: Throw exception that the realtime array couldn't be set up
+      VEC_TRACE_NESTED( VectorFree(new_vec) );
+      return NULL;
+   }
+
+   return new_vec;
+}
+
+/**
+ * @brief The allocator that vectors derived from this one should be created
+ *        with: the managed allocator itself if there is one (so that the new
+ *        vector takes a reference to it too), otherwise our copy.
+ * @param self Vector handle.
+ */
+static const struct Allocator * vec_allocator( const struct Vector * self )
+{
+   assert(self != NULL);
+#ifdef VEC_COMPACT_HEADER
+   return self->mem_mgr;
+#else
+   return (self->mem_mgr_ref != NULL) ? self->mem_mgr_ref : &self->mem_mgr;
+#endif
+}
+
+/**
+ * @brief Whether the vector uses the given allocator: holds a reference to it,
+ *        if it's managed, or has an identical copy of it otherwise.
+ */
+static bool vec_uses_mem_mgr( const struct Vector * self, const struct Allocator * mem_mgr )
+{
+   assert(self != NULL);
+   assert(mem_mgr != NULL);
+
+   const struct Allocator * own = vec_allocator(self);
+   if ( AllocatorIsManaged(mem_mgr) )
+   {
+      return own == mem_mgr;
+   }
+   return !AllocatorIsManaged(own) && mem_mgr_same(own, mem_mgr);
+}
+
+/**
+ * @brief Hooks the vector up to an allocator: a managed allocator is
+ *        referenced, and an unmanaged one is copied (or, with compact headers,
+ *        shared with other vectors using an identical allocator).
+ * @param self Vector handle.
+ * @param mem_mgr A complete allocator.
+ * @param run_init Whether to run an unmanaged allocator's alloca_init.
+ * @return true on success, false if there's no room for another allocator.
+ */
+static bool vec_attach_mem_mgr( struct Vector * self,
+                                const struct Allocator * mem_mgr,
+                                bool run_init )
+{
+   assert(self != NULL);
+   assert(mem_mgr != NULL);
+
+   if ( AllocatorIsManaged(mem_mgr) )
+   {
+      // Already set up once by AllocatorInit, so all we do is hold onto it.
+      // Managed allocators are never const objects (AllocatorInit had to
+      // write to them), so casting away the const to take a reference is OK.
+      struct Allocator * managed = (struct Allocator *)mem_mgr;
+      (void)AllocatorRetain(managed);
+#ifdef VEC_COMPACT_HEADER
+      self->mem_mgr = managed;
+#else
+      self->mem_mgr = *managed;
+      self->mem_mgr_ref = managed;
+#endif
+      return true;
+   }
+
+#ifdef VEC_COMPACT_HEADER
+   self->mem_mgr = mem_mgr_share(mem_mgr);
+   if ( NULL == self->mem_mgr )
+   {
+      return false;
+   }
+#else
+   self->mem_mgr = *mem_mgr;
+   self->mem_mgr_ref = NULL;
+#endif
+
+   if ( run_init && (MEM_MGR(self)->alloca_init != NULL) )
+   {
+      // The arena pointer may be NULL, but I won't let that stop me from calling
+      // the allocator's init fcn, because it may not need it.
+      MEM_MGR(self)->alloca_init( MEM_MGR(self)->arena );
+   }
+   return true;
+}
+
+/**
+ * @brief Lets go of the vector's allocator (see vec_attach_mem_mgr).
+ * @param self Vector handle.
+ */
+static void vec_detach_mem_mgr( struct Vector * self )
+{
+   assert(self != NULL);
+
+#ifdef VEC_COMPACT_HEADER
+   if ( AllocatorIsManaged(self->mem_mgr) )
+   {
+      AllocatorRelease(self->mem_mgr);
+   }
+   else
+   {
+      mem_mgr_unshare(self->mem_mgr);
+   }
+   self->mem_mgr = NULL;
+#else
+   AllocatorRelease(self->mem_mgr_ref);
+   self->mem_mgr_ref = NULL;
+#endif
+}
+
+/**
+ * @brief Allocates sz bytes for the vector's array, honoring its alignment.
+ * @param self Vector handle.
+ * @param sz Number of bytes to allocate.
+ * @return Pointer to the block, or NULL if allocation fails.
+ */
+static void * vec_alloc( const struct Vector * self, size_t sz )
+{
+   assert(self != NULL);
+   assert( !(self->flags & VecFlag_StableAddresses) );
+
+   if ( self->alignment > 0 )
+   {
+      assert(MEM_MGR(self)->alloc_aligned != NULL);
+      return MEM_MGR(self)->alloc_aligned( sz, self->alignment, MEM_MGR(self)->arena );
+   }
+
+   return MEM_MGR(self)->alloc( sz, MEM_MGR(self)->arena );
+}
+
+/**
+ * @brief Gives the vector's array back to wherever it came from.
+ * @note Leaves arr/capacity as they are; it's up to the caller to clear them.
+ * @param self Vector handle.
+ */
+static void vec_release_arr( struct Vector * self )
+{
+   assert(self != NULL);
+
+   if ( NULL == self->arr )
+   {
+      return;
+   }
+
+   if ( self->flags & VecFlag_Locked )
+   {
+      ccol_vm_unlock( self->arr, self->capacity * self->element_size );
+   }
+
+   if ( self->flags & VecFlag_StableAddresses )
+   {
+      ccol_vm_release( self->arr, self->max_capacity * self->element_size );
+   }
+   else if ( MEM_MGR(self)->reclaim != NULL )
+   {
+      MEM_MGR(self)->reclaim( self->arr, self->capacity * self->element_size, MEM_MGR(self)->arena );
+   }
+}
+
+/**
+ * @brief Expands the capacity of the vector to accommodate additional elements.
+ * 
+ * @param self Vector handle.
+ * @return true if the expansion was successful, false otherwise.
+ */
+static bool vec_expand( struct Vector * self )
+{
+   // Since this is a purely internal function, I will destructively assert at any invalid inputs
+   assert(self != NULL);
+   assert(self->element_size != 0);
+   assert( (self->capacity == 0 && self->arr == NULL) ||
+           (self->capacity >  0 && self->arr != NULL) );
+   assert(self->len <= self->capacity);
+   assert(self->len <= self->max_capacity);
+   assert(MEM_MGR(self)->realloc != NULL);
+
+   if ( self->flags & VecFlag_Realtime )
+   {
+      // Everything was allocated up front, so there's no growing any further
+      vec_rt_violation(self);
+      return false;
+   }
+
+   // If we're already at max capacity, can't expand further.
+   if ( self->capacity == self->max_capacity )
+   {
+      return false;
+   }
+
+   // First determine new capacity, and then grow.
+   size_t new_capacity;
+   if ( 0 == self->capacity )
+   {
+      new_capacity = (self->max_capacity < DEFAULT_INITIAL_CAPACITY) ?
+                      self->max_capacity : DEFAULT_INITIAL_CAPACITY;
+   }
+   else if ( (self->capacity * EXPANSION_FACTOR) < self->max_capacity )
+   {
+      new_capacity = self->capacity * EXPANSION_FACTOR;
+   }
+   else
+   {
+      new_capacity = self->max_capacity;
+   }
+
+   size_t old_capacity = self->capacity;
+   if ( !vec_grow( self, new_capacity, old_capacity + 1 ) )
+   {
+      return false;
+   }
+   VEC_STAT(self, VecStat_Expansions, 1);
+   VEC_PROBE4( vec_expand, self, old_capacity, (size_t)self->capacity, self->element_size );
+   return true;
+}
+
+/**
+ * @brief Expands the capacity of the vector by a specified number of elements.
+ *
+ * @param self Vector handle.
+ * @param add_len The number of additional elements to expand the capacity by.
+ * @return true if the expansion was successful; false otherwise.
+ */
+static bool vec_expandby( struct Vector * self, size_t add_cap )
+{
+   // Since this is a purely internal function, I will destructively assert at any invalid inputs
+   assert(self != NULL);
+   assert(self->element_size != 0);
+   assert( (self->capacity == 0 && self->arr == NULL) ||
+           (self->capacity >  0 && self->arr != NULL) );
+   assert(self->len <= self->capacity);
+   assert(self->len <= self->max_capacity); 
+   assert(MEM_MGR(self)->realloc != NULL);
+
+   if ( self->flags & VecFlag_Realtime )
+   {
+      vec_rt_violation(self);
+      return false;
+   }
+
+   // If there's no space in the vector, we can't expand
+   if ( add_cap > (self->max_capacity - self->capacity) )
+   {
+      return false;
+   }
+
+   size_t old_capacity = self->capacity;
+   if ( !vec_grow( self, old_capacity + add_cap, old_capacity + add_cap ) )
+   {
+      return false;
+   }
+   VEC_STAT(self, VecStat_Expansions, 1);
+   VEC_PROBE4( vec_expandby, self, old_capacity, (size_t)self->capacity, self->element_size );
+   return true;
+}
+
+/**
+ * @brief Grows the underlying array, preferring the cheapest option available
+ *        from the allocator.
+ *
+ * In order of preference:
+ *    1. Absorb slack that the allocator already handed us (usable_size)
+ *    2. Grow the block without moving it (try_expand_in_place)
+ *    3. realloc, which may have to copy the whole array
+ *
+ * @param self Vector handle.
+ * @param new_capacity The capacity we'd like to end up with.
+ * @param min_capacity The least capacity that satisfies the caller; slack is
+ *                     only absorbed if it reaches at least this much.
+ * @return true if capacity is now at least min_capacity; false otherwise.
+ */
+static bool vec_grow( struct Vector * self, size_t new_capacity, size_t min_capacity )
+{
+   assert(self != NULL);
+   assert(self->element_size != 0);
+   assert(min_capacity <= new_capacity);
+   assert(new_capacity <= self->max_capacity);
+   assert(min_capacity > self->capacity);
+
+   if ( self->flags & VecFlag_StableAddresses )
+   {
+      return vec_stable_commit( self, new_capacity );
+   }
+
+   if ( 0 == self->capacity )
+   {
+      if ( vec_recycle_take(self, min_capacity, self->max_capacity) )
+      {
+         return true;
+      }
+      self->arr = vec_alloc( self, new_capacity * self->element_size );
+      if ( self->arr != NULL )
+      {
+         self->capacity = (vec_len_t)new_capacity;
+         return true;
+      }
+      return false;
+   }
+
+   size_t old_sz = self->element_size * self->capacity;
+
+   if ( MEM_MGR(self)->usable_size != NULL )
+   {
+      size_t usable_capacity = MEM_MGR(self)->usable_size( self->arr, old_sz, MEM_MGR(self)->arena )
+                                 / self->element_size;
+      if ( usable_capacity > self->max_capacity )
+      {
+         usable_capacity = self->max_capacity;
+      }
+      if ( usable_capacity >= min_capacity )
+      {
+         self->capacity = (vec_len_t)usable_capacity;
+         return true;
+      }
+   }
+
+   if ( (MEM_MGR(self)->try_expand_in_place != NULL) &&
+        MEM_MGR(self)->try_expand_in_place( self->arr,
+                                           self->element_size * new_capacity,
+                                           old_sz,
+                                           MEM_MGR(self)->arena ) )
+   {
+      self->capacity = (vec_len_t)new_capacity;
+      return true;
+   }
+
+   void * new_ptr;
+   if ( self->alignment > 0 )
+   {
+      new_ptr = MEM_MGR(self)->realloc_aligned( self->arr,
+                                               self->element_size * new_capacity,
+                                               old_sz,
+                                               self->alignment,
+                                               MEM_MGR(self)->arena );
+   }
+   else
+   {
+      new_ptr = MEM_MGR(self)->realloc( self->arr,
+                                       self->element_size * new_capacity,
+                                       old_sz,
+                                       MEM_MGR(self)->arena );
+   }
+   if ( new_ptr != NULL )
+   {
+      self->arr = new_ptr;
+      self->capacity = (vec_len_t)new_capacity;
+      return true;
+   }
+
+   return false;
+}
+
+/**
+ * @brief Grows a stable vector by committing more of its reservation, which
+ *        leaves every element where it is.
+ *
+ * The reservation covers max_capacity elements and is made on first use. Since
+ * memory is committed in whole pages, capacity is whatever fits in the pages
+ * committed so far, which means the pages committed are always exactly those
+ * spanned by capacity * element_size.
+ *
+ * @param self Vector handle.
+ * @param new_capacity The least capacity to end up with.
+ * @return true if capacity is now at least new_capacity; false otherwise, in
+ *         which case the vector is left untouched.
+ */
+static bool vec_stable_commit( struct Vector * self, size_t new_capacity )
+{
+   assert(self != NULL);
+   assert(self->flags & VecFlag_StableAddresses);
+   assert(new_capacity <= self->max_capacity);
+   assert( (self->capacity == 0 && self->arr == NULL) ||
+           (self->capacity >  0 && self->arr != NULL) );
+
+   bool fresh_reservation = false;
+   if ( NULL == self->arr )
+   {
+      self->arr = ccol_vm_reserve( self->max_capacity * self->element_size );
+      if ( NULL == self->arr )
+      {
+         return false;
+      }
+      fresh_reservation = true;
+   }
+
+   size_t committed = ccol_page_round( self->capacity * self->element_size );
+   size_t new_committed = ccol_page_round( new_capacity * self->element_size );
+   if ( (new_committed > committed) &&
+        !ccol_vm_commit( (uint8_t *)self->arr + committed, new_committed - committed ) )
+   {
+      if ( fresh_reservation )
+      {
+         ccol_vm_release( self->arr, self->max_capacity * self->element_size );
+         self->arr = NULL;
+      }
+      return false;
+   }
+
+   size_t capacity = new_committed / self->element_size;
+   self->capacity = (capacity < self->max_capacity) ? (vec_len_t)capacity : self->max_capacity;
+
+   return true;
+}
+
+/**
+ * @brief Makes sure none of a realtime vector's array will fault on first
+ *        touch, optionally locking it into RAM too.
+ * @param self Vector handle, with its whole array allocated.
+ * @param lock_memory Whether to lock the array into RAM.
+ * @return true on success, false if the array couldn't be locked.
+ */
+static bool vec_rt_prepare( struct Vector * self, bool lock_memory )
+{
+   assert(self != NULL);
+   assert(self->flags & VecFlag_Realtime);
+   assert( (self->arr != NULL) && (self->capacity == self->max_capacity) );
+
+   // Reading a fresh page could map it to the shared zero page, so write to
+   // each one (leaving whatever is there as it is).
+   size_t sz = self->capacity * self->element_size;
+   size_t page_sz = ccol_page_size();
+   volatile uint8_t * bytes = self->arr;
+   for ( size_t offset = 0; offset < sz; offset += page_sz )
+   {
+      bytes[offset] = bytes[offset];
+   }
+   bytes[sz - 1] = bytes[sz - 1];
+
+   if ( lock_memory )
+   {
+      if ( !ccol_vm_lock(self->arr, sz) )
+      {
+         // TODO: Throw exception that the array couldn't be locked
+         return false;
+      }
+      self->flags |= VecFlag_Locked;
+   }
+   return true;
+}
+
+/**
+ * @brief Counts an operation that a realtime vector had to refuse.
+ * @param self Vector handle (regular vectors are left alone).
+ */
+static void vec_rt_violation( struct Vector * self )
+{
+   if ( (self->flags & VecFlag_Realtime) && (self->rt_violations < UINT32_MAX) )
+   {
+      self->rt_violations++;
+   }
+}
+
+/**
+ * @brief Shifts elements in the vector either to the left or right from a given idx.
+ *
+ * @note This function won't automatically expand capacity. Make sure there's
+ *       room before calling this function to shift right, or it will fail.
+ * @note This function will also fail if you try to shift left by more than the
+ *       length of the vector.
+ * @param struct Vector * : Pointer to the Vector structure
+ * @param size_t : The index at which the shift operation begins
+ * @param enum ShiftDir : Direction of shift
+ * @param n : Number of indices to shift by
+ */
+static void shiftn( struct Vector * self, size_t start_idx,
+                    enum ShiftDir direction, size_t n )
+{
+   assert(self != NULL);
+   assert(self->arr != NULL);
+   // To shift right, length must be less than capacity (i.e., shiftn should
+   // only be called after expansions). A full vector may still shift left.
+   assert( (direction == ShiftDir_Left) || (self->len < self->capacity) );
+   // Extra checks to trap paradox states
+   assert(self->element_size > 0);
+   // Don't try to shift data past the data range of the array
+   assert(start_idx < self->len);
+   assert(start_idx < MAX_VEC_LEN);
+   assert(direction < ShiftDir_InvalidDir);
+   assert( (direction == ShiftDir_Right && ((n + self->len) <= self->capacity)) ||
+           (direction == ShiftDir_Left  && (n <= self->len)) );
+
+   uint8_t * old_spot = NULL;
+   uint8_t * new_spot = NULL;
+   if ( direction == ShiftDir_Right )
+   {
+      old_spot = PTR_TO_IDX(self, start_idx);
+      new_spot = PTR_TO_IDX(self, start_idx + n);
+   }
+   else // shift left
+   {
+      old_spot = PTR_TO_IDX(self, start_idx);
+      new_spot = PTR_TO_IDX(self, start_idx - n);
+   }
+   // Use memmove instead of memcpy because shifting means the new state of the
+   // sequence being moved and the old state of that sequence will overlap if
+   // the sequence's length is greater than the amount of shifting. memmove is
+   // specifically made for this kind of operation, whereas memcpy isn't
+   // guaranteed to behave correctly here.
+   size_t shift_bytes = (self->len - start_idx) * self->element_size;
+   memmove( new_spot, old_spot, shift_bytes );
+   VEC_STAT(self, VecStat_ShiftBytes, shift_bytes);
+   VEC_PROBE4( vec_shift, self, start_idx, n, shift_bytes );
+}
+
+/******************************************************************************/
+
+/*************************** Vector Arena Material ****************************/
+
+// The handles live in an array of their own, with the allocation flags kept
+// apart, so that walking over many vectors' metadata stays dense in cache.
+struct VectorPool
+{
+   struct Vector pool[VEC_STRUCT_POOL_SIZE];
+   bool is_allocated[VEC_STRUCT_POOL_SIZE];
+   size_t next_idx;
+   size_t in_use;
+   size_t high_water; // Most slots in use at once (see VectorPoolHighWaterReset)
+};
+
+STATIC struct VectorPool VecPool;
+
+#ifdef VEC_POOL_THREAD_SAFE
+#if !defined(__GNUC__)
+#error "VEC_POOL_THREAD_SAFE relies on GCC-style __atomic builtins"
+#endif
+// Held only for a handful of flag flips, so spinning beats sleeping
+static bool VecPoolLock;
+#define VEC_POOL_LOCK()    while ( __atomic_test_and_set(&VecPoolLock, __ATOMIC_ACQUIRE) ) { }
+#define VEC_POOL_UNLOCK()  __atomic_clear(&VecPoolLock, __ATOMIC_RELEASE)
+#else
+#define VEC_POOL_LOCK()
+#define VEC_POOL_UNLOCK()
+#endif
+
+/**
+ * @brief Index of the pool slot that ptr points to, or VEC_STRUCT_POOL_SIZE if
+ *        ptr doesn't point to the start of a slot.
+ */
+static size_t vec_pool_idx(const struct Vector * ptr)
+{
+   uintptr_t addr = (uintptr_t)ptr;
+   uintptr_t base = (uintptr_t)VecPool.pool;
+   if ( (addr < base) || (((addr - base) % sizeof(struct Vector)) != 0) )
+   {
+      return VEC_STRUCT_POOL_SIZE;
+   }
+
+   size_t idx = (size_t)( (addr - base) / sizeof(struct Vector) );
+   return (idx < VEC_STRUCT_POOL_SIZE) ? idx : VEC_STRUCT_POOL_SIZE;
+}
+
+/**
+ * @brief Allocates a new Vector structure from a static arena.
+ * @return Pointer to the allocated Vector struct if successful, NULL otherwise.
+ */
+STATIC struct Vector * vec_pool_dispatch(void)
+{
+   VEC_POOL_LOCK();
+   assert( VecPool.next_idx < VEC_STRUCT_POOL_SIZE );
+   assert( VecPool.pool != NULL );
+#ifndef NDEBUG
+   // If next idx is allocated, by design, that must mean we are out of vectors.
+   if ( VecPool.is_allocated[VecPool.next_idx] == true )
+   {
+      for ( size_t i = 0; i < VEC_STRUCT_POOL_SIZE; i++ )
+      {
+         assert( VecPool.is_allocated[i] == true );
+      }
+   }
+#endif
+
+   if ( VecPool.is_allocated[VecPool.next_idx] )
+   {
+      VEC_POOL_UNLOCK();
+      VEC_STAT(NULL, VecStat_PoolExhausted, 1);
+      VEC_PROBE1( pool_exhausted, (size_t)VEC_STRUCT_POOL_SIZE );
+      return NULL;
+   }
+
+   struct Vector * new_vec = &VecPool.pool[VecPool.next_idx];
+   VecPool.is_allocated[VecPool.next_idx] = true;
+   VecPool.in_use++;
+   if ( VecPool.in_use > VecPool.high_water )
+   {
+      VecPool.high_water = VecPool.in_use;
+   }
+   VEC_PROBE2( pool_dispatch, new_vec, VecPool.in_use );
+
+   // 🗒️: Potential to place this in a separate asynchronous thread?
+   // Find the next available spot, checking every other slot (incl. the one
+   // just before this one)
+   size_t j = VecPool.next_idx;
+   for ( size_t i = 1; i < VEC_STRUCT_POOL_SIZE; i++ )
+   {
+      j++;
+      if ( j >= VEC_STRUCT_POOL_SIZE ) j = 0; // Wrap-around
+
+      if ( !VecPool.is_allocated[j] )
+      {
+         VecPool.next_idx = j;
+         break;
+      }
+   }
+
+   VEC_POOL_UNLOCK();
+   return new_vec;
+}
+
+STATIC void vec_pool_reclaim(const struct Vector * ptr)
+{
+   if ( NULL == ptr )
+   {
+      return;
+   }
+
+   size_t idx = vec_pool_idx(ptr);
+   if ( idx >= VEC_STRUCT_POOL_SIZE )
+   {
+      // TODO: Raise an exception for attempting to free a random address
+      return;
+   }
+
+   VEC_POOL_LOCK();
+   if ( !VecPool.is_allocated[idx] )
+   {
+      // TODO: Raise exception for attempting to free an unallocated vec
+   }
+   else
+   {
+      VecPool.in_use--;
+   }
+   VecPool.is_allocated[idx] = false;
+   VEC_PROBE2( pool_reclaim, ptr, VecPool.in_use );
+
+   // If the pool was full, next_idx is stuck on an allocated slot
+   if ( VecPool.is_allocated[VecPool.next_idx] )
+   {
+      VecPool.next_idx = idx;
+   }
+   VEC_POOL_UNLOCK();
+}
+
+STATIC bool vec_isalloc(const struct Vector * ptr)
+{
+   size_t idx = vec_pool_idx(ptr);
+   return (idx < VEC_STRUCT_POOL_SIZE) && VecPool.is_allocated[idx];
+}
+
+/**
+ * @brief Lists every vector handed out of the pool.
+ * @param live Where the handles go (room for VEC_STRUCT_POOL_SIZE of them)
+ * @return Number of handles listed
+ */
+static size_t vec_pool_live(struct Vector ** live)
+{
+   size_t n = 0;
+   VEC_POOL_LOCK();
+   for ( size_t i = 0; i < VEC_STRUCT_POOL_SIZE; i++ )
+   {
+      if ( VecPool.is_allocated[i] )
+      {
+         live[n++] = &VecPool.pool[i];
+      }
+   }
+   VEC_POOL_UNLOCK();
+   return n;
+}
+
+/**
+ * @brief Whether two allocators are interchangeable, hook for hook.
+ */
+static bool mem_mgr_same(const struct Allocator * a, const struct Allocator * b)
+{
+   return (a->alloc == b->alloc) &&
+          (a->realloc == b->realloc) &&
+          (a->reclaim == b->reclaim) &&
+          (a->alloca_init == b->alloca_init) &&
+          (a->arena == b->arena) &&
+          (a->alloc_zeroed == b->alloc_zeroed) &&
+          (a->try_expand_in_place == b->try_expand_in_place) &&
+          (a->usable_size == b->usable_size) &&
+          (a->alloc_aligned == b->alloc_aligned) &&
+          (a->realloc_aligned == b->realloc_aligned) &&
+          (a->alloca_deinit == b->alloca_deinit) &&
+          (a->reset == b->reset);
+}
+
+#ifdef VEC_COMPACT_HEADER
+
+// Compact headers point to their allocator rather than carrying a copy, so
+// unmanaged allocators are copied in here instead, once per distinct allocator
+// rather than once per vector. There can't be more distinct allocators in use
+// than there are vectors.
+struct MemMgrTableEntry
+{
+   struct Allocator mem_mgr; // Must stay first (see mem_mgr_unshare)
+   size_t users;
+};
+
+STATIC struct MemMgrTableEntry MemMgrTable[VEC_STRUCT_POOL_SIZE];
+
+/**
+ * @brief Shared copy of an unmanaged allocator, made on first use.
+ * @return The copy, or NULL if the table is full.
+ */
+static struct Allocator * mem_mgr_share(const struct Allocator * mem_mgr)
+{
+   assert(mem_mgr != NULL);
+   assert( !AllocatorIsManaged(mem_mgr) );
+
+   VEC_POOL_LOCK();
+   struct MemMgrTableEntry * vacant = NULL;
+   for ( size_t i = 0; i < VEC_STRUCT_POOL_SIZE; i++ )
+   {
+      struct MemMgrTableEntry * entry = &MemMgrTable[i];
+      if ( 0 == entry->users )
+      {
+         if ( NULL == vacant ) vacant = entry;
+      }
+      else if ( mem_mgr_same(&entry->mem_mgr, mem_mgr) )
+      {
+         entry->users++;
+         VEC_POOL_UNLOCK();
+         return &entry->mem_mgr;
+      }
+   }
+
+   if ( vacant != NULL )
+   {
+      vacant->mem_mgr = *mem_mgr;
+      vacant->users = 1;
+   }
+   VEC_POOL_UNLOCK();
+   return (NULL == vacant) ? NULL : &vacant->mem_mgr;
+}
+
+static void mem_mgr_unshare(struct Allocator * mem_mgr)
+{
+   if ( NULL == mem_mgr )
+   {
+      return;
+   }
+
+   // mem_mgr is the first member of its table entry
+   struct MemMgrTableEntry * entry = (struct MemMgrTableEntry *)(void *)mem_mgr;
+   assert( (entry >= &MemMgrTable[0]) && (entry < &MemMgrTable[VEC_STRUCT_POOL_SIZE]) );
+   VEC_POOL_LOCK();
+   assert(entry->users > 0);
+   entry->users--;
+   VEC_POOL_UNLOCK();
+}
+
+#endif // VEC_COMPACT_HEADER
+
+/****************************** Buffer Recycling ******************************/
+
+// Arrays of freed vectors, oldest first, along with a copy of the allocator to
+// give them back to once they're evicted (the vector being long gone).
+struct RecycledArr
+{
+   void * arr;
+   size_t sz;
+   size_t element_size;
+   size_t alignment;
+   struct Allocator mem_mgr;
+};
+
+static struct RecycledArr Recycled[VEC_RECYCLE_SLOTS];
+static size_t RecycledCount = 0;
+static size_t RecycledSz = 0;
+static size_t RecycleBudget = VEC_RECYCLE_BUDGET;
+
+static size_t recycle_evict(size_t incoming_sz, struct RecycledArr * evicted);
+static void   recycle_release(struct RecycledArr * entries, size_t n);
+
+/******************************************************************************/
+void VectorRecycleSetBudget( size_t budget_bytes )
+{
+   struct RecycledArr evicted[VEC_RECYCLE_SLOTS];
+
+   VEC_POOL_LOCK();
+   RecycleBudget = budget_bytes;
+   size_t n = recycle_evict(0, evicted);
+   VEC_POOL_UNLOCK();
+
+   recycle_release(evicted, n);
+}
+
+/******************************************************************************/
+void VectorRecycleFlush( void )
+{
+   struct RecycledArr evicted[VEC_RECYCLE_SLOTS];
+
+   VEC_POOL_LOCK();
+   size_t n = RecycledCount;
+   memcpy( evicted, Recycled, n * sizeof(struct RecycledArr) );
+   RecycledCount = 0;
+   RecycledSz = 0;
+   VEC_POOL_UNLOCK();
+
+   recycle_release(evicted, n);
+}
+
+/******************************************************************************/
+size_t VectorRecycledBytes( void )
+{
+   VEC_POOL_LOCK();
+   size_t sz = RecycledSz;
+   VEC_POOL_UNLOCK();
+   return sz;
+}
+
+/**
+ * @brief Keeps the array of a vector that's being freed for reuse, if
+ *        recycling is on and it fits in the budget.
+ * @param self Vector handle, about to be freed.
+ * @return true if the array was kept (the vector no longer owns it); false if
+ *         it's still up to the caller to release it.
+ */
+static bool vec_recycle_put( struct Vector * self )
+{
+   assert(self != NULL);
+
+   // Reservations and locked arrays aren't allocator blocks like the rest.
+   // And since nothing tells us when an arena (or a managed allocator) goes
+   // away, only arrays from global allocators can safely outlive their vector.
+   const struct Allocator * mem_mgr = vec_allocator(self);
+   if ( (NULL == self->arr) ||
+        (self->flags & (VecFlag_StableAddresses | VecFlag_Locked)) ||
+        (mem_mgr->arena != NULL) || AllocatorIsManaged(mem_mgr) )
+   {
+      return false;
+   }
+
+   size_t sz = self->capacity * self->element_size;
+   struct RecycledArr evicted[VEC_RECYCLE_SLOTS];
+
+   VEC_POOL_LOCK();
+   if ( sz > RecycleBudget )
+   {
+      VEC_POOL_UNLOCK();
+      return false;
+   }
+   size_t n = recycle_evict(sz, evicted);
+
+   struct RecycledArr * entry = &Recycled[RecycledCount++];
+   entry->arr = self->arr;
+   entry->sz = sz;
+   entry->element_size = self->element_size;
+   entry->alignment = self->alignment;
+   entry->mem_mgr = *MEM_MGR(self);
+   RecycledSz += sz;
+   VEC_POOL_UNLOCK();
+
+   recycle_release(evicted, n);
+
+   self->arr = NULL;
+   self->capacity = 0;
+   return true;
+}
+
+/**
+ * @brief Hands a kept array over to a vector that has none, if one fits: the
+ *        smallest one from the same allocator, for the same element size and
+ *        alignment, with room for min_capacity to max_capacity elements.
+ * @param self Vector handle, without an array.
+ * @param min_capacity The least capacity that will do.
+ * @param max_capacity The most capacity to take on (at most the vector's max
+ *                     capacity, so that its capacity covers the whole array).
+ * @return true if self now has an array (and its capacity is set); false if
+ *         none fit, in which case self is left untouched.
+ */
+static bool vec_recycle_take( struct Vector * self, size_t min_capacity, size_t max_capacity )
+{
+   assert(self != NULL);
+   assert( !(self->flags & VecFlag_StableAddresses) );
+   assert( max_capacity <= self->max_capacity );
+
+   const struct Allocator * mem_mgr = vec_allocator(self);
+   size_t min_sz = min_capacity * self->element_size;
+   size_t max_sz = max_capacity * self->element_size;
+
+   VEC_POOL_LOCK();
+   size_t best = RecycledCount;
+   for ( size_t i = 0; i < RecycledCount; i++ )
+   {
+      const struct RecycledArr * entry = &Recycled[i];
+      if ( (entry->element_size == self->element_size) &&
+           (entry->alignment == self->alignment) &&
+           (entry->sz >= min_sz) && (entry->sz <= max_sz) &&
+           ( (best == RecycledCount) || (entry->sz < Recycled[best].sz) ) &&
+           mem_mgr_same(&entry->mem_mgr, mem_mgr) )
+      {
+         best = i;
+      }
+   }
+
+   if ( best == RecycledCount )
+   {
+      VEC_POOL_UNLOCK();
+      return false;
+   }
+
+   struct RecycledArr taken = Recycled[best];
+   memmove( &Recycled[best], &Recycled[best + 1],
+            (RecycledCount - best - 1) * sizeof(struct RecycledArr) );
+   RecycledCount--;
+   RecycledSz -= taken.sz;
+   VEC_POOL_UNLOCK();
+
+   self->arr = taken.arr;
+   self->capacity = (vec_len_t)(taken.sz / self->element_size);
+   return true;
+}
+
+/**
+ * @brief Takes the oldest kept arrays out until there's a free slot and
+ *        incoming_sz more bytes fit in the budget. Call with the lock held.
+ * @param incoming_sz Bytes about to be kept (0 to just honor the budget).
+ * @param evicted Where the arrays taken out go, for recycle_release.
+ * @return Number of arrays taken out.
+ */
+static size_t recycle_evict( size_t incoming_sz, struct RecycledArr * evicted )
+{
+   size_t n = 0;
+   while ( (RecycledCount > 0) &&
+           ( (RecycledSz > RecycleBudget) ||
+             (incoming_sz > (RecycleBudget - RecycledSz)) ||
+             ( (incoming_sz > 0) && (VEC_RECYCLE_SLOTS == RecycledCount) ) ) )
+   {
+      evicted[n++] = Recycled[0];
+      RecycledSz -= Recycled[0].sz;
+      RecycledCount--;
+      memmove( &Recycled[0], &Recycled[1], RecycledCount * sizeof(struct RecycledArr) );
+   }
+   return n;
+}
+
+/**
+ * @brief Gives arrays taken out of the cache back to their allocators.
+ */
+static void recycle_release( struct RecycledArr * entries, size_t n )
+{
+   for ( size_t i = 0; i < n; i++ )
+   {
+      struct RecycledArr * entry = &entries[i];
+      entry->mem_mgr.reclaim( entry->arr, entry->sz, entry->mem_mgr.arena );
+   }
+}
+
+/***************************** Operation Counters *****************************/
+
+#ifdef CCOL_STATS
+
+// Running totals are kept per thread, so that counting never contends: each
+// thread claims a slot of its own on first use, and only ever adds to it.
+// Threads beyond the last slot all share it, which they update atomically.
+#if defined(__GNUC__)
+#define VEC_STATS_THREAD_LOCAL __thread
+#define VEC_STATS_LOAD(counter)        __atomic_load_n( &(counter), __ATOMIC_RELAXED )
+#define VEC_STATS_STORE(counter, val)  __atomic_store_n( &(counter), (val), __ATOMIC_RELAXED )
+#define VEC_STATS_ADD(counter, n)      __atomic_add_fetch( &(counter), (n), __ATOMIC_RELAXED )
+#define VEC_STATS_CLAIM_SLOT()         __atomic_fetch_add( &VecStatsSlotsUsed, 1, __ATOMIC_RELAXED )
+#else
+// Without thread-local storage or atomics, every thread shares the one slot
+#undef VEC_STATS_THREAD_SLOTS
+#define VEC_STATS_THREAD_SLOTS 1
+#define VEC_STATS_THREAD_LOCAL
+#define VEC_STATS_LOAD(counter)        (counter)
+#define VEC_STATS_STORE(counter, val)  ( (counter) = (val) )
+#define VEC_STATS_ADD(counter, n)      ( (counter) += (n) )
+#define VEC_STATS_CLAIM_SLOT()         ( VecStatsSlotsUsed++ )
+#endif
+
+#define VEC_STATS_SHARED_SLOT ( &VecStatsSlots[VEC_STATS_THREAD_SLOTS - 1] )
+
+static uint64_t VecStatsSlots[VEC_STATS_THREAD_SLOTS][VecStat_Count];
+static size_t VecStatsSlotsUsed = 0;
+static VEC_STATS_THREAD_LOCAL uint64_t (* ThisThreadStats)[VecStat_Count] = NULL;
+
+static size_t stats_export_line( char * buf, size_t buf_sz, size_t used,
+                                 const struct Vector * vec,
+                                 const struct VectorStats * stats );
+
+#endif // CCOL_STATS
+
+/******************************************************************************/
+bool VectorStatsGet( const struct Vector * self, struct VectorStats * stats )
+{
+   if ( NULL == stats )
+   {
+      return false;
+   }
+   memset( stats, 0, sizeof(struct VectorStats) );
+
+#ifdef CCOL_STATS
+   uint64_t counts[VecStat_Count] = {0};
+   if ( self != NULL )
+   {
+      if ( !vec_isalloc(self) )
+      {
+         return false;
+      }
+      memcpy( counts, self->stats, sizeof(self->stats) );
+   }
+   else
+   {
+      size_t used = VEC_STATS_LOAD(VecStatsSlotsUsed);
+      size_t num_slots = (used < VEC_STATS_THREAD_SLOTS) ? used : VEC_STATS_THREAD_SLOTS;
+      for ( size_t slot = 0; slot < num_slots; slot++ )
+      {
+         for ( size_t i = 0; i < VecStat_Count; i++ )
+         {
+            counts[i] += VEC_STATS_LOAD(VecStatsSlots[slot][i]);
+         }
+      }
+   }
+
+   stats->pushes = counts[VecStat_Pushes];
+   stats->inserts = counts[VecStat_Inserts];
+   stats->removes = counts[VecStat_Removes];
+   stats->expansions = counts[VecStat_Expansions];
+   stats->shift_bytes = counts[VecStat_ShiftBytes];
+   stats->copy_bytes = counts[VecStat_CopyBytes];
+   stats->pool_exhausted = counts[VecStat_PoolExhausted];
+   return true;
+#else
+   (void)self;
+   return false;
+#endif
+}
+
+/******************************************************************************/
+void VectorStatsReset( struct Vector * self )
+{
+#ifdef CCOL_STATS
+   if ( self != NULL )
+   {
+      if ( vec_isalloc(self) )
+      {
+         VEC_STATS_CLEAR(self);
+      }
+      return;
+   }
+
+   for ( size_t slot = 0; slot < VEC_STATS_THREAD_SLOTS; slot++ )
+   {
+      for ( size_t i = 0; i < VecStat_Count; i++ )
+      {
+         VEC_STATS_STORE(VecStatsSlots[slot][i], 0);
+      }
+   }
+
+   struct Vector * live[VEC_STRUCT_POOL_SIZE];
+   size_t num_live = vec_pool_live(live);
+   for ( size_t i = 0; i < num_live; i++ )
+   {
+      VEC_STATS_CLEAR(live[i]);
+   }
+#else
+   (void)self;
+#endif
+}
+
+/******************************************************************************/
+size_t VectorStatsExport( char * buf, size_t buf_sz )
+{
+   if ( NULL == buf )
+   {
+      buf_sz = 0;
+   }
+   else if ( buf_sz > 0 )
+   {
+      buf[0] = '\0';
+   }
+
+#ifdef CCOL_STATS
+   struct VectorStats stats;
+   (void)VectorStatsGet(NULL, &stats);
+   size_t used = stats_export_line(buf, buf_sz, 0, NULL, &stats);
+
+   struct Vector * live[VEC_STRUCT_POOL_SIZE];
+   size_t num_live = vec_pool_live(live);
+   for ( size_t i = 0; i < num_live; i++ )
+   {
+      if ( VectorStatsGet(live[i], &stats) )
+      {
+         used = stats_export_line(buf, buf_sz, used, live[i], &stats);
+      }
+   }
+   return used;
+#else
+   int len = snprintf(buf, buf_sz, "vector_stats disabled (build with CCOL_STATS)\n");
+   return (len > 0) ? (size_t)len : 0;
+#endif
 }
 
+#ifdef CCOL_STATS
+
 /**
- * @brief Shifts elements in the vector either to the left or right from a given idx.
- *
- * @note This function won't automatically expand capacity. Make sure there's
- *       room before calling this function to shift right, or it will fail.
- * @note This function will also fail if you try to shift left by more than the
- *       length of the vector.
- * @param struct Vector * : Pointer to the Vector structure
- * @param size_t : The index at which the shift operation begins
- * @param enum ShiftDir : Direction of shift
- * @param n : Number of indices to shift by
+ * @brief Adds n to a vector's counter (if vec isn't NULL), and to the calling
+ *        thread's running total.
  */
-static void shiftn( struct Vector * self, size_t start_idx,
-                    enum ShiftDir direction, size_t n )
+static void vec_stat( const struct Vector * vec, enum VecStat stat, uint64_t n )
 {
-   assert(self != NULL);
-   assert(self->arr != NULL);
-   // Length must be less than capacity (i.e., shiftn should only be called after expansions)
-   assert(self->len < self->capacity);
-   // Extra checks to trap paradox states
-   assert(self->element_size > 0);
-   // Don't try to shift data past the data range of the array
-   assert(start_idx < self->len);
-   assert(start_idx < MAX_VEC_LEN);
-   assert(direction < ShiftDir_InvalidDir);
-   assert( (direction == ShiftDir_Right && ((n + self->len) <= self->capacity)) ||
-           (direction == ShiftDir_Left  && (n <= self->len)) );
+   if ( vec != NULL )
+   {
+      assert(stat < VecStat_PerVector);
+      // Counting doesn't change the vector's contents, even if it's const here
+      ((struct Vector *)vec)->stats[stat] += n;
+   }
 
-   uint8_t * old_spot = NULL;
-   uint8_t * new_spot = NULL;
-   if ( direction == ShiftDir_Right )
+   if ( NULL == ThisThreadStats )
    {
-      old_spot = PTR_TO_IDX(self, start_idx);
-      new_spot = PTR_TO_IDX(self, start_idx + n);
+      size_t slot = VEC_STATS_CLAIM_SLOT();
+      ThisThreadStats = &VecStatsSlots[ (slot < VEC_STATS_THREAD_SLOTS) ? slot : (VEC_STATS_THREAD_SLOTS - 1) ];
    }
-   else // shift left
+
+   if ( VEC_STATS_SHARED_SLOT == ThisThreadStats )
    {
-      old_spot = PTR_TO_IDX(self, start_idx);
-      new_spot = PTR_TO_IDX(self, start_idx - n);
+      VEC_STATS_ADD( (*ThisThreadStats)[stat], n );
    }
-   // Use memmove instead of memcpy because shifting means the new state of the
-   // sequence being moved and the old state of that sequence will overlap if
-   // the sequence's length is greater than the amount of shifting. memmove is
-   // specifically made for this kind of operation, whereas memcpy isn't
-   // guaranteed to behave correctly here.
-   memmove( new_spot, old_spot, (self->len - start_idx) * self->element_size );
+   else
+   {
+      // No other thread adds to this slot, so there's no need for an atomic add
+      VEC_STATS_STORE( (*ThisThreadStats)[stat], (*ThisThreadStats)[stat] + n );
+   }
+}
+
+/**
+ * @brief Appends one line of VectorStatsExport (the totals if vec is NULL).
+ * @return The updated length of the text, whether or not it all fit in buf.
+ */
+static size_t stats_export_line( char * buf, size_t buf_sz, size_t used,
+                                 const struct Vector * vec,
+                                 const struct VectorStats * stats )
+{
+   char * dst = (used < buf_sz) ? (buf + used) : NULL;
+   size_t room = (used < buf_sz) ? (buf_sz - used) : 0;
+
+   int len;
+   if ( NULL == vec )
+   {
+      len = snprintf( dst, room,
+                      "vector_stats total pushes=%llu inserts=%llu removes=%llu expansions=%llu"
+                      " shift_bytes=%llu copy_bytes=%llu pool_exhausted=%llu\n",
+                      (unsigned long long)stats->pushes,
+                      (unsigned long long)stats->inserts,
+                      (unsigned long long)stats->removes,
+                      (unsigned long long)stats->expansions,
+                      (unsigned long long)stats->shift_bytes,
+                      (unsigned long long)stats->copy_bytes,
+                      (unsigned long long)stats->pool_exhausted );
+   }
+   else
+   {
+      len = snprintf( dst, room,
+                      "vector_stats vector=%zu element_size=%zu len=%zu capacity=%zu"
+                      " pushes=%llu inserts=%llu removes=%llu expansions=%llu"
+                      " shift_bytes=%llu copy_bytes=%llu\n",
+                      vec_pool_idx(vec),
+                      vec->element_size, (size_t)vec->len, (size_t)vec->capacity,
+                      (unsigned long long)stats->pushes,
+                      (unsigned long long)stats->inserts,
+                      (unsigned long long)stats->removes,
+                      (unsigned long long)stats->expansions,
+                      (unsigned long long)stats->shift_bytes,
+                      (unsigned long long)stats->copy_bytes );
+   }
+   return used + ( (len > 0) ? (size_t)len : 0 );
 }
 
+#endif // CCOL_STATS
+
+/***************************** Pool Introspection *****************************/
+
+static size_t pool_rank( struct Vector ** ranked, size_t n, bool by_slack );
+static size_t pool_held_bytes( const struct Vector * vec, bool slack_only );
+
 /******************************************************************************/
+bool VectorPoolInfoGet( struct VectorPoolInfo * info )
+{
+   if ( NULL == info )
+   {
+      return false;
+   }
+   memset( info, 0, sizeof(struct VectorPoolInfo) );
 
-/*************************** Vector Arena Material ****************************/
+   struct Vector * live[VEC_STRUCT_POOL_SIZE];
+   size_t num_live = vec_pool_live(live);
+
+   VEC_POOL_LOCK();
+   size_t high_water = VecPool.high_water;
+   VEC_POOL_UNLOCK();
+
+   info->pool_size = VEC_STRUCT_POOL_SIZE;
+   info->pool_bytes = sizeof(VecPool);
+#ifdef VEC_COMPACT_HEADER
+   info->pool_bytes += sizeof(MemMgrTable);
+#endif
+   info->in_use = num_live;
+   info->high_water = (high_water > num_live) ? high_water : num_live;
+   for ( size_t i = 0; i < num_live; i++ )
+   {
+      info->capacity_bytes += pool_held_bytes(live[i], false);
+      info->slack_bytes += pool_held_bytes(live[i], true);
+   }
+   info->length_bytes = info->capacity_bytes - info->slack_bytes;
+   return true;
+}
 
-struct VectorPoolItem
+/******************************************************************************/
+void VectorPoolHighWaterReset( void )
 {
-   struct Vector vec;
-   bool is_allocated;
-};
+   VEC_POOL_LOCK();
+   VecPool.high_water = VecPool.in_use;
+   VEC_POOL_UNLOCK();
+}
 
-struct VectorPool
+/******************************************************************************/
+size_t VectorPoolLargest( struct Vector ** largest, size_t n )
 {
-   struct VectorPoolItem pool[VEC_STRUCT_POOL_SIZE];
-   size_t next_idx;
-};
+   return pool_rank( largest, n, false );
+}
 
-STATIC struct VectorPool VecPool;
+/******************************************************************************/
+size_t VectorPoolMostSlack( struct Vector ** slackest, size_t n )
+{
+   return pool_rank( slackest, n, true );
+}
 
 /**
- * @brief Allocates a new Vector structure from a static arena.
- * @return Pointer to the allocated Vector struct if successful, NULL otherwise.
+ * @brief Lists the (up to) n live vectors holding the most bytes of capacity,
+ *        or of slack, most first. Vectors holding none aren't listed.
+ * @return Number of vectors listed
  */
-STATIC struct Vector * vec_pool_dispatch(void)
+static size_t pool_rank( struct Vector ** ranked, size_t n, bool by_slack )
 {
-   assert( VecPool.next_idx < VEC_STRUCT_POOL_SIZE );
-   assert( VecPool.pool != NULL );
-#ifndef NDEBUG
-   // If next idx is allocated, by design, that must mean we are out of vectors.
-   if ( VecPool.pool[VecPool.next_idx].is_allocated == true )
+   if ( (NULL == ranked) || (0 == n) )
    {
-      for ( size_t i = 0; i < VEC_STRUCT_POOL_SIZE; i++ )
+      return 0;
+   }
+
+   struct Vector * live[VEC_STRUCT_POOL_SIZE];
+   size_t num_live = vec_pool_live(live);
+   size_t num_ranked = 0;
+   for ( size_t i = 0; i < num_live; i++ )
+   {
+      size_t key = pool_held_bytes(live[i], by_slack);
+      if ( 0 == key )
+      {
+         continue;
+      }
+
+      // Insert into the top n so far (the pool is small, so a linear walk does),
+      // after any that are just as big
+      size_t pos = num_ranked;
+      while ( (pos > 0) && (pool_held_bytes(ranked[pos - 1], by_slack) < key) )
+      {
+         pos--;
+      }
+      if ( pos >= n )
+      {
+         continue;
+      }
+
+      size_t num_kept = (num_ranked < n) ? num_ranked : (n - 1);
+      memmove( &ranked[pos + 1], &ranked[pos], (num_kept - pos) * sizeof(struct Vector *) );
+      ranked[pos] = live[i];
+      if ( num_ranked < n )
       {
-         assert( VecPool.pool[i].is_allocated == true );
+         num_ranked++;
       }
    }
+   return num_ranked;
+}
+
+/**
+ * @brief Bytes of capacity a vector holds, or of those, the bytes not holding
+ *        elements.
+ */
+static size_t pool_held_bytes( const struct Vector * vec, bool slack_only )
+{
+   size_t num_elements = slack_only ? (size_t)(vec->capacity - vec->len) : (size_t)vec->capacity;
+   return num_elements * vec->element_size;
+}
+
+/***************************** Operation Tracing ******************************/
+
+#ifdef CCOL_TRACE
+
+#if defined(__GNUC__)
+#define VEC_TRACE_THREAD_LOCAL   __thread
+#else
+#define VEC_TRACE_THREAD_LOCAL
 #endif
 
-   if ( VecPool.pool[VecPool.next_idx].is_allocated )
+// Records are written without a lock of ours: stdio locks the FILE around
+// each fwrite, and each call's records go out in a single fwrite. The lock
+// only serializes starting and stopping, and writers count themselves in, so
+// that VectorTraceStop can wait for those still writing before it closes the
+// file. Neither waits on I/O while holding the handle pool's lock.
+#ifdef VEC_POOL_THREAD_SAFE
+static bool VecTraceLock;
+static unsigned int VecTraceWriters = 0;
+#define VEC_TRACE_LOCK()             while ( __atomic_test_and_set(&VecTraceLock, __ATOMIC_ACQUIRE) ) { }
+#define VEC_TRACE_UNLOCK()           __atomic_clear(&VecTraceLock, __ATOMIC_RELEASE)
+// Checked on every call, before counting in
+#define VEC_TRACE_FILE()             __atomic_load_n( &VecTraceFile, __ATOMIC_RELAXED )
+// Sequentially consistent, so that a writer counted in either sees the file
+// cleared or is waited for (and the drain sees whatever it wrote)
+#define VEC_TRACE_SET_FILE(file)     __atomic_store_n( &VecTraceFile, (file), __ATOMIC_SEQ_CST )
+#define VEC_TRACE_WRITER_ENTER()     __atomic_add_fetch( &VecTraceWriters, 1u, __ATOMIC_SEQ_CST )
+#define VEC_TRACE_WRITER_FILE()      __atomic_load_n( &VecTraceFile, __ATOMIC_SEQ_CST )
+#define VEC_TRACE_WRITER_LEAVE()     __atomic_sub_fetch( &VecTraceWriters, 1u, __ATOMIC_RELEASE )
+#define VEC_TRACE_WRITERS_DRAIN()    while ( __atomic_load_n(&VecTraceWriters, __ATOMIC_ACQUIRE) > 0 ) { }
+#define VEC_TRACE_SET_FAILED()       __atomic_store_n( &VecTraceWriteFailed, true, __ATOMIC_RELAXED )
+#else
+#define VEC_TRACE_LOCK()
+#define VEC_TRACE_UNLOCK()
+#define VEC_TRACE_FILE()             ( VecTraceFile )
+#define VEC_TRACE_SET_FILE(file)     ( VecTraceFile = (file) )
+#define VEC_TRACE_WRITER_ENTER()
+#define VEC_TRACE_WRITER_FILE()      ( VecTraceFile )
+#define VEC_TRACE_WRITER_LEAVE()
+#define VEC_TRACE_WRITERS_DRAIN()
+#define VEC_TRACE_SET_FAILED()       ( VecTraceWriteFailed = true )
+#endif
+
+static FILE * VecTraceFile = NULL;
+static bool VecTraceWriteFailed = false;
+static VEC_TRACE_THREAD_LOCAL unsigned int VecTraceNesting = 0;
+
+static size_t trace_put_varint( uint8_t * dst, uint64_t val );
+
+#endif // CCOL_TRACE
+
+/******************************************************************************/
+bool VectorTraceStart( const char * path )
+{
+#ifdef CCOL_TRACE
+   if ( NULL == path )
    {
-      return NULL;
+      return false;
    }
 
-   struct Vector * new_vec = &VecPool.pool[VecPool.next_idx].vec;
-   VecPool.pool[VecPool.next_idx].is_allocated = true;
+   FILE * file = fopen(path, "wb");
+   if ( NULL == file )
+   {
+      return false;
+   }
+   if ( fwrite(VECTOR_TRACE_MAGIC, 1, VECTOR_TRACE_MAGIC_LEN, file) != VECTOR_TRACE_MAGIC_LEN )
+   {
+      (void)fclose(file);
+      return false;
+   }
 
-   // 🗒️: Potential to place this in a separate asynchronous thread?
-   // Find the next available spot
-   size_t j = VecPool.next_idx;
-   for ( size_t i = 1; i < VEC_STRUCT_POOL_SIZE; i++, j++ )
+   VEC_TRACE_LOCK();
+   bool started = (NULL == VecTraceFile);
+   if ( started )
    {
-      if ( j >= VEC_STRUCT_POOL_SIZE ) j = 0; // Wrap-around
+      VecTraceWriteFailed = false;
+      VEC_TRACE_SET_FILE(file);
+   }
+   VEC_TRACE_UNLOCK();
 
-      if ( !VecPool.pool[j].is_allocated )
-      {
-         VecPool.next_idx = j;
-         break;
-      }
+   if ( !started )
+   {
+      (void)fclose(file);
+   }
+   return started;
+#else
+   (void)path;
+   return false;
+#endif
+}
+
+/******************************************************************************/
+bool VectorTraceStop( void )
+{
+#ifdef CCOL_TRACE
+   VEC_TRACE_LOCK();
+   FILE * file = VecTraceFile;
+   VEC_TRACE_SET_FILE(NULL);
+   if ( file != NULL )
+   {
+      // Calls that already counted themselves in may still be writing
+      VEC_TRACE_WRITERS_DRAIN();
    }
+   bool written = !VecTraceWriteFailed;
+   VEC_TRACE_UNLOCK();
 
-   return new_vec;
+   if ( NULL == file )
+   {
+      return false;
+   }
+   // fclose flushes what's still buffered, which may fail too
+   return (0 == fclose(file)) && written;
+#else
+   return false;
+#endif
 }
 
-STATIC void vec_pool_reclaim(const struct Vector * ptr)
+/******************************************************************************/
+size_t VectorTraceDecode( const void * buf, size_t buf_sz, struct VectorTraceRecord * rec )
 {
-   if ( NULL == ptr )
+   if ( (NULL == buf) || (0 == buf_sz) || (NULL == rec) )
    {
-      return;
+      return 0;
    }
 
-   // Find the vector address that matches this pointer
-   bool found = false;
-   for ( size_t i = 0; i < VEC_STRUCT_POOL_SIZE; i++ )
+   const uint8_t * bytes = buf;
+   unsigned int op = bytes[0] & 0x1Fu;
+   unsigned int num_fields = (unsigned int)(bytes[0] >> 5);
+   if ( (0 == op) || (op >= (unsigned int)VectorTraceOp_Count) || (num_fields > 5) )
+   {
+      return 0;
+   }
+
+   uint64_t fields[5] = {0};
+   size_t used = 1;
+   for ( unsigned int i = 0; i < num_fields; i++ )
    {
-      if ( ptr == &VecPool.pool[i].vec )
+      uint64_t val = 0;
+      unsigned int shift = 0;
+      uint8_t byte;
+      do
       {
-         found = true;
-         if ( !VecPool.pool[i].is_allocated )
+         if ( (used >= buf_sz) || (shift >= 64) )
          {
-            // TODO: Raise exception for attempting to free an unallocated vec
+            return 0;
          }
-         VecPool.pool[i].is_allocated = false;
-         break;
-      }
+         byte = bytes[used++];
+         val |= (uint64_t)(byte & 0x7Fu) << shift;
+         shift += 7;
+      } while ( byte & 0x80u );
+      fields[i] = val;
    }
 
-   if ( !found )
+   rec->op = (enum VectorTraceOp)op;
+   rec->handle = fields[0];
+   memcpy( rec->args, &fields[1], sizeof(rec->args) );
+   return used;
+}
+
+#ifdef CCOL_TRACE
+
+/**
+ * @brief Writes val as LEB128 (7 bits a byte, least significant first, with
+ *        the top bit set on every byte but the last).
+ * @return Bytes written (at most 10)
+ */
+static size_t trace_put_varint( uint8_t * dst, uint64_t val )
+{
+   size_t len = 0;
+   while ( val >= 0x80u )
    {
-      // TODO: Raise an exception for attempting to free a random address
+      dst[len++] = (uint8_t)(val | 0x80u);
+      val >>= 7;
    }
+   dst[len++] = (uint8_t)val;
+   return len;
 }
 
-STATIC bool vec_isalloc(const struct Vector * ptr)
+/**
+ * @brief Encodes a record, leaving out trailing fields that are 0.
+ * @return Bytes written (at most VECTOR_TRACE_RECORD_MAX)
+ */
+static size_t trace_put_record( uint8_t * dst, enum VectorTraceOp op, const uint64_t fields[5] )
 {
-   for ( size_t i = 0; i < VEC_STRUCT_POOL_SIZE; i++ )
+   size_t num_fields = 5;
+   while ( 0 == fields[num_fields - 1] )
+   {
+      num_fields--;
+   }
+
+   dst[0] = (uint8_t)( (num_fields << 5) | (size_t)op );
+   size_t len = 1;
+   for ( size_t i = 0; i < num_fields; i++ )
+   {
+      len += trace_put_varint( &dst[len], fields[i] );
+   }
+   return len;
+}
+
+/**
+ * @brief Writes encoded records to the trace in one fwrite, so that records
+ *        from other threads can't land in between them.
+ */
+static void trace_write( const uint8_t * recs, size_t len )
+{
+   VEC_TRACE_WRITER_ENTER();
+   FILE * file = VEC_TRACE_WRITER_FILE();
+   if ( (file != NULL) && (fwrite(recs, 1, len, file) != len) )
+   {
+      VEC_TRACE_SET_FAILED();
+   }
+   VEC_TRACE_WRITER_LEAVE();
+}
+
+/**
+ * @brief Appends a record of a call to the trace, if one is being recorded and
+ *        the call wasn't made from within another one.
+ */
+static void vec_trace( enum VectorTraceOp op, const struct Vector * vec,
+                       uint64_t a, uint64_t b, uint64_t c, uint64_t d )
+{
+   if ( (NULL == VEC_TRACE_FILE()) || (VecTraceNesting > 0) )
+   {
+      return;
+   }
+
+   const uint64_t fields[5] = { vec_trace_handle(vec), a, b, c, d };
+   if ( 0 == fields[0] )
+   {
+      return; // Nothing a replay could call it on
+   }
+
+   uint8_t rec[VECTOR_TRACE_RECORD_MAX];
+   trace_write( rec, trace_put_record(rec, op, fields) );
+}
+
+/**
+ * @brief Appends the New record of a vector created with attributes, followed
+ *        by a NewAttr record of them if any are set.
+ */
+static void vec_trace_new( const struct Vector * vec, uint64_t a, uint64_t b,
+                           uint64_t c, uint64_t d, const struct VectorAttr * attr )
+{
+   if ( (NULL == VEC_TRACE_FILE()) || (VecTraceNesting > 0) )
+   {
+      return;
+   }
+
+   const uint64_t new_fields[5] = { vec_trace_handle(vec), a, b, c, d };
+   if ( 0 == new_fields[0] )
+   {
+      return;
+   }
+
+   uint8_t recs[2 * VECTOR_TRACE_RECORD_MAX];
+   size_t len = trace_put_record(recs, VectorTraceOp_New, new_fields);
+   if ( attr != NULL )
    {
-      if ( ptr == &VecPool.pool[i].vec )
+      uint64_t flags = ( attr->stable_addresses ? VECTOR_TRACE_ATTR_STABLE_ADDRESSES : 0u ) |
+                       ( attr->realtime ? VECTOR_TRACE_ATTR_REALTIME : 0u ) |
+                       ( attr->lock_memory ? VECTOR_TRACE_ATTR_LOCK_MEMORY : 0u );
+      const uint64_t attr_fields[5] = { new_fields[0], flags, (uint64_t)attr->alignment, 0, 0 };
+      if ( (flags != 0) || (attr->alignment != 0) )
       {
-         return VecPool.pool[i].is_allocated;
+         len += trace_put_record(&recs[len], VectorTraceOp_NewAttr, attr_fields);
       }
    }
+   trace_write(recs, len);
+}
 
-   return false;
+/**
+ * @brief Handle of a vector in the trace: its pool slot + 1, or 0 for none.
+ * @note A slot is reused once its vector is freed, and so is its handle: a
+ *       replay takes a handle to mean whichever vector was last created with it.
+ */
+static uint64_t vec_trace_handle( const struct Vector * vec )
+{
+   size_t idx = (NULL == vec) ? VEC_STRUCT_POOL_SIZE : vec_pool_idx(vec);
+   return (idx < VEC_STRUCT_POOL_SIZE) ? (uint64_t)idx + 1 : 0;
+}
+
+/**
+ * @brief Keeps calls from being recorded while entering is true, for calls
+ *        made from within a call that's already been recorded.
+ */
+static void vec_trace_nest( bool entering )
+{
+   if ( entering )
+   {
+      VecTraceNesting++;
+   }
+   else
+   {
+      assert(VecTraceNesting > 0);
+      VecTraceNesting--;
+   }
 }
 
+#endif // CCOL_TRACE
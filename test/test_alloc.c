@@ -0,0 +1,1535 @@
+/*!
+ * @file    test_alloc.c
+ * @brief   Test file for the ready-made allocators
+ *
+ * @author  Abdullah Almosalami @memphis242
+ * @date    Fri Oct 16, 2026
+ * @copyright MIT License
+ */
+
+/* File Inclusions */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unity/unity.h>
+#include <unity/unity_memory.h>
+
+#include "vector.h"
+#include "alloc_mmap.h"
+#include "alloc_bump.h"
+#include "alloc_slab.h"
+#include "alloc_tlsf.h"
+#include "alloc_tlheap.h"
+#include "alloc_stats.h"
+
+/* Local Macro Definitions */
+#define ARR_LEN(arr) ( sizeof(arr) / sizeof(arr[0]) )
+
+/* Datatypes */
+
+/* Local Variables */
+
+/* Forward Function Declarations */
+
+void setUp(void);
+void tearDown(void);
+
+static void fill_pattern(uint8_t * buf, size_t len, uint8_t seed);
+static bool has_pattern(const uint8_t * buf, size_t len, uint8_t seed);
+
+void test_MmapAlloc_BelowAndAboveThreshold(void);
+void test_MmapAlloc_ZeroedAboveThreshold(void);
+void test_MmapRealloc_GrowWithinMappedRange(void);
+void test_MmapRealloc_CrossThresholdUpAndDown(void);
+void test_MmapRealloc_NullOldPtr(void);
+void test_MmapUsableSize_NeverCrossesThreshold(void);
+void test_MmapTryExpandInPlace(void);
+void test_MmapAllocator_VectorGrowsPastThreshold(void);
+void test_MmapAllocAligned(void);
+void test_MmapReallocAligned_CrossThreshold(void);
+void test_MmapHugePages_AlignedAndRounded(void);
+void test_MmapHugePages_ExplicitOrFallback(void);
+void test_MmapAllocator_VectorOnHugePages(void);
+
+void test_BumpAlloc_AlignedUntilExhausted(void);
+void test_BumpAllocAligned(void);
+void test_BumpRealloc_LastBlockInPlace(void);
+void test_BumpRealloc_OlderBlockCopies(void);
+void test_BumpReset(void);
+void test_BumpAllocator_SequentialVectorsGrowInPlace(void);
+void test_BumpAllocator_FreeAllWithResetsArena(void);
+void test_BumpMark_NestedRewinds(void);
+void test_BumpAllocator_ScratchVectorsRewound(void);
+
+void test_SlabAlloc_SizeClasses(void);
+void test_SlabReclaim_RecyclesSameClass(void);
+void test_SlabRealloc_WithinAndAcrossClasses(void);
+void test_SlabAlloc_LargeRequestsPassThrough(void);
+void test_SlabAllocator_VectorChurn(void);
+
+void test_TlsfInit_OnlyFirstCallCarvesRegion(void);
+void test_TlsfReclaim_MergesNeighbours(void);
+void test_TlsfRealloc_InPlaceAndMoving(void);
+void test_TlsfAlloc_ExhaustedOrTooSmallRegion(void);
+void test_TlsfAllocator_VectorChurn(void);
+void test_TlsfAllocator_ManagedLifecycle(void);
+void test_TlsfAllocator_FreeAllWithResetsArena(void);
+
+void test_TlheapAlloc_SameThreadRecycles(void);
+void test_TlheapReclaim_CrossThreadFreeGoesBackToOwner(void);
+void test_TlheapRealloc_CrossThreadMovesToCaller(void);
+void test_TlheapThreadExit_HeapIsAdopted(void);
+void test_TlheapAllocator_VectorHandedBetweenThreads(void);
+
+void test_StatsAllocator_CountsVectorLifecycle(void);
+void test_StatsAllocator_UsableSizeAndReset(void);
+void test_StatsSnapshot_LatencyFailuresAndClear(void);
+void test_StatsAllocator_SharedByThreads(void);
+
+/* Meat of the Program */
+
+int main(void)
+{
+   UNITY_BEGIN();
+
+   RUN_TEST(test_MmapAlloc_BelowAndAboveThreshold);
+   RUN_TEST(test_MmapAlloc_ZeroedAboveThreshold);
+   RUN_TEST(test_MmapRealloc_GrowWithinMappedRange);
+   RUN_TEST(test_MmapRealloc_CrossThresholdUpAndDown);
+   RUN_TEST(test_MmapRealloc_NullOldPtr);
+   RUN_TEST(test_MmapUsableSize_NeverCrossesThreshold);
+   RUN_TEST(test_MmapTryExpandInPlace);
+   RUN_TEST(test_MmapAllocator_VectorGrowsPastThreshold);
+   RUN_TEST(test_MmapAllocAligned);
+   RUN_TEST(test_MmapReallocAligned_CrossThreshold);
+   RUN_TEST(test_MmapHugePages_AlignedAndRounded);
+   RUN_TEST(test_MmapHugePages_ExplicitOrFallback);
+   RUN_TEST(test_MmapAllocator_VectorOnHugePages);
+
+   RUN_TEST(test_BumpAlloc_AlignedUntilExhausted);
+   RUN_TEST(test_BumpAllocAligned);
+   RUN_TEST(test_BumpRealloc_LastBlockInPlace);
+   RUN_TEST(test_BumpRealloc_OlderBlockCopies);
+   RUN_TEST(test_BumpReset);
+   RUN_TEST(test_BumpAllocator_SequentialVectorsGrowInPlace);
+   RUN_TEST(test_BumpAllocator_FreeAllWithResetsArena);
+   RUN_TEST(test_BumpMark_NestedRewinds);
+   RUN_TEST(test_BumpAllocator_ScratchVectorsRewound);
+
+   RUN_TEST(test_SlabAlloc_SizeClasses);
+   RUN_TEST(test_SlabReclaim_RecyclesSameClass);
+   RUN_TEST(test_SlabRealloc_WithinAndAcrossClasses);
+   RUN_TEST(test_SlabAlloc_LargeRequestsPassThrough);
+   RUN_TEST(test_SlabAllocator_VectorChurn);
+
+   RUN_TEST(test_TlsfInit_OnlyFirstCallCarvesRegion);
+   RUN_TEST(test_TlsfReclaim_MergesNeighbours);
+   RUN_TEST(test_TlsfRealloc_InPlaceAndMoving);
+   RUN_TEST(test_TlsfAlloc_ExhaustedOrTooSmallRegion);
+   RUN_TEST(test_TlsfAllocator_VectorChurn);
+   RUN_TEST(test_TlsfAllocator_ManagedLifecycle);
+   RUN_TEST(test_TlsfAllocator_FreeAllWithResetsArena);
+
+   RUN_TEST(test_TlheapAlloc_SameThreadRecycles);
+   RUN_TEST(test_TlheapReclaim_CrossThreadFreeGoesBackToOwner);
+   RUN_TEST(test_TlheapRealloc_CrossThreadMovesToCaller);
+   RUN_TEST(test_TlheapThreadExit_HeapIsAdopted);
+   RUN_TEST(test_TlheapAllocator_VectorHandedBetweenThreads);
+
+   RUN_TEST(test_StatsAllocator_CountsVectorLifecycle);
+   RUN_TEST(test_StatsAllocator_UsableSizeAndReset);
+   RUN_TEST(test_StatsSnapshot_LatencyFailuresAndClear);
+   RUN_TEST(test_StatsAllocator_SharedByThreads);
+
+   return UNITY_END();
+}
+
+/********************************* Test Setup *********************************/
+
+void setUp(void)
+{
+   UnityMalloc_StartTest();
+}
+
+void tearDown(void)
+{
+   UnityMalloc_EndTest();
+}
+
+static void fill_pattern(uint8_t * buf, size_t len, uint8_t seed)
+{
+   for ( size_t i = 0; i < len; i++ )
+   {
+      buf[i] = (uint8_t)(i * 31u + seed);
+   }
+}
+
+static bool has_pattern(const uint8_t * buf, size_t len, uint8_t seed)
+{
+   for ( size_t i = 0; i < len; i++ )
+   {
+      if ( buf[i] != (uint8_t)(i * 31u + seed) ) return false;
+   }
+   return true;
+}
+
+/****************************** mmap Allocator ********************************/
+
+void test_MmapAlloc_BelowAndAboveThreshold(void)
+{
+   struct MmapArena arena = { .threshold = 64 * 1024 };
+   const size_t SIZES[] = { 1, 100, (64 * 1024) - 1, 64 * 1024, 1000 * 1000 };
+   for ( size_t i = 0; i < ARR_LEN(SIZES); i++ )
+   {
+      uint8_t * ptr = mmap_alloc(SIZES[i], &arena);
+      TEST_ASSERT_NOT_NULL(ptr);
+      fill_pattern(ptr, SIZES[i], (uint8_t)i);
+      TEST_ASSERT_TRUE( has_pattern(ptr, SIZES[i], (uint8_t)i) );
+      TEST_ASSERT_TRUE( mmap_usable_size(ptr, SIZES[i], &arena) >= SIZES[i] );
+      mmap_reclaim(ptr, SIZES[i], &arena);
+   }
+   mmap_reclaim(NULL, 0, &arena); // Must not crash
+}
+
+void test_MmapAlloc_ZeroedAboveThreshold(void)
+{
+   const size_t SIZES[] = { 10, MMAP_DEFAULT_THRESHOLD, MMAP_DEFAULT_THRESHOLD * 3 };
+   for ( size_t i = 0; i < ARR_LEN(SIZES); i++ )
+   {
+      uint8_t * ptr = mmap_alloc_zeroed(SIZES[i], NULL);
+      TEST_ASSERT_NOT_NULL(ptr);
+      for ( size_t j = 0; j < SIZES[i]; j += 97 )
+      {
+         TEST_ASSERT_EQUAL_UINT8( 0, ptr[j] );
+      }
+      mmap_reclaim(ptr, SIZES[i], NULL);
+   }
+}
+
+void test_MmapRealloc_GrowWithinMappedRange(void)
+{
+   struct MmapArena arena = { .threshold = 4096 };
+   size_t sz = 4096;
+   uint8_t * ptr = mmap_alloc(sz, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   fill_pattern(ptr, sz, 3);
+
+   // Keep doubling, which should be done through mremap, and confirm the
+   // contents follow along.
+   for ( size_t i = 0; i < 10; i++ )
+   {
+      size_t new_sz = sz * 2;
+      uint8_t * new_ptr = mmap_realloc(ptr, new_sz, sz, &arena);
+      TEST_ASSERT_NOT_NULL(new_ptr);
+      TEST_ASSERT_TRUE( has_pattern(new_ptr, sz, 3) );
+      fill_pattern(new_ptr, new_sz, 3);
+      ptr = new_ptr;
+      sz = new_sz;
+   }
+
+   mmap_reclaim(ptr, sz, &arena);
+}
+
+void test_MmapRealloc_CrossThresholdUpAndDown(void)
+{
+   struct MmapArena arena = { .threshold = 8192 };
+   const size_t SMALL = 1000;
+   const size_t LARGE = 100000;
+
+   uint8_t * ptr = mmap_alloc(SMALL, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   fill_pattern(ptr, SMALL, 9);
+
+   ptr = mmap_realloc(ptr, LARGE, SMALL, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   TEST_ASSERT_TRUE( has_pattern(ptr, SMALL, 9) );
+   fill_pattern(ptr, LARGE, 9);
+
+   ptr = mmap_realloc(ptr, SMALL, LARGE, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   TEST_ASSERT_TRUE( has_pattern(ptr, SMALL, 9) );
+
+   mmap_reclaim(ptr, SMALL, &arena);
+}
+
+void test_MmapRealloc_NullOldPtr(void)
+{
+   uint8_t * ptr = mmap_realloc(NULL, 100, 0, NULL);
+   TEST_ASSERT_NOT_NULL(ptr);
+   mmap_reclaim(ptr, 100, NULL);
+}
+
+void test_MmapUsableSize_NeverCrossesThreshold(void)
+{
+   struct MmapArena arena = { .threshold = 100 };
+   for ( size_t sz = 1; sz < 100; sz++ )
+   {
+      void * ptr = mmap_alloc(sz, &arena);
+      TEST_ASSERT_NOT_NULL(ptr);
+      size_t usable = mmap_usable_size(ptr, sz, &arena);
+      TEST_ASSERT_TRUE( usable >= sz );
+      TEST_ASSERT_TRUE( usable < arena.threshold );
+      // Reclaiming with the usable size must be just as valid
+      mmap_reclaim(ptr, usable, &arena);
+   }
+}
+
+void test_MmapTryExpandInPlace(void)
+{
+   struct MmapArena arena = { .threshold = 4096 };
+   const size_t SZ = 4096 * 4;
+   uint8_t * ptr = mmap_alloc(SZ + 1, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+
+   // Anything within the last page is trivially in place
+   TEST_ASSERT_TRUE( mmap_try_expand_in_place(ptr, SZ + 4096, SZ + 1, &arena) );
+
+   // Beyond that, it's up to the kernel, but a failure must leave the block
+   // intact and a success must leave the block usable at its new size.
+   fill_pattern(ptr, SZ + 4096, 5);
+   size_t sz = SZ + 4096;
+   if ( mmap_try_expand_in_place(ptr, sz * 4, sz, &arena) )
+   {
+      sz *= 4;
+      fill_pattern(ptr, sz, 5);
+   }
+   TEST_ASSERT_TRUE( has_pattern(ptr, sz, 5) );
+
+   mmap_reclaim(ptr, sz, &arena);
+}
+
+void test_MmapAllocator_VectorGrowsPastThreshold(void)
+{
+   struct MmapArena arena = { .threshold = 4096 };
+   const struct Allocator mem_mgr = MMAP_ALLOCATOR(&arena);
+   const size_t LEN = 100000;
+   struct Vector * vec = VectorNew(sizeof(uint32_t), 10, LEN, 0, &mem_mgr);
+   TEST_ASSERT_NOT_NULL(vec);
+
+   for ( uint32_t i = 0; i < LEN; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+   }
+   for ( uint32_t i = 0; i < LEN; i++ )
+   {
+      TEST_ASSERT_EQUAL_UINT32( i, *(uint32_t *)VectorGet(vec, i) );
+   }
+
+   struct Vector * dup = VectorDuplicate(vec);
+   TEST_ASSERT_TRUE( VectorsAreEqual(vec, dup) );
+   TEST_ASSERT_TRUE( VectorHardReset(dup) );
+
+   VectorFree(dup);
+   VectorFree(vec);
+}
+
+void test_MmapAllocAligned(void)
+{
+   struct MmapArena arena = { .threshold = 64 * 1024 };
+   const size_t SIZES[] = { 100, 64 * 1024, 1000 * 1000 };
+   const size_t ALIGNMENTS[] = { 8, 64, 4096, (size_t)2 << 20 };
+   for ( size_t i = 0; i < ARR_LEN(SIZES); i++ )
+   {
+      for ( size_t j = 0; j < ARR_LEN(ALIGNMENTS); j++ )
+      {
+         uint8_t * ptr = mmap_alloc_aligned(SIZES[i], ALIGNMENTS[j], &arena);
+         TEST_ASSERT_NOT_NULL(ptr);
+         TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % ALIGNMENTS[j] );
+         fill_pattern(ptr, SIZES[i], (uint8_t)j);
+         TEST_ASSERT_TRUE( has_pattern(ptr, SIZES[i], (uint8_t)j) );
+         mmap_reclaim(ptr, SIZES[i], &arena);
+      }
+   }
+}
+
+void test_MmapReallocAligned_CrossThreshold(void)
+{
+   struct MmapArena arena = { .threshold = 8192 };
+   const size_t SIZES[] = { 100, 5000, 8192, 100000, 3000000, 1000 };
+   const size_t ALIGNMENTS[] = { 64, (size_t)1 << 16 };
+   for ( size_t j = 0; j < ARR_LEN(ALIGNMENTS); j++ )
+   {
+      uint8_t * ptr = NULL;
+      size_t sz = 0;
+      for ( size_t i = 0; i < ARR_LEN(SIZES); i++ )
+      {
+         ptr = mmap_realloc_aligned(ptr, SIZES[i], sz, ALIGNMENTS[j], &arena);
+         TEST_ASSERT_NOT_NULL(ptr);
+         TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % ALIGNMENTS[j] );
+         if ( sz > 0 )
+         {
+            TEST_ASSERT_TRUE( has_pattern(ptr, (sz < SIZES[i]) ? sz : SIZES[i], 7) );
+         }
+         sz = SIZES[i];
+         fill_pattern(ptr, sz, 7);
+      }
+      mmap_reclaim(ptr, sz, &arena);
+   }
+}
+
+void test_MmapHugePages_AlignedAndRounded(void)
+{
+   struct MmapArena arena = { .threshold = 64 * 1024, .huge_pages = MmapHugePages_Transparent };
+
+   // Below the huge page size, mappings stay in regular pages
+   uint8_t * small = mmap_alloc(MMAP_HUGE_PAGE_SIZE - 1, &arena);
+   TEST_ASSERT_NOT_NULL(small);
+   TEST_ASSERT_EQUAL_size_t( MMAP_HUGE_PAGE_SIZE, mmap_usable_size(small, MMAP_HUGE_PAGE_SIZE - 1, &arena) );
+   fill_pattern(small, MMAP_HUGE_PAGE_SIZE - 1, 8);
+
+   // Growing past it moves the block to a huge page boundary
+   size_t sz = MMAP_HUGE_PAGE_SIZE - 1;
+   const size_t SIZES[] = { MMAP_HUGE_PAGE_SIZE + 1, 3 * MMAP_HUGE_PAGE_SIZE, 9 * MMAP_HUGE_PAGE_SIZE + 5,
+                            2 * MMAP_HUGE_PAGE_SIZE, 100 * 1024 };
+   uint8_t * ptr = small;
+   for ( size_t i = 0; i < ARR_LEN(SIZES); i++ )
+   {
+      ptr = mmap_realloc(ptr, SIZES[i], sz, &arena);
+      TEST_ASSERT_NOT_NULL(ptr);
+      TEST_ASSERT_TRUE( has_pattern(ptr, (SIZES[i] < sz) ? SIZES[i] : sz, 8) );
+      if ( SIZES[i] >= MMAP_HUGE_PAGE_SIZE )
+      {
+         TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % MMAP_HUGE_PAGE_SIZE );
+         TEST_ASSERT_EQUAL_size_t( 0, mmap_usable_size(ptr, SIZES[i], &arena) % MMAP_HUGE_PAGE_SIZE );
+      }
+      fill_pattern(ptr, SIZES[i], 8);
+      sz = SIZES[i];
+   }
+   mmap_reclaim(ptr, sz, &arena);
+
+   // Same for blocks that start out huge, incl. over-aligned ones
+   ptr = mmap_alloc_zeroed(5 * MMAP_HUGE_PAGE_SIZE, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % MMAP_HUGE_PAGE_SIZE );
+   TEST_ASSERT_EQUAL_UINT32( 0, ptr[5 * MMAP_HUGE_PAGE_SIZE - 1] );
+   mmap_reclaim(ptr, 5 * MMAP_HUGE_PAGE_SIZE, &arena);
+
+   ptr = mmap_alloc_aligned(MMAP_HUGE_PAGE_SIZE, 2 * MMAP_HUGE_PAGE_SIZE, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % (2 * MMAP_HUGE_PAGE_SIZE) );
+   ptr = mmap_realloc_aligned(ptr, 4 * MMAP_HUGE_PAGE_SIZE, MMAP_HUGE_PAGE_SIZE, 64, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % MMAP_HUGE_PAGE_SIZE );
+   mmap_reclaim(ptr, 4 * MMAP_HUGE_PAGE_SIZE, &arena);
+}
+
+void test_MmapHugePages_ExplicitOrFallback(void)
+{
+   // Whether or not the system has huge pages reserved, this has to work
+   struct MmapArena arena = { .threshold = 64 * 1024, .huge_pages = MmapHugePages_Explicit };
+   uint8_t * ptr = mmap_alloc(3 * MMAP_HUGE_PAGE_SIZE, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % MMAP_HUGE_PAGE_SIZE );
+   fill_pattern(ptr, 3 * MMAP_HUGE_PAGE_SIZE, 9);
+
+   ptr = mmap_realloc(ptr, 7 * MMAP_HUGE_PAGE_SIZE, 3 * MMAP_HUGE_PAGE_SIZE, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   TEST_ASSERT_TRUE( has_pattern(ptr, 3 * MMAP_HUGE_PAGE_SIZE, 9) );
+   TEST_ASSERT_TRUE( mmap_try_expand_in_place(ptr, 8 * MMAP_HUGE_PAGE_SIZE - 1, 7 * MMAP_HUGE_PAGE_SIZE + 1, &arena) );
+   mmap_reclaim(ptr, 7 * MMAP_HUGE_PAGE_SIZE, &arena);
+}
+
+void test_MmapAllocator_VectorOnHugePages(void)
+{
+   struct MmapArena arena = { .threshold = 64 * 1024, .huge_pages = MmapHugePages_Transparent };
+   const struct Allocator mem_mgr = MMAP_ALLOCATOR(&arena);
+   const uint32_t LEN = (uint32_t)( (3 * MMAP_HUGE_PAGE_SIZE) / sizeof(uint32_t) );
+
+   struct Vector * vec = VectorNew(sizeof(uint32_t), 0, LEN, 0, &mem_mgr);
+   TEST_ASSERT_NOT_NULL(vec);
+   for ( uint32_t i = 0; i < LEN; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+   }
+   TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)VectorGet(vec, 0) % MMAP_HUGE_PAGE_SIZE );
+   for ( uint32_t i = 0; i < LEN; i += 4099 )
+   {
+      TEST_ASSERT_EQUAL_UINT32( i, *(uint32_t *)VectorGet(vec, i) );
+   }
+   VectorFree(vec);
+}
+
+/****************************** Bump Allocator ********************************/
+
+void test_BumpAlloc_AlignedUntilExhausted(void)
+{
+   static uint8_t buf[1024];
+   struct BumpArena arena;
+   bump_init(&arena, buf, sizeof(buf));
+
+   size_t total = 0;
+   uint8_t * prev = NULL;
+   for ( size_t sz = 1; ; sz++ )
+   {
+      uint8_t * ptr = bump_alloc(sz, &arena);
+      if ( NULL == ptr )
+      {
+         // Only fails once the arena can't fit the request
+         TEST_ASSERT_TRUE( (sizeof(buf) - bump_used(&arena)) < bump_usable_size(NULL, sz, NULL) );
+         break;
+      }
+      TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % BUMP_DEFAULT_ALIGNMENT );
+      TEST_ASSERT_TRUE( ptr > prev );
+      TEST_ASSERT_TRUE( (ptr + bump_usable_size(ptr, sz, &arena)) <= (buf + sizeof(buf)) );
+      memset(ptr, 0xEE, bump_usable_size(ptr, sz, &arena));
+      prev = ptr;
+      total += sz;
+   }
+   TEST_ASSERT_TRUE( total > 0 );
+   TEST_ASSERT_TRUE( bump_used(&arena) <= sizeof(buf) );
+
+   bump_reclaim(prev, 1, &arena); // No-op
+   TEST_ASSERT_NULL( bump_alloc(sizeof(buf), &arena) );
+}
+
+void test_BumpAllocAligned(void)
+{
+   static uint8_t buf[8192];
+   struct BumpArena arena;
+   bump_init(&arena, buf, sizeof(buf));
+
+   (void)bump_alloc(3, &arena);
+   const size_t ALIGNMENTS[] = { 1, 32, 64, 256, 1024 };
+   for ( size_t i = 0; i < ARR_LEN(ALIGNMENTS); i++ )
+   {
+      uint8_t * ptr = bump_alloc_aligned(10, ALIGNMENTS[i], &arena);
+      TEST_ASSERT_NOT_NULL(ptr);
+      TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % ALIGNMENTS[i] );
+
+      // Growing it keeps the alignment, whether it moves or not
+      (void)bump_alloc(1, &arena);
+      ptr = bump_realloc_aligned(ptr, 500, 10, ALIGNMENTS[i], &arena);
+      TEST_ASSERT_NOT_NULL(ptr);
+      TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % ALIGNMENTS[i] );
+   }
+}
+
+void test_BumpRealloc_LastBlockInPlace(void)
+{
+   static uint8_t buf[4096];
+   struct BumpArena arena;
+   bump_init(&arena, buf, sizeof(buf));
+
+   (void)bump_alloc(100, &arena);
+   uint8_t * ptr = bump_alloc(16, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   fill_pattern(ptr, 16, 1);
+
+   size_t sz = 16;
+   while ( sz * 2 <= (sizeof(buf) - 128) )
+   {
+      TEST_ASSERT_TRUE( bump_try_expand_in_place(ptr, sz * 2, sz, &arena) );
+      sz *= 2;
+      TEST_ASSERT_EQUAL_PTR( ptr, bump_realloc(ptr, sz, sz, &arena) );
+   }
+   TEST_ASSERT_TRUE( has_pattern(ptr, 16, 1) );
+   TEST_ASSERT_FALSE( bump_try_expand_in_place(ptr, sizeof(buf), sz, &arena) );
+
+   // Shrinking the last block gives the space back
+   size_t used = bump_used(&arena);
+   TEST_ASSERT_EQUAL_PTR( ptr, bump_realloc(ptr, 16, sz, &arena) );
+   TEST_ASSERT_TRUE( bump_used(&arena) < used );
+   TEST_ASSERT_TRUE( has_pattern(ptr, 16, 1) );
+}
+
+void test_BumpRealloc_OlderBlockCopies(void)
+{
+   static uint8_t buf[4096];
+   struct BumpArena arena;
+   bump_init(&arena, buf, sizeof(buf));
+
+   uint8_t * old_ptr = bump_alloc(100, &arena);
+   fill_pattern(old_ptr, 100, 4);
+   (void)bump_alloc(10, &arena); // old_ptr is no longer the last block
+
+   // Within the rounded-up size, nothing moves
+   TEST_ASSERT_TRUE( bump_try_expand_in_place(old_ptr, bump_usable_size(old_ptr, 100, &arena), 100, &arena) );
+   TEST_ASSERT_FALSE( bump_try_expand_in_place(old_ptr, 1000, 100, &arena) );
+
+   uint8_t * new_ptr = bump_realloc(old_ptr, 1000, 100, &arena);
+   TEST_ASSERT_NOT_NULL(new_ptr);
+   TEST_ASSERT_TRUE( new_ptr != old_ptr );
+   TEST_ASSERT_TRUE( has_pattern(new_ptr, 100, 4) );
+
+   // Out of room
+   TEST_ASSERT_NULL( bump_realloc(old_ptr, sizeof(buf), 100, &arena) );
+   TEST_ASSERT_TRUE( has_pattern(old_ptr, 100, 4) );
+}
+
+void test_BumpReset(void)
+{
+   static uint8_t buf[256];
+   struct BumpArena arena;
+   bump_init(&arena, buf, sizeof(buf));
+
+   uint8_t * first = bump_alloc(200, &arena);
+   TEST_ASSERT_NOT_NULL(first);
+   TEST_ASSERT_NULL( bump_alloc(200, &arena) );
+
+   bump_reset(&arena);
+   TEST_ASSERT_EQUAL_size_t( 0, bump_used(&arena) );
+   TEST_ASSERT_EQUAL_PTR( first, bump_alloc(200, &arena) );
+}
+
+void test_BumpAllocator_SequentialVectorsGrowInPlace(void)
+{
+   static uint8_t buf[1 << 16];
+   struct BumpArena arena;
+   bump_init(&arena, buf, sizeof(buf));
+   const struct Allocator mem_mgr = BUMP_ALLOCATOR(&arena);
+
+   for ( int round = 0; round < 3; round++ )
+   {
+      struct Vector * a = VectorNew(sizeof(uint32_t), 1, 1000, 0, &mem_mgr);
+      struct Vector * b = VectorNew(sizeof(uint32_t), 1, 1000, 0, &mem_mgr);
+      TEST_ASSERT_NOT_NULL(a);
+      TEST_ASSERT_NOT_NULL(b);
+
+      // b is the last block, so it never has to move or leave copies behind
+      const void * b_start = NULL;
+      for ( uint32_t i = 0; i < 1000; i++ )
+      {
+         TEST_ASSERT_TRUE( VectorPush(b, &i) );
+         if ( NULL == b_start ) b_start = VectorGet(b, 0);
+         TEST_ASSERT_EQUAL_PTR( b_start, VectorGet(b, 0) );
+      }
+      size_t used_by_b = (size_t)( (buf + bump_used(&arena)) - (const uint8_t *)b_start );
+      TEST_ASSERT_EQUAL_size_t( bump_usable_size(NULL, 1000 * sizeof(uint32_t), NULL), used_by_b );
+
+      // a has to move past b to grow, but keeps its contents
+      for ( uint32_t i = 0; i < 1000; i++ )
+      {
+         TEST_ASSERT_TRUE( VectorPush(a, &i) );
+      }
+      for ( uint32_t i = 0; i < 1000; i++ )
+      {
+         TEST_ASSERT_EQUAL_UINT32( i, *(uint32_t *)VectorGet(a, i) );
+         TEST_ASSERT_EQUAL_UINT32( i, *(uint32_t *)VectorGet(b, i) );
+      }
+
+      VectorFree(a);
+      VectorFree(b);
+      bump_reset(&arena);
+   }
+}
+
+void test_BumpAllocator_FreeAllWithResetsArena(void)
+{
+   static uint8_t buf[1 << 16];
+   struct BumpArena arena;
+   bump_init(&arena, buf, sizeof(buf));
+   const struct Allocator mem_mgr = BUMP_ALLOCATOR(&arena);
+
+   struct Vector * other = VectorNew(sizeof(uint32_t), 10, 1000, 0, NULL);
+   TEST_ASSERT_TRUE( VectorPush(other, &(uint32_t){42}) );
+
+   for ( int round = 0; round < 3; round++ )
+   {
+      // A request's worth of vectors, all from the arena
+      for ( size_t v = 0; v < 5; v++ )
+      {
+         struct Vector * vec = VectorNew(sizeof(uint32_t), 1, 1000, 0, &mem_mgr);
+         TEST_ASSERT_NOT_NULL(vec);
+         for ( uint32_t i = 0; i < 500; i++ )
+         {
+            TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+         }
+      }
+      TEST_ASSERT_TRUE( bump_used(&arena) > 0 );
+
+      TEST_ASSERT_EQUAL_size_t( 5, VectorFreeAllWith(&mem_mgr) );
+      TEST_ASSERT_EQUAL_size_t( 0, bump_used(&arena) );
+   }
+
+   // Vectors of other allocators are left alone
+   TEST_ASSERT_EQUAL_UINT32( 42, *(uint32_t *)VectorGet(other, 0) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorFreeAllWith(&mem_mgr) );
+   VectorFree(other);
+}
+
+void test_BumpMark_NestedRewinds(void)
+{
+   static uint8_t buf[1024];
+   struct BumpArena arena;
+   bump_init(&arena, buf, sizeof(buf));
+
+   uint8_t * a = bump_alloc(16, &arena);
+   const size_t USED_A = bump_used(&arena);
+
+   struct BumpMark outer = bump_mark(&arena);
+   // a can't grow into the scratch space while the savepoint stands
+   TEST_ASSERT_FALSE( bump_try_expand_in_place(a, 64, 16, &arena) );
+   uint8_t * b = bump_alloc(100, &arena);
+   TEST_ASSERT_NOT_NULL(b);
+   const size_t USED_B = bump_used(&arena);
+
+   struct BumpMark inner = bump_mark(&arena);
+   TEST_ASSERT_NOT_NULL( bump_alloc(200, &arena) );
+   bump_rewind(&arena, inner);
+   TEST_ASSERT_EQUAL_size_t( USED_B, bump_used(&arena) );
+   // b is the last block again, and can grow in place
+   TEST_ASSERT_TRUE( bump_try_expand_in_place(b, 300, 100, &arena) );
+
+   bump_rewind(&arena, outer);
+   TEST_ASSERT_EQUAL_size_t( USED_A, bump_used(&arena) );
+   TEST_ASSERT_TRUE( bump_try_expand_in_place(a, 64, 16, &arena) );
+   TEST_ASSERT_EQUAL_PTR( a + 64, bump_alloc(16, &arena) );
+}
+
+void test_BumpAllocator_ScratchVectorsRewound(void)
+{
+   static uint8_t buf[1 << 16];
+   struct BumpArena arena;
+   bump_init(&arena, buf, sizeof(buf));
+   const struct Allocator scratch = BUMP_ALLOCATOR(&arena);
+
+   struct Vector * src = VectorNew(sizeof(uint32_t), 100, 1000, 0, NULL);
+   for ( uint32_t i = 0; i < 100; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(src, &i) );
+   }
+
+   for ( int call = 0; call < 3; call++ )
+   {
+      struct BumpMark frame = bump_mark(&arena);
+      struct Vector * head = VectorSliceWith(src, 0, 50, &scratch);
+      struct Vector * copy = VectorSliceWith(src, 0, 100, &scratch);
+      struct Vector * tail = VectorSplitAtWith(copy, 90, &scratch);
+      TEST_ASSERT_NOT_NULL(head);
+      TEST_ASSERT_NOT_NULL(tail);
+      const size_t USED = bump_used(&arena);
+      TEST_ASSERT_TRUE( USED > 0 );
+
+      // A nested frame, e.g. in a callee
+      struct BumpMark callee = bump_mark(&arena);
+      struct Vector * cat = VectorConcatenateWith(head, tail, &scratch);
+      TEST_ASSERT_EQUAL_size_t( 60, VectorLength(cat) );
+      TEST_ASSERT_EQUAL_UINT32( 49, *(uint32_t *)VectorGet(cat, 49) );
+      TEST_ASSERT_EQUAL_UINT32( 90, *(uint32_t *)VectorGet(cat, 50) );
+      VectorFree(cat);
+      bump_rewind(&arena, callee);
+      TEST_ASSERT_EQUAL_size_t( USED, bump_used(&arena) );
+
+      VectorFree(head);
+      VectorFree(copy);
+      VectorFree(tail);
+      bump_rewind(&arena, frame);
+      TEST_ASSERT_EQUAL_size_t( 0, bump_used(&arena) );
+   }
+
+   TEST_ASSERT_EQUAL_size_t( 100, VectorLength(src) );
+   TEST_ASSERT_EQUAL_UINT32( 99, *(uint32_t *)VectorLastElement(src) );
+   VectorFree(src);
+}
+
+/****************************** Slab Allocator ********************************/
+
+void test_SlabAlloc_SizeClasses(void)
+{
+   struct SlabArena arena;
+   slab_init(&arena);
+
+   const size_t MIN_SZ = (size_t)1 << SLAB_MIN_CLASS_SHIFT;
+   const size_t MAX_SZ = (size_t)1 << SLAB_MAX_CLASS_SHIFT;
+   for ( size_t sz = 1; sz <= MAX_SZ; sz = (sz * 3) / 2 + 1 )
+   {
+      uint8_t * ptr = slab_alloc(sz, &arena);
+      TEST_ASSERT_NOT_NULL(ptr);
+      TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % 16 );
+
+      // Usable size is the power of two that the request rounds up to
+      size_t usable = slab_usable_size(ptr, sz, &arena);
+      TEST_ASSERT_TRUE( usable >= sz );
+      TEST_ASSERT_TRUE( (usable == MIN_SZ) || (usable < 2 * sz) );
+      TEST_ASSERT_EQUAL_size_t( 0, usable & (usable - 1) );
+      TEST_ASSERT_EQUAL_size_t( usable, slab_usable_size(ptr, usable, &arena) );
+
+      fill_pattern(ptr, usable, (uint8_t)sz);
+      TEST_ASSERT_TRUE( has_pattern(ptr, usable, (uint8_t)sz) );
+   }
+
+   slab_destroy(&arena);
+}
+
+void test_SlabReclaim_RecyclesSameClass(void)
+{
+   struct SlabArena arena;
+   slab_init(&arena);
+
+   void * a = slab_alloc(100, &arena);
+   void * b = slab_alloc(120, &arena); // Same class as a (128)
+   void * c = slab_alloc(1000, &arena);
+   TEST_ASSERT_NOT_NULL(a);
+   TEST_ASSERT_NOT_NULL(b);
+   TEST_ASSERT_NOT_NULL(c);
+
+   // Freed blocks come back last-in first-out for their class only
+   slab_reclaim(a, 100, &arena);
+   slab_reclaim(b, 128, &arena); // Reclaiming with the usable size is fine too
+   TEST_ASSERT_EQUAL_PTR( b, slab_alloc(65, &arena) );
+   TEST_ASSERT_EQUAL_PTR( a, slab_alloc(128, &arena) );
+   slab_reclaim(c, 1000, &arena);
+   TEST_ASSERT_TRUE( slab_alloc(100, &arena) != c );
+   TEST_ASSERT_EQUAL_PTR( c, slab_alloc(1024, &arena) );
+   slab_reclaim(NULL, 100, &arena); // Must not crash
+
+   slab_destroy(&arena);
+}
+
+void test_SlabRealloc_WithinAndAcrossClasses(void)
+{
+   struct SlabArena arena;
+   slab_init(&arena);
+
+   uint8_t * ptr = slab_alloc(40, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   fill_pattern(ptr, 40, 2);
+
+   // Within its class (64), nothing moves
+   TEST_ASSERT_TRUE( slab_try_expand_in_place(ptr, 64, 40, &arena) );
+   TEST_ASSERT_FALSE( slab_try_expand_in_place(ptr, 65, 40, &arena) );
+   TEST_ASSERT_EQUAL_PTR( ptr, slab_realloc(ptr, 60, 40, &arena) );
+
+   // Across classes, the contents follow and the old block is recycled
+   uint8_t * old_ptr = ptr;
+   size_t sz = 60;
+   while ( sz < 200000 )
+   {
+      size_t new_sz = sz * 2;
+      ptr = slab_realloc(ptr, new_sz, sz, &arena);
+      TEST_ASSERT_NOT_NULL(ptr);
+      TEST_ASSERT_TRUE( has_pattern(ptr, 40, 2) );
+      sz = new_sz;
+   }
+   TEST_ASSERT_EQUAL_PTR( old_ptr, slab_alloc(64, &arena) );
+
+   ptr = slab_realloc(ptr, 40, sz, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   TEST_ASSERT_TRUE( has_pattern(ptr, 40, 2) );
+   slab_reclaim(ptr, 40, &arena);
+
+   TEST_ASSERT_NOT_NULL( (ptr = slab_realloc(NULL, 10, 0, &arena)) );
+   slab_reclaim(ptr, 10, &arena);
+
+   slab_destroy(&arena);
+}
+
+void test_SlabAlloc_LargeRequestsPassThrough(void)
+{
+   struct SlabArena arena;
+   slab_init(&arena);
+
+   const size_t SZ = ((size_t)1 << SLAB_MAX_CLASS_SHIFT) + 1;
+   uint8_t * ptr = slab_alloc(SZ, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   TEST_ASSERT_NULL(arena.chunks); // Didn't need a chunk for it
+   fill_pattern(ptr, SZ, 3);
+   ptr = slab_realloc(ptr, SZ * 4, SZ, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   TEST_ASSERT_TRUE( has_pattern(ptr, SZ, 3) );
+   slab_reclaim(ptr, SZ * 4, &arena);
+
+   slab_destroy(&arena);
+}
+
+void test_SlabAllocator_VectorChurn(void)
+{
+   struct SlabArena arena;
+   slab_init(&arena);
+   const struct Allocator mem_mgr = SLAB_ALLOCATOR(&arena);
+
+   // Keep creating, growing and freeing vectors. After the first round, every
+   // buffer should come from the free lists rather than fresh chunks.
+   struct SlabChunk * chunks_after_first_round = NULL;
+   for ( int round = 0; round < 5; round++ )
+   {
+      struct Vector * vecs[10];
+      for ( size_t v = 0; v < ARR_LEN(vecs); v++ )
+      {
+         vecs[v] = VectorNew(sizeof(uint32_t), 1, 10000, 0, &mem_mgr);
+         TEST_ASSERT_NOT_NULL(vecs[v]);
+         for ( uint32_t i = 0; i < (uint32_t)(100 * (v + 1)); i++ )
+         {
+            TEST_ASSERT_TRUE( VectorPush(vecs[v], &i) );
+         }
+      }
+      for ( size_t v = 0; v < ARR_LEN(vecs); v++ )
+      {
+         for ( uint32_t i = 0; i < (uint32_t)(100 * (v + 1)); i++ )
+         {
+            TEST_ASSERT_EQUAL_UINT32( i, *(uint32_t *)VectorGet(vecs[v], i) );
+         }
+         VectorFree(vecs[v]);
+      }
+
+      if ( 0 == round )
+      {
+         chunks_after_first_round = arena.chunks;
+      }
+      TEST_ASSERT_EQUAL_PTR( chunks_after_first_round, arena.chunks );
+   }
+
+   slab_destroy(&arena);
+}
+
+/****************************** TLSF Allocator ********************************/
+
+static uint64_t TlsfRegion[(64 * 1024) / sizeof(uint64_t)];
+
+void test_TlsfInit_OnlyFirstCallCarvesRegion(void)
+{
+   struct TlsfArena arena = TLSF_ARENA(TlsfRegion, sizeof(TlsfRegion));
+   TEST_ASSERT_EQUAL_size_t( 0, tlsf_free_bytes(&arena) );
+   tlsf_init(&arena);
+
+   const size_t FREE_AT_START = tlsf_free_bytes(&arena);
+   TEST_ASSERT_TRUE( FREE_AT_START > (sizeof(TlsfRegion) - 64) );
+   TEST_ASSERT_TRUE( FREE_AT_START < sizeof(TlsfRegion) );
+
+   uint8_t * ptr = tlsf_alloc(100, &arena);
+   TEST_ASSERT_NOT_NULL(ptr);
+   TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % TLSF_ALIGNMENT );
+   fill_pattern(ptr, 100, 0x5A);
+   const size_t FREE_AFTER_ALLOC = tlsf_free_bytes(&arena);
+   TEST_ASSERT_TRUE( FREE_AFTER_ALLOC < FREE_AT_START );
+
+   // Re-initializing must not wipe out the block that's still in use
+   tlsf_init(&arena);
+   TEST_ASSERT_EQUAL_size_t( FREE_AFTER_ALLOC, tlsf_free_bytes(&arena) );
+   TEST_ASSERT_TRUE( has_pattern(ptr, 100, 0x5A) );
+
+   tlsf_reclaim(ptr, 100, &arena);
+   TEST_ASSERT_EQUAL_size_t( FREE_AT_START, tlsf_free_bytes(&arena) );
+}
+
+void test_TlsfReclaim_MergesNeighbours(void)
+{
+   struct TlsfArena arena = TLSF_ARENA(TlsfRegion, sizeof(TlsfRegion));
+   tlsf_init(&arena);
+   const size_t FREE_AT_START = tlsf_free_bytes(&arena);
+
+   uint8_t * blocks[8];
+   for ( size_t i = 0; i < ARR_LEN(blocks); i++ )
+   {
+      blocks[i] = tlsf_alloc(1000 + (i * 300), &arena);
+      TEST_ASSERT_NOT_NULL(blocks[i]);
+      TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)blocks[i] % TLSF_ALIGNMENT );
+      fill_pattern(blocks[i], 1000 + (i * 300), (uint8_t)i);
+   }
+
+   // Free every other block, then the rest, so that every block gets merged
+   // with a free neighbour on one side or the other
+   for ( size_t i = 1; i < ARR_LEN(blocks); i += 2 )
+   {
+      tlsf_reclaim(blocks[i], 1000 + (i * 300), &arena);
+   }
+   for ( size_t i = 0; i < ARR_LEN(blocks); i += 2 )
+   {
+      TEST_ASSERT_TRUE( has_pattern(blocks[i], 1000 + (i * 300), (uint8_t)i) );
+      tlsf_reclaim(blocks[i], 1000 + (i * 300), &arena);
+   }
+
+   // Back to one big block, so a request larger than all of the blocks above
+   // put together can be served again
+   TEST_ASSERT_EQUAL_size_t( FREE_AT_START, tlsf_free_bytes(&arena) );
+   uint8_t * big = tlsf_alloc(FREE_AT_START / 2, &arena);
+   TEST_ASSERT_NOT_NULL(big);
+   tlsf_reclaim(big, FREE_AT_START / 2, &arena);
+   TEST_ASSERT_EQUAL_size_t( FREE_AT_START, tlsf_free_bytes(&arena) );
+}
+
+void test_TlsfRealloc_InPlaceAndMoving(void)
+{
+   struct TlsfArena arena = TLSF_ARENA(TlsfRegion, sizeof(TlsfRegion));
+   tlsf_init(&arena);
+   const size_t FREE_AT_START = tlsf_free_bytes(&arena);
+
+   // Nothing after the first block yet, so it grows in place
+   uint8_t * first = tlsf_alloc(64, &arena);
+   TEST_ASSERT_NOT_NULL(first);
+   fill_pattern(first, 64, 0x11);
+   TEST_ASSERT_TRUE( tlsf_try_expand_in_place(first, 256, 64, &arena) );
+   TEST_ASSERT_TRUE( tlsf_usable_size(first, 256, &arena) >= 256 );
+   TEST_ASSERT_EQUAL_PTR( first, tlsf_realloc(first, 1024, 256, &arena) );
+   TEST_ASSERT_TRUE( has_pattern(first, 64, 0x11) );
+
+   // Once boxed in by another block, growing has to move
+   uint8_t * second = tlsf_alloc(64, &arena);
+   TEST_ASSERT_NOT_NULL(second);
+   TEST_ASSERT_FALSE( tlsf_try_expand_in_place(first, 4096, 1024, &arena) );
+   uint8_t * moved = tlsf_realloc(first, 4096, 1024, &arena);
+   TEST_ASSERT_NOT_NULL(moved);
+   TEST_ASSERT_TRUE( moved != first );
+   TEST_ASSERT_TRUE( has_pattern(moved, 64, 0x11) );
+
+   // Shrinking stays in place and gives the tail back
+   const size_t FREE_BEFORE_SHRINK = tlsf_free_bytes(&arena);
+   TEST_ASSERT_EQUAL_PTR( moved, tlsf_realloc(moved, 128, 4096, &arena) );
+   TEST_ASSERT_TRUE( tlsf_usable_size(moved, 128, &arena) < 4096 );
+   TEST_ASSERT_TRUE( tlsf_free_bytes(&arena) > FREE_BEFORE_SHRINK );
+   TEST_ASSERT_TRUE( has_pattern(moved, 64, 0x11) );
+
+   // NULL old pointer behaves like alloc
+   uint8_t * third = tlsf_realloc(NULL, 32, 0, &arena);
+   TEST_ASSERT_NOT_NULL(third);
+
+   tlsf_reclaim(moved, 128, &arena);
+   tlsf_reclaim(third, 32, &arena);
+   tlsf_reclaim(second, 64, &arena);
+   TEST_ASSERT_EQUAL_size_t( FREE_AT_START, tlsf_free_bytes(&arena) );
+}
+
+void test_TlsfAlloc_ExhaustedOrTooSmallRegion(void)
+{
+   struct TlsfArena arena = TLSF_ARENA(TlsfRegion, sizeof(TlsfRegion));
+   tlsf_init(&arena);
+
+   TEST_ASSERT_NULL( tlsf_alloc(sizeof(TlsfRegion), &arena) );
+   TEST_ASSERT_NULL( tlsf_alloc(SIZE_MAX, &arena) );
+
+   uint8_t * big = tlsf_alloc(sizeof(TlsfRegion) / 2, &arena);
+   TEST_ASSERT_NOT_NULL(big);
+   TEST_ASSERT_NULL( tlsf_alloc(sizeof(TlsfRegion) / 2, &arena) );
+   TEST_ASSERT_NULL( tlsf_realloc(big, sizeof(TlsfRegion), sizeof(TlsfRegion) / 2, &arena) );
+   tlsf_reclaim(big, sizeof(TlsfRegion) / 2, &arena);
+
+   uint8_t tiny[16];
+   struct TlsfArena tiny_arena = TLSF_ARENA(tiny, sizeof(tiny));
+   tlsf_init(&tiny_arena);
+   TEST_ASSERT_NULL( tlsf_alloc(1, &tiny_arena) );
+
+   struct TlsfArena no_region = TLSF_ARENA(NULL, 0);
+   tlsf_init(&no_region);
+   TEST_ASSERT_NULL( tlsf_alloc(1, &no_region) );
+}
+
+void test_TlsfAllocator_VectorChurn(void)
+{
+   struct TlsfArena arena = TLSF_ARENA(TlsfRegion, sizeof(TlsfRegion));
+   tlsf_init(&arena);
+   const size_t FREE_AT_START = tlsf_free_bytes(&arena);
+   const struct Allocator mem_mgr = TLSF_ALLOCATOR(&arena);
+
+   // Every VectorNew runs the allocator's init on the shared arena, which must
+   // leave the other vectors' buffers alone
+   for ( int round = 0; round < 5; round++ )
+   {
+      struct Vector * vecs[6];
+      for ( size_t v = 0; v < ARR_LEN(vecs); v++ )
+      {
+         vecs[v] = VectorNew(sizeof(uint32_t), 1, 1000, 0, &mem_mgr);
+         TEST_ASSERT_NOT_NULL(vecs[v]);
+      }
+      for ( uint32_t i = 0; i < 500; i++ )
+      {
+         for ( size_t v = 0; v < ARR_LEN(vecs); v++ )
+         {
+            if ( i < (uint32_t)(100 * (v + 1)) )
+            {
+               TEST_ASSERT_TRUE( VectorPush(vecs[v], &i) );
+            }
+         }
+      }
+      for ( size_t v = 0; v < ARR_LEN(vecs); v++ )
+      {
+         TEST_ASSERT_EQUAL_size_t( (v < 5) ? (100 * (v + 1)) : 500, VectorLength(vecs[v]) );
+         for ( uint32_t i = 0; i < VectorLength(vecs[v]); i++ )
+         {
+            TEST_ASSERT_EQUAL_UINT32( i, *(uint32_t *)VectorGet(vecs[v], i) );
+         }
+         VectorFree(vecs[v]);
+      }
+      TEST_ASSERT_EQUAL_size_t( FREE_AT_START, tlsf_free_bytes(&arena) );
+   }
+}
+
+void test_TlsfAllocator_ManagedLifecycle(void)
+{
+   struct TlsfArena arena = TLSF_ARENA(TlsfRegion, sizeof(TlsfRegion));
+   struct Allocator mem_mgr = TLSF_ALLOCATOR(&arena);
+   TEST_ASSERT_TRUE( AllocatorInit(&mem_mgr) );
+   TEST_ASSERT_TRUE( arena.initialized );
+   const size_t FREE_AT_START = tlsf_free_bytes(&arena);
+
+   struct Vector * vecs[4];
+   for ( size_t v = 0; v < ARR_LEN(vecs); v++ )
+   {
+      vecs[v] = VectorNew(sizeof(uint32_t), 8, 1000, 0, &mem_mgr);
+      TEST_ASSERT_NOT_NULL(vecs[v]);
+      for ( uint32_t i = 0; i < 300; i++ )
+      {
+         TEST_ASSERT_TRUE( VectorPush(vecs[v], &i) );
+      }
+   }
+
+   // The arena is torn down along with the last vector, not with our reference
+   AllocatorRelease(&mem_mgr);
+   TEST_ASSERT_TRUE( arena.initialized );
+   for ( size_t v = 0; v < ARR_LEN(vecs); v++ )
+   {
+      TEST_ASSERT_EQUAL_UINT32( 299, *(uint32_t *)VectorLastElement(vecs[v]) );
+      VectorFree(vecs[v]);
+   }
+   TEST_ASSERT_FALSE( arena.initialized );
+   TEST_ASSERT_NULL( tlsf_alloc(16, &arena) );
+
+   // ...and can be set up all over again
+   TEST_ASSERT_TRUE( AllocatorInit(&mem_mgr) );
+   TEST_ASSERT_EQUAL_size_t( FREE_AT_START, tlsf_free_bytes(&arena) );
+   AllocatorRelease(&mem_mgr);
+}
+
+void test_TlsfAllocator_FreeAllWithResetsArena(void)
+{
+   struct TlsfArena arena = TLSF_ARENA(TlsfRegion, sizeof(TlsfRegion));
+   struct Allocator mem_mgr = TLSF_ALLOCATOR(&arena);
+   TEST_ASSERT_TRUE( AllocatorInit(&mem_mgr) );
+   const size_t FREE_AT_START = tlsf_free_bytes(&arena);
+
+   for ( size_t v = 0; v < 4; v++ )
+   {
+      struct Vector * vec = VectorNew(sizeof(uint32_t), 8, 1000, 0, &mem_mgr);
+      TEST_ASSERT_NOT_NULL(vec);
+      for ( uint32_t i = 0; i < 300; i++ )
+      {
+         TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+      }
+   }
+   TEST_ASSERT_TRUE( tlsf_free_bytes(&arena) < FREE_AT_START );
+   TEST_ASSERT_EQUAL_size_t( 5, mem_mgr.refs );
+
+   // The whole region comes back in one go, and the vectors' references with it
+   TEST_ASSERT_EQUAL_size_t( 4, VectorFreeAllWith(&mem_mgr) );
+   TEST_ASSERT_EQUAL_size_t( 1, mem_mgr.refs );
+   TEST_ASSERT_TRUE( arena.initialized );
+   TEST_ASSERT_EQUAL_size_t( FREE_AT_START, tlsf_free_bytes(&arena) );
+
+   AllocatorRelease(&mem_mgr);
+   TEST_ASSERT_FALSE( arena.initialized );
+}
+
+/************************** Thread-Local Heap Allocator ***********************/
+
+#define TLHEAP_TEST_BLOCKS (8)
+
+struct TlheapJob
+{
+   uint8_t * blocks[TLHEAP_TEST_BLOCKS];
+   size_t sz;
+   struct Vector * vec;
+};
+
+static void * tlheap_free_blocks(void * arg)
+{
+   struct TlheapJob * job = arg;
+   for ( size_t i = 0; i < TLHEAP_TEST_BLOCKS; i++ )
+   {
+      tlheap_reclaim(job->blocks[i], job->sz, NULL);
+   }
+   return NULL;
+}
+
+static void * tlheap_grow_blocks(void * arg)
+{
+   struct TlheapJob * job = arg;
+   for ( size_t i = 0; i < TLHEAP_TEST_BLOCKS; i++ )
+   {
+      job->blocks[i] = tlheap_realloc(job->blocks[i], job->sz * 4, job->sz, NULL);
+   }
+   job->sz *= 4;
+   return NULL;
+}
+
+static void * tlheap_alloc_then_free_one(void * arg)
+{
+   struct TlheapJob * job = arg;
+   job->blocks[0] = tlheap_alloc(job->sz, NULL);
+   tlheap_reclaim(job->blocks[0], job->sz, NULL);
+   return NULL;
+}
+
+static void * tlheap_alloc_one(void * arg)
+{
+   struct TlheapJob * job = arg;
+   job->blocks[1] = tlheap_alloc(job->sz, NULL);
+   tlheap_reclaim(job->blocks[1], job->sz, NULL);
+   return NULL;
+}
+
+static void * tlheap_fill_vector(void * arg)
+{
+   struct TlheapJob * job = arg;
+   for ( uint32_t i = 0; i < 2000; i++ )
+   {
+      if ( !VectorPush(job->vec, &i) )
+      {
+         break;
+      }
+   }
+   return NULL;
+}
+
+static void run_in_thread(void * (*fn)(void *), struct TlheapJob * job)
+{
+   pthread_t thread;
+   TEST_ASSERT_EQUAL_INT( 0, pthread_create(&thread, NULL, fn, job) );
+   TEST_ASSERT_EQUAL_INT( 0, pthread_join(thread, NULL) );
+}
+
+void test_TlheapAlloc_SameThreadRecycles(void)
+{
+   uint8_t * ptr = tlheap_alloc(100, NULL);
+   TEST_ASSERT_NOT_NULL(ptr);
+   TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % 16 );
+   TEST_ASSERT_TRUE( tlheap_usable_size(ptr, 100, NULL) >= 100 );
+   TEST_ASSERT_TRUE( tlheap_try_expand_in_place(ptr, tlheap_usable_size(ptr, 100, NULL), 100, NULL) );
+   fill_pattern(ptr, 100, 5);
+
+   uint8_t * grown = tlheap_realloc(ptr, 5000, 100, NULL);
+   TEST_ASSERT_NOT_NULL(grown);
+   TEST_ASSERT_TRUE( has_pattern(grown, 100, 5) );
+
+   // The 100-byte block went back on this thread's free list
+   uint8_t * again = tlheap_alloc(100, NULL);
+   TEST_ASSERT_EQUAL_PTR( ptr, again );
+   tlheap_reclaim(again, 100, NULL);
+   tlheap_reclaim(grown, 5000, NULL);
+
+   // Past the largest slab class, blocks come from malloc
+   const size_t BIG = ((size_t)1 << SLAB_MAX_CLASS_SHIFT) * 2;
+   uint8_t * big = tlheap_alloc(BIG, NULL);
+   TEST_ASSERT_NOT_NULL(big);
+   fill_pattern(big, BIG, 6);
+   big = tlheap_realloc(big, BIG * 2, BIG, NULL);
+   TEST_ASSERT_NOT_NULL(big);
+   TEST_ASSERT_TRUE( has_pattern(big, BIG, 6) );
+   tlheap_reclaim(big, BIG * 2, NULL);
+
+   TEST_ASSERT_NULL( tlheap_alloc(SIZE_MAX, NULL) );
+}
+
+void test_TlheapReclaim_CrossThreadFreeGoesBackToOwner(void)
+{
+   struct TlheapJob job = { .sz = 200 };
+   for ( size_t i = 0; i < TLHEAP_TEST_BLOCKS; i++ )
+   {
+      job.blocks[i] = tlheap_alloc(job.sz, NULL);
+      TEST_ASSERT_NOT_NULL(job.blocks[i]);
+   }
+   job.blocks[TLHEAP_TEST_BLOCKS - 1] = tlheap_realloc( job.blocks[TLHEAP_TEST_BLOCKS - 1],
+                                                        (size_t)1 << (SLAB_MAX_CLASS_SHIFT + 1),
+                                                        job.sz, NULL );
+   TEST_ASSERT_NOT_NULL( job.blocks[TLHEAP_TEST_BLOCKS - 1] );
+
+   run_in_thread(tlheap_free_blocks, &job);
+
+   // Our next allocations of that size are served from what the other thread
+   // queued back to us
+   uint8_t * again[TLHEAP_TEST_BLOCKS - 1];
+   for ( size_t n = 0; n < ARR_LEN(again); n++ )
+   {
+      again[n] = tlheap_alloc(job.sz, NULL);
+      bool found = false;
+      for ( size_t i = 0; i < ARR_LEN(again); i++ )
+      {
+         if ( again[n] == job.blocks[i] )
+         {
+            found = true;
+            job.blocks[i] = NULL;
+         }
+      }
+      TEST_ASSERT_TRUE(found);
+   }
+   for ( size_t n = 0; n < ARR_LEN(again); n++ )
+   {
+      tlheap_reclaim(again[n], job.sz, NULL);
+   }
+}
+
+void test_TlheapRealloc_CrossThreadMovesToCaller(void)
+{
+   struct TlheapJob job = { .sz = 64 };
+   uint8_t * originals[TLHEAP_TEST_BLOCKS];
+   for ( size_t i = 0; i < TLHEAP_TEST_BLOCKS; i++ )
+   {
+      job.blocks[i] = originals[i] = tlheap_alloc(job.sz, NULL);
+      TEST_ASSERT_NOT_NULL(job.blocks[i]);
+      fill_pattern(job.blocks[i], job.sz, (uint8_t)i);
+   }
+
+   run_in_thread(tlheap_grow_blocks, &job);
+
+   for ( size_t i = 0; i < TLHEAP_TEST_BLOCKS; i++ )
+   {
+      TEST_ASSERT_NOT_NULL(job.blocks[i]);
+      TEST_ASSERT_TRUE( job.blocks[i] != originals[i] );
+      TEST_ASSERT_TRUE( has_pattern(job.blocks[i], 64, (uint8_t)i) );
+   }
+
+   // Blocks now belong to the exited thread's heap, and we can still free them
+   run_in_thread(tlheap_free_blocks, &job);
+}
+
+void test_TlheapThreadExit_HeapIsAdopted(void)
+{
+   // The first thread's heap outlives it, and the next thread picks it up
+   // (free list included) instead of setting up a heap of its own
+   struct TlheapJob job = { .sz = 48 };
+   run_in_thread(tlheap_alloc_then_free_one, &job);
+   run_in_thread(tlheap_alloc_one, &job);
+   TEST_ASSERT_NOT_NULL( job.blocks[0] );
+   TEST_ASSERT_EQUAL_PTR( job.blocks[0], job.blocks[1] );
+
+   // Heaps can also be handed back explicitly
+   uint8_t * ptr = tlheap_alloc(job.sz, NULL);
+   TEST_ASSERT_NOT_NULL(ptr);
+   tlheap_reclaim(ptr, job.sz, NULL);
+   tlheap_thread_detach();
+   run_in_thread(tlheap_alloc_one, &job);
+   TEST_ASSERT_TRUE( (job.blocks[1] == ptr) || (job.blocks[1] == job.blocks[0]) );
+}
+
+void test_TlheapAllocator_VectorHandedBetweenThreads(void)
+{
+   const struct Allocator mem_mgr = TLHEAP_ALLOCATOR;
+   struct TlheapJob job = { .vec = VectorNew(sizeof(uint32_t), 4, 5000, 0, &mem_mgr) };
+   TEST_ASSERT_NOT_NULL(job.vec);
+   uint32_t val = 0;
+   TEST_ASSERT_TRUE( VectorPush(job.vec, &val) );
+
+   // Grown on another thread (moving the buffer into that thread's heap)...
+   run_in_thread(tlheap_fill_vector, &job);
+   TEST_ASSERT_EQUAL_size_t( 2001, VectorLength(job.vec) );
+   TEST_ASSERT_EQUAL_UINT32( 1999, *(uint32_t *)VectorLastElement(job.vec) );
+
+   // ...and freed on this one
+   VectorFree(job.vec);
+   tlheap_destroy_all();
+}
+
+/************************** Statistics Allocator ******************************/
+
+static uint64_t sum_of(const uint64_t * buckets, size_t num_buckets)
+{
+   uint64_t sum = 0;
+   for ( size_t i = 0; i < num_buckets; i++ )
+   {
+      sum += buckets[i];
+   }
+   return sum;
+}
+
+#define STATS_JOB_ROUNDS   (1000)
+#define STATS_JOB_THREADS  (STATS_THREAD_SLOTS + 2) // Some share the last slot
+
+struct StatsJob
+{
+   struct StatsArena * arena;
+   void * kept; // Left for another thread to reclaim
+};
+
+static void * stats_churn(void * arg)
+{
+   struct StatsJob * job = arg;
+   for ( size_t i = 0; i < STATS_JOB_ROUNDS; i++ )
+   {
+      void * ptr = stats_alloc(64, job->arena);
+      if ( ptr != NULL )
+      {
+         ptr = stats_realloc(ptr, 128, 64, job->arena);
+      }
+      if ( NULL == ptr )
+      {
+         return NULL;
+      }
+      stats_reclaim(ptr, 128, job->arena);
+   }
+   job->kept = stats_alloc(256, job->arena);
+   return NULL;
+}
+
+void test_StatsAllocator_CountsVectorLifecycle(void)
+{
+   // Without usable_size (or try_expand_in_place, which relies on it), every
+   // byte count is exactly what the vector asked for
+   struct Allocator inner = DEFAULT_ALLOCATOR;
+   inner.usable_size = NULL;
+   inner.try_expand_in_place = NULL;
+
+   struct StatsArena arena;
+   const struct Allocator mem_mgr = stats_wrap(&arena, &inner);
+   TEST_ASSERT_NOT_NULL(mem_mgr.alloc);
+   TEST_ASSERT_NULL(mem_mgr.usable_size);
+   TEST_ASSERT_NULL(mem_mgr.try_expand_in_place);
+   TEST_ASSERT_NOT_NULL(mem_mgr.alloc_zeroed);
+
+   struct Vector * vec = VectorNew(sizeof(uint32_t), 4, 1000, 0, &mem_mgr);
+   TEST_ASSERT_NOT_NULL(vec);
+   for ( uint32_t i = 0; i < 100; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+   }
+
+   struct AllocStats stats;
+   stats_snapshot(&arena, &stats);
+   TEST_ASSERT_EQUAL_size_t( 1, (size_t)stats.allocs );
+   TEST_ASSERT_TRUE( stats.reallocs > 0 );
+   TEST_ASSERT_EQUAL_size_t( stats.reallocs, (size_t)sum_of(stats.realloc_sizes, STATS_SIZE_BUCKETS) );
+   TEST_ASSERT_EQUAL_size_t( 0, (size_t)stats.failures );
+   TEST_ASSERT_EQUAL_size_t( 1, stats.live_blocks );
+   TEST_ASSERT_EQUAL_size_t( VectorCapacity(vec) * sizeof(uint32_t), stats.live_bytes );
+   TEST_ASSERT_EQUAL_size_t( stats.live_bytes, stats.peak_bytes );
+
+   VectorFree(vec);
+   stats_snapshot(&arena, &stats);
+   TEST_ASSERT_EQUAL_size_t( 1, (size_t)stats.reclaims );
+   TEST_ASSERT_EQUAL_size_t( 0, stats.live_blocks );
+   TEST_ASSERT_EQUAL_size_t( 0, stats.live_bytes );
+   TEST_ASSERT_TRUE( stats.peak_bytes >= 100 * sizeof(uint32_t) );
+
+   // Incomplete allocators aren't wrapped
+   inner.realloc = NULL;
+   TEST_ASSERT_NULL( stats_wrap(&arena, &inner).alloc );
+}
+
+void test_StatsAllocator_UsableSizeAndReset(void)
+{
+   static uint8_t buf[1 << 16];
+   struct BumpArena bump;
+   bump_init(&bump, buf, sizeof(buf));
+   const struct Allocator inner = BUMP_ALLOCATOR(&bump);
+
+   struct StatsArena arena;
+   const struct Allocator mem_mgr = stats_wrap(&arena, &inner);
+   TEST_ASSERT_NOT_NULL(mem_mgr.reset);
+
+   // A lone vector in a bump arena grows in place, absorbing slack on the way
+   struct Vector * v1 = VectorNew(sizeof(uint8_t), 1, 4000, 0, &mem_mgr);
+   struct Vector * v2 = VectorNew(sizeof(uint8_t), 1, 4000, 0, &mem_mgr);
+   TEST_ASSERT_NOT_NULL(v1);
+   TEST_ASSERT_NOT_NULL(v2);
+   for ( uint8_t i = 0; i < 200; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(v2, &i) );
+   }
+
+   struct AllocStats stats;
+   stats_snapshot(&arena, &stats);
+   TEST_ASSERT_EQUAL_size_t( 2, (size_t)stats.allocs );
+   TEST_ASSERT_TRUE( stats.expands_in_place > 0 );
+   TEST_ASSERT_EQUAL_size_t( 2, stats.live_blocks );
+   TEST_ASSERT_EQUAL_size_t( bump_used(&bump), stats.live_bytes );
+
+   // Reclaiming a block counts it out, whatever size the vector grew it to
+   VectorFree(v2);
+   stats_snapshot(&arena, &stats);
+   TEST_ASSERT_EQUAL_size_t( 1, stats.live_blocks );
+   TEST_ASSERT_EQUAL_size_t( bump_usable_size(NULL, VectorCapacity(v1), NULL), stats.live_bytes );
+
+   // Resetting through the wrapper empties both the arena and the count
+   TEST_ASSERT_EQUAL_size_t( 1, VectorFreeAllWith(&mem_mgr) );
+   stats_snapshot(&arena, &stats);
+   TEST_ASSERT_EQUAL_size_t( 1, (size_t)stats.resets );
+   TEST_ASSERT_EQUAL_size_t( 0, stats.live_blocks );
+   TEST_ASSERT_EQUAL_size_t( 0, stats.live_bytes );
+   TEST_ASSERT_EQUAL_size_t( 0, bump_used(&bump) );
+}
+
+void test_StatsSnapshot_LatencyFailuresAndClear(void)
+{
+   static uint8_t buf[1024];
+   struct BumpArena bump;
+   bump_init(&bump, buf, sizeof(buf));
+   const struct Allocator inner = BUMP_ALLOCATOR(&bump);
+
+   struct StatsArena arena;
+   (void)stats_wrap(&arena, &inner);
+
+   const size_t num_allocs = 4 * STATS_LATENCY_SAMPLE_PERIOD;
+   for ( size_t i = 0; i < num_allocs; i++ )
+   {
+      TEST_ASSERT_NOT_NULL( stats_alloc(1, &arena) );
+   }
+   TEST_ASSERT_NULL( stats_alloc(sizeof(buf), &arena) );
+
+   struct AllocStats stats;
+   stats_snapshot(&arena, &stats);
+   TEST_ASSERT_EQUAL_size_t( num_allocs + 1, (size_t)stats.allocs );
+   TEST_ASSERT_EQUAL_size_t( 1, (size_t)stats.failures );
+   TEST_ASSERT_EQUAL_size_t( num_allocs, stats.live_blocks );
+   TEST_ASSERT_EQUAL_size_t( stats.latency_samples, (size_t)sum_of(stats.latency_ns, STATS_LATENCY_BUCKETS) );
+   TEST_ASSERT_TRUE( stats.latency_max_ns <= stats.latency_total_ns );
+#if ( STATS_LATENCY_SAMPLE_PERIOD > 0 ) && ( defined(__unix__) || defined(__APPLE__) )
+   TEST_ASSERT_EQUAL_size_t( 4, (size_t)stats.latency_samples );
+#endif
+
+   // Counts start over, but the blocks are still held
+   stats_clear(&arena);
+   stats_snapshot(&arena, &stats);
+   TEST_ASSERT_EQUAL_size_t( 0, (size_t)stats.allocs );
+   TEST_ASSERT_EQUAL_size_t( 0, (size_t)stats.failures );
+   TEST_ASSERT_EQUAL_size_t( 0, (size_t)stats.latency_samples );
+   TEST_ASSERT_EQUAL_size_t( num_allocs, stats.live_blocks );
+   TEST_ASSERT_EQUAL_size_t( stats.live_bytes, stats.peak_bytes );
+}
+
+void test_StatsAllocator_SharedByThreads(void)
+{
+   struct StatsArena arena;
+   const struct Allocator inner = DEFAULT_ALLOCATOR;
+   (void)stats_wrap(&arena, &inner);
+
+   struct StatsJob jobs[STATS_JOB_THREADS];
+   pthread_t threads[STATS_JOB_THREADS];
+   for ( size_t i = 0; i < STATS_JOB_THREADS; i++ )
+   {
+      jobs[i] = (struct StatsJob){ .arena = &arena, .kept = NULL };
+      TEST_ASSERT_EQUAL_INT( 0, pthread_create(&threads[i], NULL, stats_churn, &jobs[i]) );
+   }
+   size_t kept_bytes = 0;
+   for ( size_t i = 0; i < STATS_JOB_THREADS; i++ )
+   {
+      TEST_ASSERT_EQUAL_INT( 0, pthread_join(threads[i], NULL) );
+      TEST_ASSERT_NOT_NULL( jobs[i].kept );
+      kept_bytes += default_usable_size(jobs[i].kept, 256, NULL);
+   }
+
+   // Nothing is lost between threads counting at once, in slots of their own
+   // or the shared one
+   struct AllocStats stats;
+   stats_snapshot(&arena, &stats);
+   TEST_ASSERT_EQUAL_size_t( STATS_JOB_THREADS * (STATS_JOB_ROUNDS + 1), (size_t)stats.allocs );
+   TEST_ASSERT_EQUAL_size_t( STATS_JOB_THREADS * STATS_JOB_ROUNDS, (size_t)stats.reallocs );
+   TEST_ASSERT_EQUAL_size_t( STATS_JOB_THREADS * STATS_JOB_ROUNDS, (size_t)stats.reclaims );
+   TEST_ASSERT_EQUAL_size_t( STATS_JOB_THREADS, stats.live_blocks );
+   TEST_ASSERT_EQUAL_size_t( kept_bytes, stats.live_bytes );
+
+   // Blocks reclaimed on another thread than they were allocated on still
+   // count out of the totals
+   for ( size_t i = 0; i < STATS_JOB_THREADS; i++ )
+   {
+      stats_reclaim(jobs[i].kept, 256, &arena);
+   }
+   stats_snapshot(&arena, &stats);
+   TEST_ASSERT_EQUAL_size_t( 0, stats.live_blocks );
+   TEST_ASSERT_EQUAL_size_t( 0, stats.live_bytes );
+
+   // A vector growing through malloc's usable sizes is counted at the size of
+   // the block it ends up in
+   const struct Allocator mem_mgr = stats_wrap(&arena, &inner);
+   struct Vector * vec = VectorNew(sizeof(uint32_t), 1, 10000, 0, &mem_mgr);
+   TEST_ASSERT_NOT_NULL(vec);
+   for ( uint32_t i = 0; i < 10000; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+   }
+   stats_snapshot(&arena, &stats);
+   TEST_ASSERT_EQUAL_size_t( 1, stats.live_blocks );
+   TEST_ASSERT_EQUAL_size_t( default_usable_size(VectorGet(vec, 0), VectorCapacity(vec) * sizeof(uint32_t), NULL),
+                             stats.live_bytes );
+   VectorFree(vec);
+   stats_snapshot(&arena, &stats);
+   TEST_ASSERT_EQUAL_size_t( 0, stats.live_bytes );
+}
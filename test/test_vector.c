@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <float.h>
 #include <time.h>
 #include <unity/unity.h>
@@ -77,6 +78,97 @@ static const struct Allocator TestNilMemMgr =
    .arena = NULL
 };
 
+// Allocator that tracks which of its hooks were used, so that tests can
+// confirm which allocation paths the vector takes.
+struct TestCountingArena
+{
+   size_t alloc_calls;
+   size_t alloc_zeroed_calls;
+   size_t realloc_calls;
+   size_t reclaim_calls;
+   size_t in_place_calls;
+   size_t init_calls;
+   size_t deinit_calls;
+   size_t block_sz; // Minimum size of the blocks handed out by test_block_alloc
+};
+
+void * test_counting_alloc(size_t req_sz, void * ctx);
+void * test_counting_alloc_zeroed(size_t req_sz, void * ctx);
+void * test_counting_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * ctx);
+void test_counting_reclaim(void * old_ptr, size_t old_sz, void * ctx);
+void test_counting_init(void * ctx);
+void test_counting_deinit(void * ctx);
+void * test_block_alloc(size_t req_sz, void * ctx);
+bool test_block_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * ctx);
+size_t test_block_usable_size(void * ptr, size_t req_sz, void * ctx);
+
+void * test_counting_alloc(size_t req_sz, void * ctx)
+{
+   ((struct TestCountingArena *)ctx)->alloc_calls++;
+   void * ptr = malloc(req_sz);
+   // Deliberately dirty the memory so that zero-initialization can't pass by luck
+   if ( ptr != NULL ) memset(ptr, 0xA5, req_sz);
+   return ptr;
+}
+
+void * test_counting_alloc_zeroed(size_t req_sz, void * ctx)
+{
+   ((struct TestCountingArena *)ctx)->alloc_zeroed_calls++;
+   return calloc(1, req_sz);
+}
+
+void * test_counting_realloc(void * old_ptr, size_t new_sz, size_t old_sz, void * ctx)
+{
+   (void)old_sz;
+   ((struct TestCountingArena *)ctx)->realloc_calls++;
+   return realloc(old_ptr, new_sz);
+}
+
+void test_counting_reclaim(void * old_ptr, size_t old_sz, void * ctx)
+{
+   (void)old_sz;
+   ((struct TestCountingArena *)ctx)->reclaim_calls++;
+   free(old_ptr);
+}
+
+void test_counting_init(void * ctx)
+{
+   ((struct TestCountingArena *)ctx)->init_calls++;
+}
+
+void test_counting_deinit(void * ctx)
+{
+   struct TestCountingArena * arena = ctx;
+   // Every block must have been given back before the arena is torn down
+   TEST_ASSERT_EQUAL_size_t( arena->alloc_calls + arena->alloc_zeroed_calls, arena->reclaim_calls );
+   arena->deinit_calls++;
+}
+
+// Hands out blocks of at least arena->block_sz bytes, so that the vector has
+// room to grow into without reallocating.
+void * test_block_alloc(size_t req_sz, void * ctx)
+{
+   struct TestCountingArena * arena = ctx;
+   arena->alloc_calls++;
+   return malloc( (req_sz > arena->block_sz) ? req_sz : arena->block_sz );
+}
+
+bool test_block_try_expand_in_place(void * ptr, size_t new_sz, size_t old_sz, void * ctx)
+{
+   (void)ptr;
+   (void)old_sz;
+   struct TestCountingArena * arena = ctx;
+   arena->in_place_calls++;
+   return new_sz <= arena->block_sz;
+}
+
+size_t test_block_usable_size(void * ptr, size_t req_sz, void * ctx)
+{
+   (void)ptr;
+   struct TestCountingArena * arena = ctx;
+   return (req_sz > arena->block_sz) ? req_sz : arena->block_sz;
+}
+
 /* Forward Function Declarations */
 
 void setUp(void);
@@ -91,6 +183,34 @@ void test_VectorNew_CapacityLimit(void);
 void test_VectorNew_ElementSzLimit(void);
 void test_VectorNew_InitialLenLessThanInitialCap(void);
 void test_VectorNew_InitialLenSameAsInitialCap(void);
+void test_VectorNew_InitialLenUsesZeroedAlloc(void);
+void test_VectorNew_InitialLenWithoutZeroedAlloc(void);
+void test_VectorNew_NoInitialLenSkipsZeroedAlloc(void);
+void test_VectorNewWithAttr_NullAttrSameAsVectorNew(void);
+void test_VectorNewWithAttr_StablePointersSurviveGrowth(void);
+void test_VectorNewWithAttr_StableInitialLenIsZeroed(void);
+void test_VectorNewWithAttr_StableDuplicateMoveAndHardReset(void);
+void test_VectorNewWithAttr_StableReservationTooLarge(void);
+void test_VectorNewWithAttr_AlignedStorageSurvivesGrowth(void);
+void test_VectorNewWithAttr_AlignedDerivedVectors(void);
+void test_VectorNewWithAttr_AlignedInitialLenIsZeroed(void);
+void test_VectorNewWithAttr_InvalidAlignment(void);
+void test_VectorNewWithAttr_RealtimeNeverCallsAllocator(void);
+void test_VectorNewWithAttr_RealtimeStableLockedAndDuplicated(void);
+void test_VectorNewWithAttr_RealtimeMovedFrom(void);
+void test_VectorNew_UnmanagedAllocatorInitPerVector(void);
+void test_VectorNew_ManagedAllocatorInitOnce(void);
+void test_VectorNew_ManagedAllocatorOutlivesDerivedVectors(void);
+void test_AllocatorInit_IncompleteOrRepeated(void);
+void test_VectorPool_ExhaustedThenReused(void);
+void test_VectorFreeAllWith_OnlyThatAllocatorsVectors(void);
+void test_VectorRecycle_FreedArrayReused(void);
+void test_VectorRecycle_BudgetSlotsAndFlush(void);
+void test_VectorStats_CountsPerVectorAndTotals(void);
+void test_VectorStats_ExportText(void);
+void test_VectorPool_InfoAndRanking(void);
+void test_VectorTrace_DecodeRecord(void);
+void test_VectorTrace_RecordsCalls(void);
 
 void test_VectorOpsOnNullVectors(void);
 
@@ -110,6 +230,8 @@ void test_VectorPush_IntoVecWithZeroMaxCap(void);
 void test_VectorPush_InitialCapOfZero(void);
 void test_VectorPush_AfterResetting(void);
 void test_VectorPush_AfterHardResetting(void);
+void test_VectorPush_AbsorbsAllocatorSlack(void);
+void test_VectorPush_ExpandsInPlace(void);
 
 void test_VectorInsertion_AtZeroWithVectorLessThanCapacity(void);
 void test_VectorInsertion_AtZeroWithVectorAtCapacity(void);
@@ -207,6 +329,7 @@ void test_VectorConcatenate_FullVectors(void);
 void test_VectorConcatenate_NullArguments(void);
 void test_VectorConcatenate_DifferentElementSizes(void);
 void test_VectorConcatenate_ConcatenateSplitRoundTrip(void);
+void test_VectorRangeOpsWith_OtherAllocator(void);
 
 void test_VectorRangePush_ValidInts(void);
 void test_VectorRangePush_ValidStructs(void);
@@ -216,6 +339,7 @@ void test_VectorRangePush_NullVec(void);
 void test_VectorRangePush_NullData(void);
 void test_VectorRangePush_ExceedsMaxCapacity(void);
 void test_VectorRangePush_ExactlyMaxCapacity(void);
+void test_VectorRangePush_AbsorbsAllocatorSlack(void);
 
 void test_VectorRangeInsert_ValidInts(void);
 void test_VectorRangeInsert_ValidStructs(void);
@@ -309,6 +433,34 @@ int main(void)
    RUN_TEST(test_VectorNew_ElementSzLimit);
    RUN_TEST(test_VectorNew_InitialLenLessThanInitialCap);
    RUN_TEST(test_VectorNew_InitialLenSameAsInitialCap);
+   RUN_TEST(test_VectorNew_InitialLenUsesZeroedAlloc);
+   RUN_TEST(test_VectorNew_InitialLenWithoutZeroedAlloc);
+   RUN_TEST(test_VectorNew_NoInitialLenSkipsZeroedAlloc);
+   RUN_TEST(test_VectorNewWithAttr_NullAttrSameAsVectorNew);
+   RUN_TEST(test_VectorNewWithAttr_StablePointersSurviveGrowth);
+   RUN_TEST(test_VectorNewWithAttr_StableInitialLenIsZeroed);
+   RUN_TEST(test_VectorNewWithAttr_StableDuplicateMoveAndHardReset);
+   RUN_TEST(test_VectorNewWithAttr_StableReservationTooLarge);
+   RUN_TEST(test_VectorNewWithAttr_AlignedStorageSurvivesGrowth);
+   RUN_TEST(test_VectorNewWithAttr_AlignedDerivedVectors);
+   RUN_TEST(test_VectorNewWithAttr_AlignedInitialLenIsZeroed);
+   RUN_TEST(test_VectorNewWithAttr_InvalidAlignment);
+   RUN_TEST(test_VectorNewWithAttr_RealtimeNeverCallsAllocator);
+   RUN_TEST(test_VectorNewWithAttr_RealtimeStableLockedAndDuplicated);
+   RUN_TEST(test_VectorNewWithAttr_RealtimeMovedFrom);
+   RUN_TEST(test_VectorNew_UnmanagedAllocatorInitPerVector);
+   RUN_TEST(test_VectorNew_ManagedAllocatorInitOnce);
+   RUN_TEST(test_VectorNew_ManagedAllocatorOutlivesDerivedVectors);
+   RUN_TEST(test_AllocatorInit_IncompleteOrRepeated);
+   RUN_TEST(test_VectorPool_ExhaustedThenReused);
+   RUN_TEST(test_VectorFreeAllWith_OnlyThatAllocatorsVectors);
+   RUN_TEST(test_VectorRecycle_FreedArrayReused);
+   RUN_TEST(test_VectorRecycle_BudgetSlotsAndFlush);
+   RUN_TEST(test_VectorStats_CountsPerVectorAndTotals);
+   RUN_TEST(test_VectorStats_ExportText);
+   RUN_TEST(test_VectorPool_InfoAndRanking);
+   RUN_TEST(test_VectorTrace_DecodeRecord);
+   RUN_TEST(test_VectorTrace_RecordsCalls);
 
    RUN_TEST(test_VectorOpsOnNullVectors);
 
@@ -328,6 +480,8 @@ int main(void)
    RUN_TEST(test_VectorPush_InitialCapOfZero);
    RUN_TEST(test_VectorPush_AfterResetting);
    RUN_TEST(test_VectorPush_AfterHardResetting);
+   RUN_TEST(test_VectorPush_AbsorbsAllocatorSlack);
+   RUN_TEST(test_VectorPush_ExpandsInPlace);
 
    RUN_TEST(test_VectorInsertion_AtZeroWithVectorLessThanCapacity);
    RUN_TEST(test_VectorInsertion_AtZeroWithVectorAtCapacity);
@@ -425,6 +579,7 @@ int main(void)
    RUN_TEST(test_VectorConcatenate_NullArguments);
    RUN_TEST(test_VectorConcatenate_DifferentElementSizes);
    RUN_TEST(test_VectorConcatenate_ConcatenateSplitRoundTrip);
+   RUN_TEST(test_VectorRangeOpsWith_OtherAllocator);
 
    RUN_TEST(test_VectorRangePush_ValidInts);
    RUN_TEST(test_VectorRangePush_ValidStructs);
@@ -434,6 +589,7 @@ int main(void)
    RUN_TEST(test_VectorRangePush_NullData);
    RUN_TEST(test_VectorRangePush_ExceedsMaxCapacity);
    RUN_TEST(test_VectorRangePush_ExactlyMaxCapacity);
+   RUN_TEST(test_VectorRangePush_AbsorbsAllocatorSlack);
 
    RUN_TEST(test_VectorRangeInsert_ValidInts);
    RUN_TEST(test_VectorRangeInsert_ValidStructs);
@@ -524,6 +680,9 @@ void setUp(void)
 
 void tearDown(void)
 {
+   // So that a test that fails midway doesn't leave recycling on for the rest
+   VectorRecycleSetBudget(VEC_RECYCLE_BUDGET);
+   VectorRecycleFlush();
    UnityMalloc_EndTest();
 }
 
@@ -646,6 +805,1127 @@ void test_VectorNew_InitialLenSameAsInitialCap(void)
    VectorFree(vec);
 }
 
+void test_VectorNew_InitialLenUsesZeroedAlloc(void)
+{
+   struct TestCountingArena arena = {0};
+   const struct Allocator mem_mgr =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena,
+      .alloc_zeroed = test_counting_alloc_zeroed
+   };
+   const size_t INIT_LENS[] = { 1, 10, 1000 };
+   for ( size_t i = 0; i < ARR_LEN(INIT_LENS); i++ )
+   {
+      arena = (struct TestCountingArena){0};
+      struct Vector * vec = VectorNew(sizeof(int), INIT_LENS[i], INIT_LENS[i] * 2, INIT_LENS[i], &mem_mgr);
+      TEST_ASSERT_NOT_NULL(vec);
+      TEST_ASSERT_EQUAL_size_t( 1, arena.alloc_zeroed_calls );
+      TEST_ASSERT_EQUAL_size_t( 0, arena.alloc_calls );
+      TEST_ASSERT_EQUAL_size_t( INIT_LENS[i], VectorLength(vec) );
+      for ( size_t j = 0; j < INIT_LENS[i]; j++ )
+      {
+         TEST_ASSERT_EQUAL_INT( 0, *(int *)VectorGet(vec, j) );
+      }
+      VectorFree(vec);
+      TEST_ASSERT_EQUAL_size_t( 1, arena.reclaim_calls );
+   }
+}
+
+void test_VectorNew_InitialLenWithoutZeroedAlloc(void)
+{
+   // Allocator that doesn't provide the optional hook and hands back dirty memory
+   struct TestCountingArena arena = {0};
+   const struct Allocator mem_mgr =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena
+   };
+   const size_t INIT_LENS[] = { 1, 10, 1000 };
+   for ( size_t i = 0; i < ARR_LEN(INIT_LENS); i++ )
+   {
+      arena = (struct TestCountingArena){0};
+      struct Vector * vec = VectorNew(sizeof(int), INIT_LENS[i], INIT_LENS[i] * 2, INIT_LENS[i], &mem_mgr);
+      TEST_ASSERT_NOT_NULL(vec);
+      TEST_ASSERT_EQUAL_size_t( 1, arena.alloc_calls );
+      for ( size_t j = 0; j < INIT_LENS[i]; j++ )
+      {
+         TEST_ASSERT_EQUAL_INT( 0, *(int *)VectorGet(vec, j) );
+      }
+      VectorFree(vec);
+   }
+}
+
+void test_VectorNew_NoInitialLenSkipsZeroedAlloc(void)
+{
+   // Nothing to zero, so the plain alloc should be used
+   struct TestCountingArena arena = {0};
+   const struct Allocator mem_mgr =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena,
+      .alloc_zeroed = test_counting_alloc_zeroed
+   };
+   struct Vector * vec = VectorNew(sizeof(int), 10, 100, 0, &mem_mgr);
+   TEST_ASSERT_NOT_NULL(vec);
+   TEST_ASSERT_EQUAL_size_t( 1, arena.alloc_calls );
+   TEST_ASSERT_EQUAL_size_t( 0, arena.alloc_zeroed_calls );
+   VectorFree(vec);
+}
+
+void test_VectorNewWithAttr_NullAttrSameAsVectorNew(void)
+{
+   const struct VectorAttr NO_ATTR = {0};
+   struct Vector * a = VectorNew(sizeof(int), 10, 100, 5, NULL);
+   struct Vector * b = VectorNewWithAttr(sizeof(int), 10, 100, 5, NULL, NULL);
+   struct Vector * c = VectorNewWithAttr(sizeof(int), 10, 100, 5, NULL, &NO_ATTR);
+   TEST_ASSERT_NOT_NULL(a);
+   TEST_ASSERT_NOT_NULL(b);
+   TEST_ASSERT_NOT_NULL(c);
+   TEST_ASSERT_TRUE( VectorsAreEqual(a, b) );
+   TEST_ASSERT_TRUE( VectorsAreEqual(a, c) );
+   TEST_ASSERT_TRUE( VectorMove(b, c) ); // Same attributes
+   VectorFree(a);
+   VectorFree(b);
+   VectorFree(c);
+}
+
+void test_VectorNewWithAttr_StablePointersSurviveGrowth(void)
+{
+   const struct VectorAttr ATTR = { .stable_addresses = true };
+   const size_t MAX_LEN = 1000 * 1000;
+   struct Vector * vec = VectorNewWithAttr(sizeof(uint32_t), 0, MAX_LEN, 0, NULL, &ATTR);
+   TEST_ASSERT_NOT_NULL(vec);
+   TEST_ASSERT_TRUE( VectorCapacity(vec) > 0 ); // At least a page is committed
+
+   uint32_t val = 0;
+   TEST_ASSERT_TRUE( VectorPush(vec, &val) );
+   const uint32_t * first = VectorGet(vec, 0);
+
+   for ( val = 1; val < MAX_LEN; val++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &val) );
+   }
+   TEST_ASSERT_FALSE( VectorPush(vec, &val) ); // Reservation is exhausted
+   TEST_ASSERT_EQUAL_size_t( MAX_LEN, VectorCapacity(vec) );
+
+   // Nothing ever moved
+   TEST_ASSERT_EQUAL_PTR( first, VectorGet(vec, 0) );
+   for ( size_t i = 0; i < MAX_LEN; i += 997 )
+   {
+      TEST_ASSERT_EQUAL_PTR( first + i, VectorGet(vec, i) );
+      TEST_ASSERT_EQUAL_UINT32( i, first[i] );
+   }
+
+   // Resetting keeps the committed pages around
+   const uint32_t VALS[] = { 5, 4, 3, 2, 1 };
+   VectorReset(vec);
+   TEST_ASSERT_TRUE( VectorRangePush(vec, VALS, ARR_LEN(VALS)) );
+   TEST_ASSERT_EQUAL_PTR( first, VectorGet(vec, 0) );
+   TEST_ASSERT_EQUAL_UINT32( 5, first[0] );
+
+   VectorFree(vec);
+}
+
+void test_VectorNewWithAttr_StableInitialLenIsZeroed(void)
+{
+   const struct VectorAttr ATTR = { .stable_addresses = true };
+   const size_t INIT_LEN = 5000;
+   struct Vector * vec = VectorNewWithAttr(sizeof(uint64_t), INIT_LEN, INIT_LEN * 10, INIT_LEN, NULL, &ATTR);
+   TEST_ASSERT_NOT_NULL(vec);
+   TEST_ASSERT_EQUAL_size_t( INIT_LEN, VectorLength(vec) );
+   TEST_ASSERT_TRUE( VectorCapacity(vec) >= INIT_LEN );
+   TEST_ASSERT_TRUE( VectorCapacity(vec) <= VectorMaxCapacity(vec) );
+   for ( size_t i = 0; i < INIT_LEN; i++ )
+   {
+      TEST_ASSERT_TRUE( 0 == *(uint64_t *)VectorGet(vec, i) );
+   }
+   VectorFree(vec);
+}
+
+void test_VectorNewWithAttr_StableDuplicateMoveAndHardReset(void)
+{
+   const struct VectorAttr ATTR = { .stable_addresses = true };
+   struct Vector * vec = VectorNewWithAttr(sizeof(int), 10, 100000, 0, NULL, &ATTR);
+   TEST_ASSERT_NOT_NULL(vec);
+   for ( int i = 0; i < 50000; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+   }
+
+   struct Vector * dup = VectorDuplicate(vec);
+   TEST_ASSERT_NOT_NULL(dup);
+   TEST_ASSERT_TRUE( VectorsAreEqual(vec, dup) );
+   TEST_ASSERT_TRUE( VectorGet(vec, 0) != VectorGet(dup, 0) );
+
+   // Growing the duplicate keeps its elements in place as well
+   const int * dup_first = VectorGet(dup, 0);
+   for ( int i = 50000; i < 100000; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(dup, &i) );
+   }
+   TEST_ASSERT_EQUAL_PTR( dup_first, VectorGet(dup, 0) );
+   TEST_ASSERT_EQUAL_INT( 99999, *(int *)VectorLastElement(dup) );
+
+   // Moving between stable and regular vectors isn't allowed
+   struct Vector * regular = VectorNew(sizeof(int), 10, 100000, 0, NULL);
+   TEST_ASSERT_FALSE( VectorMove(regular, vec) );
+   TEST_ASSERT_FALSE( VectorMove(vec, regular) );
+
+   const int * vec_first = VectorGet(vec, 0);
+   TEST_ASSERT_TRUE( VectorMove(dup, vec) );
+   TEST_ASSERT_EQUAL_PTR( vec_first, VectorGet(dup, 0) );
+   TEST_ASSERT_EQUAL_size_t( 50000, VectorLength(dup) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorLength(vec) );
+
+   // A moved-from or hard-reset stable vector reserves again on demand
+   int val = 7;
+   TEST_ASSERT_TRUE( VectorPush(vec, &val) );
+   TEST_ASSERT_TRUE( VectorHardReset(dup) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorCapacity(dup) );
+   TEST_ASSERT_TRUE( VectorPush(dup, &val) );
+   TEST_ASSERT_EQUAL_INT( 7, *(int *)VectorGet(dup, 0) );
+
+   VectorFree(regular);
+   VectorFree(dup);
+   VectorFree(vec);
+}
+
+void test_VectorNewWithAttr_StableReservationTooLarge(void)
+{
+   const struct VectorAttr ATTR = { .stable_addresses = true };
+   TEST_ASSERT_NULL( VectorNewWithAttr(SIZE_MAX / 4, 1, 8, 0, NULL, &ATTR) );
+   // Which must not leak a handle from the pool
+   struct Vector * vecs[VEC_STRUCT_POOL_SIZE] = {0};
+   for ( size_t i = 0; i < VEC_STRUCT_POOL_SIZE; i++ )
+   {
+      vecs[i] = VectorNew(sizeof(int), 1, 1, 0, NULL);
+      TEST_ASSERT_NOT_NULL(vecs[i]);
+   }
+   for ( size_t i = 0; i < VEC_STRUCT_POOL_SIZE; i++ )
+   {
+      VectorFree(vecs[i]);
+   }
+}
+
+void test_VectorNewWithAttr_AlignedStorageSurvivesGrowth(void)
+{
+   struct Record { uint8_t bytes[64]; };
+   const size_t ALIGNMENTS[] = { 16, 32, 64, 4096 };
+   for ( size_t i = 0; i < ARR_LEN(ALIGNMENTS); i++ )
+   {
+      const struct VectorAttr ATTR = { .alignment = ALIGNMENTS[i] };
+      struct Vector * vec = VectorNewWithAttr(sizeof(struct Record), 1, 20000, 0, NULL, &ATTR);
+      TEST_ASSERT_NOT_NULL(vec);
+
+      struct Record rec;
+      for ( size_t j = 0; j < 20000; j++ )
+      {
+         memset( rec.bytes, (int)(j & 0xFF), sizeof(rec.bytes) );
+         TEST_ASSERT_TRUE( VectorPush(vec, &rec) );
+         TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)VectorGet(vec, 0) % ALIGNMENTS[i] );
+      }
+      for ( size_t j = 0; j < 20000; j += 101 )
+      {
+         const struct Record * ptr = VectorGet(vec, j);
+         if ( ALIGNMENTS[i] <= sizeof(struct Record) )
+         {
+            // Every record is aligned when its size is a multiple of the alignment
+            TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)ptr % ALIGNMENTS[i] );
+         }
+         TEST_ASSERT_EQUAL_UINT8( j & 0xFF, ptr->bytes[0] );
+         TEST_ASSERT_EQUAL_UINT8( j & 0xFF, ptr->bytes[63] );
+      }
+
+      // Same alignment is required to move between vectors
+      struct Vector * unaligned = VectorNew(sizeof(struct Record), 1, 20000, 0, NULL);
+      TEST_ASSERT_FALSE( VectorMove(unaligned, vec) );
+      VectorFree(unaligned);
+
+      VectorFree(vec);
+   }
+}
+
+void test_VectorNewWithAttr_AlignedDerivedVectors(void)
+{
+   const size_t ALIGNMENT = 64;
+   const struct VectorAttr ATTR = { .alignment = ALIGNMENT };
+   struct Vector * vec = VectorNewWithAttr(sizeof(double), 10, 1000, 0, NULL, &ATTR);
+   TEST_ASSERT_NOT_NULL(vec);
+   for ( int i = 0; i < 100; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &(double){ i * 0.5 }) );
+   }
+
+   struct Vector * derived[] =
+   {
+      VectorDuplicate(vec),
+      VectorSlice(vec, 3, 50),
+      VectorConcatenate(vec, vec),
+      VectorSplitAt(vec, 60), // Last, since it truncates vec
+   };
+   for ( size_t i = 0; i < ARR_LEN(derived); i++ )
+   {
+      TEST_ASSERT_NOT_NULL(derived[i]);
+      TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)VectorGet(derived[i], 0) % ALIGNMENT );
+      // And they keep it as they grow
+      for ( int j = 0; j < 100; j++ )
+      {
+         TEST_ASSERT_TRUE( VectorPush(derived[i], &(double){ -1.0 }) );
+      }
+      TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)VectorGet(derived[i], 0) % ALIGNMENT );
+      VectorFree(derived[i]);
+   }
+
+   VectorFree(vec);
+}
+
+void test_VectorNewWithAttr_AlignedInitialLenIsZeroed(void)
+{
+   const struct VectorAttr ATTR = { .alignment = 32 };
+   struct Vector * vec = VectorNewWithAttr(sizeof(int), 100, 1000, 100, NULL, &ATTR);
+   TEST_ASSERT_NOT_NULL(vec);
+   TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)VectorGet(vec, 0) % 32 );
+   for ( size_t i = 0; i < 100; i++ )
+   {
+      TEST_ASSERT_EQUAL_INT( 0, *(int *)VectorGet(vec, i) );
+   }
+   VectorFree(vec);
+
+   // Stable vectors are page-aligned anyways
+   const struct VectorAttr STABLE_ATTR = { .alignment = 64, .stable_addresses = true };
+   vec = VectorNewWithAttr(sizeof(int), 100, 1000, 100, NULL, &STABLE_ATTR);
+   TEST_ASSERT_NOT_NULL(vec);
+   TEST_ASSERT_EQUAL_size_t( 0, (uintptr_t)VectorGet(vec, 0) % 64 );
+   VectorFree(vec);
+}
+
+void test_VectorNewWithAttr_InvalidAlignment(void)
+{
+   const size_t BAD_ALIGNMENTS[] = { 3, 24, 48, 100 };
+   for ( size_t i = 0; i < ARR_LEN(BAD_ALIGNMENTS); i++ )
+   {
+      const struct VectorAttr ATTR = { .alignment = BAD_ALIGNMENTS[i] };
+      TEST_ASSERT_NULL( VectorNewWithAttr(sizeof(int), 10, 100, 0, NULL, &ATTR) );
+   }
+
+   // Allocator that can't honor an alignment
+   struct TestCountingArena arena = {0};
+   const struct Allocator mem_mgr =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena
+   };
+   const struct VectorAttr ATTR = { .alignment = 64 };
+   TEST_ASSERT_NULL( VectorNewWithAttr(sizeof(int), 10, 100, 0, &mem_mgr, &ATTR) );
+   TEST_ASSERT_EQUAL_size_t( 0, arena.alloc_calls );
+
+   // Beyond a page, a reservation can't be relied upon to be aligned
+   const struct VectorAttr STABLE_ATTR = { .alignment = 1u << 30, .stable_addresses = true };
+   TEST_ASSERT_NULL( VectorNewWithAttr(sizeof(int), 10, 100, 0, NULL, &STABLE_ATTR) );
+}
+
+void test_VectorNewWithAttr_RealtimeNeverCallsAllocator(void)
+{
+   struct TestCountingArena arena = {0};
+   const struct Allocator mem_mgr =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena,
+      .alloc_zeroed = test_counting_alloc_zeroed
+   };
+   const struct VectorAttr ATTR = { .realtime = true };
+
+   // The whole max capacity is allocated up front, whatever the initial capacity
+   struct Vector * vec = VectorNewWithAttr(sizeof(uint32_t), 4, 1000, 2, &mem_mgr, &ATTR);
+   TEST_ASSERT_NOT_NULL(vec);
+   TEST_ASSERT_EQUAL_size_t( 1000, VectorCapacity(vec) );
+   TEST_ASSERT_EQUAL_size_t( 2, VectorLength(vec) );
+   TEST_ASSERT_EQUAL_UINT32( 0, *(uint32_t *)VectorGet(vec, 1) );
+   const size_t ALLOCS = arena.alloc_calls + arena.alloc_zeroed_calls;
+   TEST_ASSERT_EQUAL_size_t( 1, ALLOCS );
+
+   for ( uint32_t i = 2; i < 1000; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+   }
+   TEST_ASSERT_EQUAL_size_t( 0, VectorRealtimeViolations(vec) );
+
+   // Anything that no longer fits is refused and counted
+   uint32_t vals[2] = { 1, 2 };
+   TEST_ASSERT_FALSE( VectorPush(vec, &vals[0]) );
+   TEST_ASSERT_FALSE( VectorInsert(vec, 0, &vals[0]) );
+   TEST_ASSERT_FALSE( VectorRangePush(vec, vals, 2) );
+   TEST_ASSERT_FALSE( VectorRangeInsert(vec, 0, vals, 2) );
+   TEST_ASSERT_EQUAL_size_t( 4, VectorRealtimeViolations(vec) );
+
+   // A hard reset keeps the array
+   TEST_ASSERT_TRUE( VectorHardReset(vec) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorLength(vec) );
+   TEST_ASSERT_EQUAL_size_t( 1000, VectorCapacity(vec) );
+   TEST_ASSERT_TRUE( VectorRangePush(vec, vals, 2) );
+
+   TEST_ASSERT_EQUAL_size_t( ALLOCS, arena.alloc_calls + arena.alloc_zeroed_calls );
+   TEST_ASSERT_EQUAL_size_t( 0, arena.realloc_calls );
+   TEST_ASSERT_EQUAL_size_t( 0, arena.reclaim_calls );
+   VectorFree(vec);
+   TEST_ASSERT_EQUAL_size_t( 1, arena.reclaim_calls );
+
+   // Regular vectors don't count anything
+   struct Vector * regular = VectorNew(sizeof(uint32_t), 1, 1, 0, NULL);
+   TEST_ASSERT_TRUE( VectorPush(regular, &vals[0]) );
+   TEST_ASSERT_FALSE( VectorPush(regular, &vals[0]) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorRealtimeViolations(regular) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorRealtimeViolations(NULL) );
+   VectorFree(regular);
+}
+
+void test_VectorNewWithAttr_RealtimeMovedFrom(void)
+{
+   const struct VectorAttr ATTRS[] =
+   {
+      { .realtime = true },
+      { .realtime = true, .stable_addresses = true },
+   };
+   for ( size_t a = 0; a < ARR_LEN(ATTRS); a++ )
+   {
+      struct Vector * src = VectorNewWithAttr(sizeof(uint32_t), 0, 100, 0, NULL, &ATTRS[a]);
+      struct Vector * dest = VectorNewWithAttr(sizeof(uint32_t), 0, 50, 0, NULL, &ATTRS[a]);
+      TEST_ASSERT_NOT_NULL(src);
+      TEST_ASSERT_NOT_NULL(dest);
+      for ( uint32_t i = 0; i < 100; i++ )
+      {
+         TEST_ASSERT_TRUE( VectorPush(src, &i) );
+      }
+      const void * moved_arr = VectorGet(src, 0);
+
+      TEST_ASSERT_TRUE( VectorMove(dest, src) );
+      TEST_ASSERT_EQUAL_PTR( moved_arr, VectorGet(dest, 0) );
+      TEST_ASSERT_EQUAL_size_t( 100, VectorLength(dest) );
+      TEST_ASSERT_EQUAL_size_t( 100, VectorCapacity(dest) );
+
+      // The moved-from vector is empty, but still has a whole array to work in
+      TEST_ASSERT_EQUAL_size_t( 0, VectorLength(src) );
+      TEST_ASSERT_EQUAL_size_t( 50, VectorCapacity(src) );
+      TEST_ASSERT_EQUAL_size_t( 50, VectorMaxCapacity(src) );
+      uint32_t val = 7;
+      TEST_ASSERT_TRUE( VectorPush(src, &val) );
+      TEST_ASSERT_TRUE( VectorInsert(src, 0, &val) );
+      TEST_ASSERT_EQUAL_size_t( 0, VectorRealtimeViolations(src) );
+
+      struct Vector * dup = VectorDuplicate(src);
+      TEST_ASSERT_NOT_NULL(dup);
+      TEST_ASSERT_TRUE( VectorsAreEqual(src, dup) );
+      TEST_ASSERT_TRUE( VectorPush(dup, &val) );
+
+      VectorFree(dup);
+      VectorFree(dest);
+      VectorFree(src);
+   }
+}
+
+void test_VectorNewWithAttr_RealtimeStableLockedAndDuplicated(void)
+{
+   const struct VectorAttr ATTRS[] =
+   {
+      { .realtime = true, .lock_memory = true },
+      { .realtime = true, .lock_memory = true, .stable_addresses = true },
+      { .realtime = true, .alignment = 64 },
+   };
+   for ( size_t a = 0; a < ARR_LEN(ATTRS); a++ )
+   {
+      struct Vector * vec = VectorNewWithAttr(sizeof(uint64_t), 0, 3000, 0, NULL, &ATTRS[a]);
+      TEST_ASSERT_NOT_NULL(vec);
+      TEST_ASSERT_EQUAL_size_t( 3000, VectorCapacity(vec) );
+      const uint64_t * first = NULL;
+      for ( uint64_t i = 0; i < 3000; i++ )
+      {
+         TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+         if ( 0 == i ) first = VectorGet(vec, 0);
+      }
+      TEST_ASSERT_EQUAL_PTR( first, VectorGet(vec, 0) );
+      TEST_ASSERT_FALSE( VectorPush(vec, first) );
+      TEST_ASSERT_EQUAL_size_t( 1, VectorRealtimeViolations(vec) );
+
+      // The duplicate is realtime too, with a clean slate
+      struct Vector * dup = VectorDuplicate(vec);
+      TEST_ASSERT_NOT_NULL(dup);
+      TEST_ASSERT_TRUE( VectorsAreEqual(vec, dup) );
+      TEST_ASSERT_EQUAL_size_t( 0, VectorRealtimeViolations(dup) );
+      TEST_ASSERT_TRUE( VectorHardReset(dup) );
+      TEST_ASSERT_EQUAL_size_t( 3000, VectorCapacity(dup) );
+
+      // Vectors carved out of it are regular vectors
+      struct Vector * slice = VectorSlice(vec, 0, 10);
+      TEST_ASSERT_NOT_NULL(slice);
+      TEST_ASSERT_TRUE( VectorCapacity(slice) < 3000 );
+
+      VectorFree(slice);
+      VectorFree(dup);
+      VectorFree(vec);
+   }
+}
+
+void test_VectorNew_UnmanagedAllocatorInitPerVector(void)
+{
+   // Never passed to AllocatorInit, so each vector gets a copy, and the init
+   // fcn is run for every one of them
+   struct TestCountingArena arena = {0};
+   const struct Allocator mem_mgr =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .alloca_init = test_counting_init,
+      .arena = &arena,
+      .alloca_deinit = test_counting_deinit
+   };
+   struct Vector * vecs[3];
+   for ( size_t i = 0; i < ARR_LEN(vecs); i++ )
+   {
+      vecs[i] = VectorNew(sizeof(int), 10, 100, 0, &mem_mgr);
+      TEST_ASSERT_NOT_NULL(vecs[i]);
+   }
+   TEST_ASSERT_EQUAL_size_t( ARR_LEN(vecs), arena.init_calls );
+   TEST_ASSERT_FALSE( AllocatorIsManaged(&mem_mgr) );
+
+   for ( size_t i = 0; i < ARR_LEN(vecs); i++ )
+   {
+      VectorFree(vecs[i]);
+   }
+   TEST_ASSERT_EQUAL_size_t( 0, arena.deinit_calls );
+}
+
+void test_VectorNew_ManagedAllocatorInitOnce(void)
+{
+   struct TestCountingArena arena = {0};
+   struct Allocator mem_mgr =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .alloca_init = test_counting_init,
+      .arena = &arena,
+      .alloca_deinit = test_counting_deinit
+   };
+   TEST_ASSERT_TRUE( AllocatorInit(&mem_mgr) );
+   TEST_ASSERT_TRUE( AllocatorIsManaged(&mem_mgr) );
+   TEST_ASSERT_EQUAL_size_t( 1, arena.init_calls );
+
+   struct Vector * vecs[5];
+   for ( size_t i = 0; i < ARR_LEN(vecs); i++ )
+   {
+      vecs[i] = VectorNew(sizeof(int), 10, 100, 0, &mem_mgr);
+      TEST_ASSERT_NOT_NULL(vecs[i]);
+      for ( int j = 0; j < 50; j++ )
+      {
+         TEST_ASSERT_TRUE( VectorPush(vecs[i], &j) );
+      }
+   }
+   TEST_ASSERT_EQUAL_size_t( 1, arena.init_calls );
+   TEST_ASSERT_EQUAL_size_t( 1 + ARR_LEN(vecs), mem_mgr.refs );
+
+   // The arena stays up as long as any vector still uses it, even after the
+   // caller has dropped its own reference
+   AllocatorRelease(&mem_mgr);
+   for ( size_t i = 0; i < ARR_LEN(vecs); i++ )
+   {
+      TEST_ASSERT_EQUAL_size_t( 0, arena.deinit_calls );
+      TEST_ASSERT_EQUAL_INT( 49, *(int *)VectorLastElement(vecs[i]) );
+      VectorFree(vecs[i]);
+   }
+   TEST_ASSERT_EQUAL_size_t( 1, arena.deinit_calls );
+   TEST_ASSERT_FALSE( AllocatorIsManaged(&mem_mgr) );
+}
+
+void test_VectorNew_ManagedAllocatorOutlivesDerivedVectors(void)
+{
+   struct TestCountingArena arena = {0};
+   struct Allocator mem_mgr =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .alloca_init = test_counting_init,
+      .arena = &arena,
+      .alloca_deinit = test_counting_deinit
+   };
+   TEST_ASSERT_TRUE( AllocatorInit(&mem_mgr) );
+
+   struct Vector * vec = VectorNew(sizeof(int), 10, 100, 0, &mem_mgr);
+   TEST_ASSERT_NOT_NULL(vec);
+   for ( int i = 0; i < 20; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+   }
+
+   struct Vector * dup = VectorDuplicate(vec);
+   struct Vector * slice = VectorSlice(vec, 2, 10);
+   struct Vector * split = VectorSplitAt(vec, 15);
+   struct Vector * cat = VectorConcatenate(vec, split);
+   TEST_ASSERT_NOT_NULL(dup);
+   TEST_ASSERT_NOT_NULL(slice);
+   TEST_ASSERT_NOT_NULL(split);
+   TEST_ASSERT_NOT_NULL(cat);
+   TEST_ASSERT_EQUAL_size_t( 6, mem_mgr.refs );
+   TEST_ASSERT_EQUAL_size_t( 1, arena.init_calls );
+
+   AllocatorRelease(&mem_mgr);
+   VectorFree(vec);
+   VectorFree(dup);
+   VectorFree(slice);
+   VectorFree(split);
+   TEST_ASSERT_EQUAL_size_t( 0, arena.deinit_calls );
+   VectorFree(cat);
+   TEST_ASSERT_EQUAL_size_t( 1, arena.deinit_calls );
+}
+
+void test_AllocatorInit_IncompleteOrRepeated(void)
+{
+   TEST_ASSERT_FALSE( AllocatorInit(NULL) );
+   TEST_ASSERT_FALSE( AllocatorRetain(NULL) );
+   AllocatorRelease(NULL);
+
+   struct TestCountingArena arena = {0};
+   struct Allocator incomplete =
+   {
+      .alloc = test_counting_alloc,
+      .reclaim = test_counting_reclaim,
+      .alloca_init = test_counting_init,
+      .arena = &arena
+   };
+   TEST_ASSERT_FALSE( AllocatorInit(&incomplete) );
+   TEST_ASSERT_FALSE( AllocatorIsManaged(&incomplete) );
+   TEST_ASSERT_EQUAL_size_t( 0, arena.init_calls );
+
+   struct Allocator mem_mgr = incomplete;
+   mem_mgr.realloc = test_counting_realloc;
+   TEST_ASSERT_FALSE( AllocatorRetain(&mem_mgr) );
+   TEST_ASSERT_TRUE( AllocatorInit(&mem_mgr) );
+   TEST_ASSERT_FALSE( AllocatorInit(&mem_mgr) );
+   TEST_ASSERT_EQUAL_size_t( 1, arena.init_calls );
+
+   TEST_ASSERT_TRUE( AllocatorRetain(&mem_mgr) );
+   AllocatorRelease(&mem_mgr);
+   TEST_ASSERT_TRUE( AllocatorIsManaged(&mem_mgr) );
+   AllocatorRelease(&mem_mgr);
+   TEST_ASSERT_FALSE( AllocatorIsManaged(&mem_mgr) );
+
+   // Releasing more than was taken does nothing
+   AllocatorRelease(&mem_mgr);
+   TEST_ASSERT_EQUAL_size_t( 0, mem_mgr.refs );
+}
+
+void test_VectorPool_ExhaustedThenReused(void)
+{
+   struct Vector * vecs[VEC_STRUCT_POOL_SIZE + 1];
+   size_t n = 0;
+   while ( n < ARR_LEN(vecs) )
+   {
+      vecs[n] = VectorNew(sizeof(int), 1, 10, 0, NULL);
+      if ( NULL == vecs[n] ) break;
+      n++;
+   }
+   TEST_ASSERT_TRUE( (n > 2) && (n <= VEC_STRUCT_POOL_SIZE) );
+
+   // Every handle freed from a full pool must be handed out again, whichever
+   // slots they came from
+   for ( size_t round = 0; round < 3; round++ )
+   {
+      const size_t FREED[] = { n / 2, (n / 2) - 1, 1 };
+      for ( size_t i = 0; i < ARR_LEN(FREED); i++ )
+      {
+         VectorFree(vecs[FREED[i]]);
+      }
+      for ( size_t i = 0; i < ARR_LEN(FREED); i++ )
+      {
+         vecs[FREED[i]] = VectorNew(sizeof(int), 1, 10, 0, NULL);
+         TEST_ASSERT_NOT_NULL( vecs[FREED[i]] );
+      }
+      TEST_ASSERT_NULL( VectorNew(sizeof(int), 1, 10, 0, NULL) );
+   }
+
+   for ( size_t i = 0; i < n; i++ )
+   {
+      VectorFree(vecs[i]);
+   }
+}
+
+void test_VectorFreeAllWith_OnlyThatAllocatorsVectors(void)
+{
+   // No reset hook, so each array is reclaimed
+   struct TestCountingArena arena_a = {0};
+   struct TestCountingArena arena_b = {0};
+   const struct Allocator mem_mgr_a =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena_a
+   };
+   const struct Allocator mem_mgr_b =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena_b
+   };
+
+   struct Vector * b = VectorNew(sizeof(int), 4, 100, 1, &mem_mgr_b);
+   for ( size_t i = 0; i < 3; i++ )
+   {
+      TEST_ASSERT_NOT_NULL( VectorNew(sizeof(int), 4, 100, 1, &mem_mgr_a) );
+   }
+   TEST_ASSERT_NOT_NULL( VectorNew(sizeof(int), 0, 100, 0, &mem_mgr_a) ); // No array
+
+   TEST_ASSERT_EQUAL_size_t( 4, VectorFreeAllWith(&mem_mgr_a) );
+   TEST_ASSERT_EQUAL_size_t( 3, arena_a.reclaim_calls );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorFreeAllWith(&mem_mgr_a) );
+   TEST_ASSERT_EQUAL_size_t( 0, arena_b.reclaim_calls );
+   TEST_ASSERT_TRUE( VectorPush(b, &(int){1}) );
+
+   // A managed allocator's vectors drop their references, and a copy of it
+   // (being another allocator object) matches none of them
+   struct TestCountingArena arena_c = {0};
+   struct Allocator managed =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena_c,
+      .alloca_deinit = test_counting_deinit
+   };
+   TEST_ASSERT_TRUE( AllocatorInit(&managed) );
+   TEST_ASSERT_NOT_NULL( VectorNew(sizeof(int), 4, 100, 1, &managed) );
+   TEST_ASSERT_NOT_NULL( VectorNew(sizeof(int), 4, 100, 1, &managed) );
+   const struct Allocator copy = managed;
+   TEST_ASSERT_EQUAL_size_t( 0, VectorFreeAllWith(&copy) );
+   TEST_ASSERT_EQUAL_size_t( 2, VectorFreeAllWith(&managed) );
+   TEST_ASSERT_EQUAL_size_t( 1, managed.refs );
+   AllocatorRelease(&managed);
+   TEST_ASSERT_EQUAL_size_t( 1, arena_c.deinit_calls );
+
+   TEST_ASSERT_EQUAL_size_t( 0, VectorFreeAllWith(NULL) );
+   VectorFree(b);
+}
+
+void test_VectorRecycle_FreedArrayReused(void)
+{
+   VectorRecycleSetBudget(1024);
+
+   struct Vector * vec = VectorNew(sizeof(uint32_t), 100, 1000, 1, NULL);
+   TEST_ASSERT_TRUE( VectorSet(vec, 0, &(uint32_t){0xDEADBEEF}) );
+   const void * arr = VectorGet(vec, 0);
+   VectorFree(vec);
+   TEST_ASSERT_EQUAL_size_t( 400, VectorRecycledBytes() );
+
+   // Taken over whole, and the initial elements still read as zeros
+   vec = VectorNew(sizeof(uint32_t), 50, 1000, 1, NULL);
+   TEST_ASSERT_EQUAL_PTR( arr, VectorGet(vec, 0) );
+   TEST_ASSERT_EQUAL_size_t( 100, VectorCapacity(vec) );
+   TEST_ASSERT_EQUAL_UINT32( 0, *(uint32_t *)VectorGet(vec, 0) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorRecycledBytes() );
+   VectorFree(vec);
+   TEST_ASSERT_EQUAL_size_t( 400, VectorRecycledBytes() );
+
+   // Other element sizes, too little room, or more than max_capacity: no fit
+   struct Vector * others[] =
+   {
+      VectorNew(sizeof(uint64_t), 10, 1000, 1, NULL),
+      VectorNew(sizeof(uint32_t), 101, 1000, 1, NULL),
+      VectorNew(sizeof(uint32_t), 10, 99, 1, NULL),
+      VectorNewWithAttr(sizeof(uint32_t), 10, 1000, 1, NULL, &(struct VectorAttr){ .alignment = 64 }),
+   };
+   for ( size_t i = 0; i < ARR_LEN(others); i++ )
+   {
+      TEST_ASSERT_NOT_NULL( others[i] );
+      TEST_ASSERT_EQUAL_size_t( 400, VectorRecycledBytes() );
+   }
+
+   // Nor is it handed to an arena's vector, whose arrays aren't kept either
+   struct TestCountingArena arena = {0};
+   const struct Allocator mem_mgr =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena
+   };
+   struct Vector * arena_vec = VectorNew(sizeof(uint32_t), 10, 1000, 0, &mem_mgr);
+   TEST_ASSERT_EQUAL_size_t( 1, arena.alloc_calls );
+   VectorFree(arena_vec);
+   TEST_ASSERT_EQUAL_size_t( 1, arena.reclaim_calls );
+   TEST_ASSERT_EQUAL_size_t( 400, VectorRecycledBytes() );
+
+   // A vector created without an array takes it on first push
+   vec = VectorNew(sizeof(uint32_t), 0, 1000, 0, NULL);
+   TEST_ASSERT_TRUE( VectorPush(vec, &(uint32_t){7}) );
+   TEST_ASSERT_EQUAL_PTR( arr, VectorGet(vec, 0) );
+   TEST_ASSERT_EQUAL_size_t( 100, VectorCapacity(vec) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorRecycledBytes() );
+
+   // ... and a duplicate takes one exactly as big as the original's
+   VectorFree(others[1]);
+   TEST_ASSERT_EQUAL_size_t( 404, VectorRecycledBytes() );
+   struct Vector * dup = VectorDuplicate(vec);
+   TEST_ASSERT_TRUE( VectorsAreEqual(vec, dup) );
+   TEST_ASSERT_EQUAL_size_t( 404, VectorRecycledBytes() );
+   VectorFree(dup);
+   TEST_ASSERT_EQUAL_size_t( 804, VectorRecycledBytes() );
+   dup = VectorDuplicate(vec);
+   TEST_ASSERT_TRUE( VectorsAreEqual(vec, dup) );
+   TEST_ASSERT_EQUAL_size_t( 404, VectorRecycledBytes() );
+
+   VectorFree(dup);
+   VectorFree(vec);
+   for ( size_t i = 0; i < ARR_LEN(others); i++ )
+   {
+      if ( i != 1 ) VectorFree(others[i]);
+   }
+   VectorRecycleSetBudget(0);
+   TEST_ASSERT_EQUAL_size_t( 0, VectorRecycledBytes() );
+}
+
+void test_VectorRecycle_BudgetSlotsAndFlush(void)
+{
+   VectorRecycleSetBudget(1000);
+
+   // The oldest arrays make room for new ones
+   struct Vector * vecs[3];
+   for ( size_t i = 0; i < ARR_LEN(vecs); i++ )
+   {
+      vecs[i] = VectorNew(sizeof(uint32_t), 100, 1000, 0, NULL);
+   }
+   for ( size_t i = 0; i < ARR_LEN(vecs); i++ )
+   {
+      VectorFree(vecs[i]);
+   }
+   TEST_ASSERT_EQUAL_size_t( 800, VectorRecycledBytes() );
+
+   // Anything bigger than the whole budget is given back right away
+   VectorFree( VectorNew(sizeof(uint32_t), 300, 1000, 0, NULL) );
+   TEST_ASSERT_EQUAL_size_t( 800, VectorRecycledBytes() );
+
+   // Lowering the budget evicts what no longer fits
+   VectorRecycleSetBudget(500);
+   TEST_ASSERT_EQUAL_size_t( 400, VectorRecycledBytes() );
+
+   // No more arrays are kept than there are slots
+   VectorRecycleFlush();
+   VectorRecycleSetBudget(1u << 20);
+   struct Vector * small[VEC_RECYCLE_SLOTS + 2];
+   for ( size_t i = 0; i < ARR_LEN(small); i++ )
+   {
+      small[i] = VectorNew(sizeof(uint64_t), 1, 10, 0, NULL);
+   }
+   for ( size_t i = 0; i < ARR_LEN(small); i++ )
+   {
+      VectorFree(small[i]);
+   }
+   TEST_ASSERT_EQUAL_size_t( VEC_RECYCLE_SLOTS * sizeof(uint64_t), VectorRecycledBytes() );
+
+   VectorRecycleFlush();
+   TEST_ASSERT_EQUAL_size_t( 0, VectorRecycledBytes() );
+
+   // Stable and locked arrays aren't allocator blocks, so they're never kept
+   struct Vector * stable = VectorNewWithAttr(sizeof(uint32_t), 10, 1000, 0, NULL,
+                                              &(struct VectorAttr){ .stable_addresses = true });
+   VectorFree(stable);
+   TEST_ASSERT_EQUAL_size_t( 0, VectorRecycledBytes() );
+
+   VectorRecycleSetBudget(0);
+   VectorFree( VectorNew(sizeof(uint32_t), 10, 1000, 0, NULL) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorRecycledBytes() );
+}
+
+void test_VectorStats_CountsPerVectorAndTotals(void)
+{
+   struct VectorStats stats;
+   VectorStatsReset(NULL);
+   if ( !VectorStatsGet(NULL, &stats) )
+   {
+      // Built without CCOL_STATS: nothing is counted
+      TEST_ASSERT_EQUAL_size_t( 0, (size_t)stats.pushes );
+      return;
+   }
+
+   struct Vector * vec = VectorNew(sizeof(uint32_t), 4, 100, 0, NULL);
+   struct Vector * other = VectorNew(sizeof(uint32_t), 4, 100, 0, NULL);
+   for ( uint32_t i = 0; i < 10; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &i) ); // Grows 4 -> 8 -> 16
+   }
+   TEST_ASSERT_TRUE( VectorPush(other, &(uint32_t){0}) );
+   TEST_ASSERT_TRUE( VectorInsert(vec, 0, &(uint32_t){0}) );  // Shifts 10 elements
+   TEST_ASSERT_TRUE( VectorRemove(vec, 0, NULL) );            // ... and back
+   TEST_ASSERT_TRUE( VectorRemoveLastElement(vec, NULL) );    // Nothing to shift
+   TEST_ASSERT_FALSE( VectorRemove(vec, 100, NULL) );         // Failures don't count
+   struct Vector * dup = VectorDuplicate(vec);                // Copies 9 elements
+
+   TEST_ASSERT_TRUE( VectorStatsGet(vec, &stats) );
+   TEST_ASSERT_EQUAL_size_t( 10, (size_t)stats.pushes );
+   TEST_ASSERT_EQUAL_size_t( 1, (size_t)stats.inserts );
+   TEST_ASSERT_EQUAL_size_t( 2, (size_t)stats.removes );
+   TEST_ASSERT_EQUAL_size_t( 2, (size_t)stats.expansions );
+   TEST_ASSERT_EQUAL_size_t( 2 * 10 * sizeof(uint32_t), (size_t)stats.shift_bytes );
+   TEST_ASSERT_EQUAL_size_t( 9 * sizeof(uint32_t), (size_t)stats.copy_bytes );
+
+   // A duplicate starts from scratch
+   TEST_ASSERT_TRUE( VectorStatsGet(dup, &stats) );
+   TEST_ASSERT_EQUAL_size_t( 0, (size_t)(stats.pushes + stats.copy_bytes) );
+
+   // Running out of handles only shows in the totals
+   struct Vector * hogs[VEC_STRUCT_POOL_SIZE] = {0};
+   size_t num_hogs = 0;
+   while ( (hogs[num_hogs] = VectorNew(1, 1, 1, 0, NULL)) != NULL )
+   {
+      num_hogs++;
+   }
+   for ( size_t i = 0; i < num_hogs; i++ )
+   {
+      VectorFree(hogs[i]);
+   }
+
+   TEST_ASSERT_TRUE( VectorStatsGet(NULL, &stats) );
+   TEST_ASSERT_EQUAL_size_t( 11, (size_t)stats.pushes );
+   TEST_ASSERT_EQUAL_size_t( 2, (size_t)stats.expansions );
+   TEST_ASSERT_EQUAL_size_t( 1, (size_t)stats.pool_exhausted );
+
+   VectorStatsReset(vec);
+   TEST_ASSERT_TRUE( VectorStatsGet(vec, &stats) );
+   TEST_ASSERT_EQUAL_size_t( 0, (size_t)(stats.pushes + stats.shift_bytes) );
+   TEST_ASSERT_TRUE( VectorStatsGet(other, &stats) );
+   TEST_ASSERT_EQUAL_size_t( 1, (size_t)stats.pushes );
+
+   VectorStatsReset(NULL);
+   TEST_ASSERT_TRUE( VectorStatsGet(other, &stats) );
+   TEST_ASSERT_EQUAL_size_t( 0, (size_t)stats.pushes );
+   TEST_ASSERT_TRUE( VectorStatsGet(NULL, &stats) );
+   TEST_ASSERT_EQUAL_size_t( 0, (size_t)(stats.pushes + stats.pool_exhausted) );
+
+   VectorFree(dup);
+   VectorFree(other);
+   VectorFree(vec);
+   TEST_ASSERT_FALSE( VectorStatsGet(vec, &stats) );
+}
+
+void test_VectorStats_ExportText(void)
+{
+   char buf[1024];
+   char small[16];
+   struct VectorStats stats;
+   VectorStatsReset(NULL);
+
+   struct Vector * vec = VectorNew(sizeof(uint16_t), 4, 100, 0, NULL);
+   uint16_t vals[] = { 1, 2, 3 };
+   TEST_ASSERT_TRUE( VectorRangePush(vec, vals, ARR_LEN(vals)) );
+   TEST_ASSERT_TRUE( VectorRangeInsert(vec, 0, vals, ARR_LEN(vals)) );
+
+   size_t len = VectorStatsExport(buf, sizeof(buf));
+   TEST_ASSERT_TRUE( len < sizeof(buf) );
+   TEST_ASSERT_EQUAL_size_t( len, strlen(buf) );
+   if ( !VectorStatsGet(NULL, &stats) )
+   {
+      TEST_ASSERT_NOT_NULL( strstr(buf, "disabled") );
+      VectorFree(vec);
+      return;
+   }
+
+   TEST_ASSERT_NOT_NULL( strstr(buf, "vector_stats total pushes=1 inserts=1 removes=0 expansions=1 "
+                                     "shift_bytes=6 copy_bytes=0 pool_exhausted=0\n") );
+   TEST_ASSERT_NOT_NULL( strstr(buf, " element_size=2 len=6 capacity=") );
+   TEST_ASSERT_NOT_NULL( strstr(buf, " pushes=1 inserts=1 removes=0 expansions=1 "
+                                     "shift_bytes=6 copy_bytes=0\n") );
+
+   // Truncated to fit, but the whole length is still reported
+   TEST_ASSERT_EQUAL_size_t( len, VectorStatsExport(small, sizeof(small)) );
+   TEST_ASSERT_EQUAL_size_t( sizeof(small) - 1, strlen(small) );
+   TEST_ASSERT_EQUAL_MEMORY( buf, small, sizeof(small) - 1 );
+   TEST_ASSERT_EQUAL_size_t( len, VectorStatsExport(NULL, 0) );
+
+   VectorFree(vec);
+}
+
+void test_VectorPool_InfoAndRanking(void)
+{
+   struct VectorPoolInfo base;
+   struct VectorPoolInfo info;
+   TEST_ASSERT_FALSE( VectorPoolInfoGet(NULL) );
+   VectorPoolHighWaterReset();
+   TEST_ASSERT_TRUE( VectorPoolInfoGet(&base) );
+   TEST_ASSERT_EQUAL_size_t( VEC_STRUCT_POOL_SIZE, base.pool_size );
+   TEST_ASSERT_TRUE( base.pool_bytes >= (base.pool_size * 3 * sizeof(size_t)) ); // At least arr, len, capacity per handle
+   TEST_ASSERT_EQUAL_size_t( base.in_use, base.high_water );
+
+   struct Vector * a = VectorNew(sizeof(uint32_t), 10, 100, 2, NULL);  // 40 B, 32 spare
+   struct Vector * b = VectorNew(sizeof(uint64_t), 4, 100, 4, NULL);   // 32 B, full
+   struct Vector * c = VectorNew(1, 100, 100, 0, NULL);                // 100 B, all spare
+   struct Vector * d = VectorNew(sizeof(uint16_t), 0, 10, 0, NULL);    // Nothing held
+
+   TEST_ASSERT_TRUE( VectorPoolInfoGet(&info) );
+   TEST_ASSERT_EQUAL_size_t( base.in_use + 4, info.in_use );
+   TEST_ASSERT_EQUAL_size_t( base.in_use + 4, info.high_water );
+   TEST_ASSERT_EQUAL_size_t( base.capacity_bytes + 172, info.capacity_bytes );
+   TEST_ASSERT_EQUAL_size_t( base.length_bytes + 40, info.length_bytes );
+   TEST_ASSERT_EQUAL_size_t( base.slack_bytes + 132, info.slack_bytes );
+
+   struct Vector * ranked[VEC_STRUCT_POOL_SIZE] = {0};
+   TEST_ASSERT_EQUAL_size_t( 2, VectorPoolLargest(ranked, 2) );
+   TEST_ASSERT_EQUAL_PTR( c, ranked[0] );
+   TEST_ASSERT_EQUAL_PTR( a, ranked[1] );
+   TEST_ASSERT_EQUAL_size_t( 3, VectorPoolLargest(ranked, ARR_LEN(ranked)) );
+   TEST_ASSERT_EQUAL_PTR( c, ranked[0] );
+   TEST_ASSERT_EQUAL_PTR( a, ranked[1] );
+   TEST_ASSERT_EQUAL_PTR( b, ranked[2] );
+
+   TEST_ASSERT_EQUAL_size_t( 1, VectorPoolMostSlack(ranked, 1) );
+   TEST_ASSERT_EQUAL_PTR( c, ranked[0] );
+   TEST_ASSERT_EQUAL_size_t( 2, VectorPoolMostSlack(ranked, ARR_LEN(ranked)) );
+   TEST_ASSERT_EQUAL_PTR( a, ranked[1] );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorPoolMostSlack(ranked, 0) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorPoolLargest(NULL, 5) );
+
+   // Filling up a vector takes it off the slack list
+   for ( uint8_t i = 0; i < 100; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(c, &i) );
+   }
+   TEST_ASSERT_EQUAL_size_t( 1, VectorPoolMostSlack(ranked, ARR_LEN(ranked)) );
+   TEST_ASSERT_EQUAL_PTR( a, ranked[0] );
+
+   // The high-water mark stays until it's reset
+   VectorFree(c);
+   VectorFree(d);
+   TEST_ASSERT_TRUE( VectorPoolInfoGet(&info) );
+   TEST_ASSERT_EQUAL_size_t( base.in_use + 2, info.in_use );
+   TEST_ASSERT_EQUAL_size_t( base.in_use + 4, info.high_water );
+   TEST_ASSERT_EQUAL_size_t( base.capacity_bytes + 72, info.capacity_bytes );
+   VectorPoolHighWaterReset();
+   TEST_ASSERT_TRUE( VectorPoolInfoGet(&info) );
+   TEST_ASSERT_EQUAL_size_t( base.in_use + 2, info.high_water );
+
+   VectorFree(a);
+   VectorFree(b);
+}
+
+void test_VectorTrace_DecodeRecord(void)
+{
+   // Insert on handle 3 at index 150: op 7 with 2 fields, 150 taking 2 bytes
+   const uint8_t ENCODED[] = { (2u << 5) | 7u, 0x03, 0x96, 0x01, (1u << 5) | 2u, 0x03 };
+   struct VectorTraceRecord rec;
+
+   TEST_ASSERT_EQUAL_size_t( 4, VectorTraceDecode(ENCODED, sizeof(ENCODED), &rec) );
+   TEST_ASSERT_EQUAL_INT( VectorTraceOp_Insert, rec.op );
+   TEST_ASSERT_EQUAL_size_t( 3, (size_t)rec.handle );
+   TEST_ASSERT_EQUAL_size_t( 150, (size_t)rec.args[0] );
+   TEST_ASSERT_EQUAL_size_t( 0, (size_t)(rec.args[1] + rec.args[2] + rec.args[3]) );
+
+   TEST_ASSERT_EQUAL_size_t( 2, VectorTraceDecode(&ENCODED[4], 2, &rec) );
+   TEST_ASSERT_EQUAL_INT( VectorTraceOp_Free, rec.op );
+
+   // Cut short, or not a record at all
+   TEST_ASSERT_EQUAL_size_t( 0, VectorTraceDecode(ENCODED, 3, &rec) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorTraceDecode(&(uint8_t){ 0x20 }, 1, &rec) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorTraceDecode(&(uint8_t){ (1u << 5) | 31u }, 1, &rec) );
+   TEST_ASSERT_EQUAL_size_t( 0, VectorTraceDecode(NULL, 4, &rec) );
+}
+
+void test_VectorTrace_RecordsCalls(void)
+{
+   const char * PATH = "test_vector_trace.bin";
+   if ( !VectorTraceStart(PATH) )
+   {
+      // Built without CCOL_TRACE: there's nothing to stop either
+      TEST_ASSERT_FALSE( VectorTraceStop() );
+      return;
+   }
+   TEST_ASSERT_FALSE( VectorTraceStart(PATH) ); // Already recording
+
+   struct Vector * vec = VectorNew(sizeof(uint32_t), 2, 100, 0, NULL);
+   for ( uint32_t i = 0; i < 3; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+   }
+   TEST_ASSERT_TRUE( VectorInsert(vec, 0, &(uint32_t){7}) );
+   TEST_ASSERT_TRUE( VectorRangeRemove(vec, 0, 2, NULL) );  // No nested calls recorded
+   TEST_ASSERT_TRUE( VectorClear(vec) );                    // Recorded as a range clear
+   struct Vector * dup = VectorDuplicate(vec);
+   VectorFree(dup);
+   VectorFree(vec);
+   const struct VectorAttr ATTR = { .alignment = 64, .realtime = true };
+   vec = VectorNewWithAttr(sizeof(uint32_t), 0, 100, 0, NULL, &ATTR);
+   TEST_ASSERT_NOT_NULL( vec );
+   VectorFree(vec);
+   // One that can't be set up leaves no trace, not even of freeing what it got
+   const struct VectorAttr RT_ATTR = { .realtime = true };
+   TEST_ASSERT_NULL( VectorNewWithAttr(sizeof(uint32_t), 0, 100, 0, &TestNilMemMgr, &RT_ATTR) );
+   TEST_ASSERT_TRUE( VectorTraceStop() );
+   TEST_ASSERT_FALSE( VectorTraceStop() );
+
+   uint8_t trace[256];
+   FILE * file = fopen(PATH, "rb");
+   TEST_ASSERT_NOT_NULL( file );
+   size_t trace_sz = fread(trace, 1, sizeof(trace), file);
+   fclose(file);
+   remove(PATH);
+   TEST_ASSERT_TRUE( trace_sz > VECTOR_TRACE_MAGIC_LEN );
+   TEST_ASSERT_EQUAL_MEMORY( VECTOR_TRACE_MAGIC, trace, VECTOR_TRACE_MAGIC_LEN );
+
+   const enum VectorTraceOp EXPECTED[] = {
+      VectorTraceOp_New, VectorTraceOp_Push, VectorTraceOp_Push, VectorTraceOp_Push,
+      VectorTraceOp_Insert, VectorTraceOp_RangeRemove, VectorTraceOp_RangeClear,
+      VectorTraceOp_Duplicate, VectorTraceOp_Free, VectorTraceOp_Free,
+      VectorTraceOp_New, VectorTraceOp_NewAttr, VectorTraceOp_Free
+   };
+   struct VectorTraceRecord recs[ARR_LEN(EXPECTED)];
+   size_t used = VECTOR_TRACE_MAGIC_LEN;
+   for ( size_t i = 0; i < ARR_LEN(EXPECTED); i++ )
+   {
+      size_t rec_sz = VectorTraceDecode(&trace[used], trace_sz - used, &recs[i]);
+      TEST_ASSERT_TRUE( rec_sz > 0 );
+      TEST_ASSERT_EQUAL_INT( EXPECTED[i], recs[i].op );
+      used += rec_sz;
+   }
+   TEST_ASSERT_EQUAL_size_t( trace_sz, used );
+
+   uint64_t handle = recs[0].handle;
+   TEST_ASSERT_TRUE( handle > 0 );
+   TEST_ASSERT_EQUAL_size_t( sizeof(uint32_t), (size_t)recs[0].args[0] );
+   TEST_ASSERT_EQUAL_size_t( 2, (size_t)recs[0].args[1] );
+   TEST_ASSERT_EQUAL_size_t( 100, (size_t)recs[0].args[2] );
+   TEST_ASSERT_EQUAL_size_t( 0, (size_t)recs[0].args[3] );
+   for ( size_t i = 1; i < 8; i++ )
+   {
+      TEST_ASSERT_TRUE( handle == recs[i].handle );
+   }
+   TEST_ASSERT_EQUAL_size_t( 0, (size_t)recs[5].args[0] );
+   TEST_ASSERT_EQUAL_size_t( 2, (size_t)recs[5].args[1] );
+   TEST_ASSERT_EQUAL_size_t( 0, (size_t)recs[5].args[2] ); // Not copied out
+   TEST_ASSERT_EQUAL_size_t( 2, (size_t)recs[6].args[1] );
+
+   // The duplicate got a handle of its own, which it was then freed under
+   TEST_ASSERT_TRUE( (recs[7].args[0] > 0) && (recs[7].args[0] != handle) );
+   TEST_ASSERT_TRUE( recs[7].args[0] == recs[8].handle );
+   TEST_ASSERT_TRUE( handle == recs[9].handle );
+
+   // Attributes follow the New of the vector they were created with
+   TEST_ASSERT_EQUAL_size_t( 100, (size_t)recs[10].args[2] );
+   TEST_ASSERT_TRUE( recs[10].handle == recs[11].handle );
+   TEST_ASSERT_EQUAL_size_t( VECTOR_TRACE_ATTR_REALTIME, (size_t)recs[11].args[0] );
+   TEST_ASSERT_EQUAL_size_t( 64, (size_t)recs[11].args[1] );
+   TEST_ASSERT_TRUE( recs[10].handle == recs[12].handle );
+}
+
 /**************************** Vector Ops On Nulls *****************************/
 void test_VectorOpsOnNullVectors(void)
 {
@@ -992,6 +2272,80 @@ void test_VectorPush_AfterHardResetting(void)
    VectorFree(vec);
 }
 
+void test_VectorPush_AbsorbsAllocatorSlack(void)
+{
+   const size_t BLOCK_SZ = 4096;
+   struct TestCountingArena arena = { .block_sz = BLOCK_SZ };
+   const struct Allocator mem_mgr =
+   {
+      .alloc = test_block_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena,
+      .usable_size = test_block_usable_size
+   };
+   struct Vector * vec = VectorNew(sizeof(int), 10, 10000, 0, &mem_mgr);
+   TEST_ASSERT_NOT_NULL(vec);
+   TEST_ASSERT_EQUAL_size_t( 10, VectorCapacity(vec) );
+
+   // Everything that fits within the block should be pushed without a realloc
+   for ( int i = 0; (size_t)i < (BLOCK_SZ / sizeof(int)); i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+   }
+   TEST_ASSERT_EQUAL_size_t( 0, arena.realloc_calls );
+   TEST_ASSERT_EQUAL_size_t( BLOCK_SZ / sizeof(int), VectorCapacity(vec) );
+
+   // Past the block, we have no choice but to realloc
+   TEST_ASSERT_TRUE( VectorPush(vec, &(int){-1}) );
+   TEST_ASSERT_EQUAL_size_t( 1, arena.realloc_calls );
+   for ( int i = 0; (size_t)i < (BLOCK_SZ / sizeof(int)); i++ )
+   {
+      TEST_ASSERT_EQUAL_INT( i, *(int *)VectorGet(vec, (size_t)i) );
+   }
+   TEST_ASSERT_EQUAL_INT( -1, *(int *)VectorLastElement(vec) );
+
+   VectorFree(vec);
+}
+
+void test_VectorPush_ExpandsInPlace(void)
+{
+   const size_t BLOCK_SZ = 4096;
+   struct TestCountingArena arena = { .block_sz = BLOCK_SZ };
+   const struct Allocator mem_mgr =
+   {
+      .alloc = test_block_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena,
+      .try_expand_in_place = test_block_try_expand_in_place
+   };
+   struct Vector * vec = VectorNew(sizeof(int), 10, 10000, 0, &mem_mgr);
+   TEST_ASSERT_NOT_NULL(vec);
+
+   // Capacity should still follow the usual growth, just without a realloc
+   for ( int i = 0; i < 11; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &i) );
+   }
+   TEST_ASSERT_EQUAL_size_t( 20, VectorCapacity(vec) );
+   TEST_ASSERT_EQUAL_size_t( 1, arena.in_place_calls );
+   TEST_ASSERT_EQUAL_size_t( 0, arena.realloc_calls );
+
+   // Keep going until the in-place expansion is refused
+   while ( VectorLength(vec) < (BLOCK_SZ / sizeof(int)) + 1 )
+   {
+      TEST_ASSERT_TRUE( VectorPush(vec, &(int){7}) );
+   }
+   TEST_ASSERT_EQUAL_size_t( 1, arena.realloc_calls );
+   for ( int i = 0; i < 11; i++ )
+   {
+      TEST_ASSERT_EQUAL_INT( i, *(int *)VectorGet(vec, (size_t)i) );
+   }
+
+   VectorFree(vec);
+}
+
 /****************************** Vector Insertion ******************************/
 void test_VectorInsertion_AtZeroWithVectorLessThanCapacity(void)
 {
@@ -2557,6 +3911,61 @@ void test_VectorConcatenate_ConcatenateSplitRoundTrip(void)
    VectorFree(cat);
 }
 
+void test_VectorRangeOpsWith_OtherAllocator(void)
+{
+   struct TestCountingArena arena = {0};
+   const struct Allocator mem_mgr =
+   {
+      .alloc = test_counting_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena
+   };
+
+   struct Vector * src = VectorNew(sizeof(int), 10, 100, 0, NULL);
+   struct Vector * empty = VectorNew(sizeof(int), 10, 100, 0, NULL);
+   for ( int i = 0; i < 10; i++ )
+   {
+      TEST_ASSERT_TRUE( VectorPush(src, &i) );
+   }
+
+   // Even slicing the whole vector allocates from the given allocator
+   struct Vector * whole = VectorSliceWith(src, 0, 10, &mem_mgr);
+   struct Vector * slice = VectorSliceWith(src, 2, 5, &mem_mgr);
+   TEST_ASSERT_EQUAL_size_t( 2, arena.alloc_calls );
+   TEST_ASSERT_EQUAL_size_t( 10, VectorLength(whole) );
+   TEST_ASSERT_EQUAL_size_t( 3, VectorLength(slice) );
+   TEST_ASSERT_EQUAL_INT( 2, *(int *)VectorGet(slice, 0) );
+
+   // Concatenating with an empty vector copies the other one into the new allocator
+   struct Vector * cat = VectorConcatenateWith(empty, slice, &mem_mgr);
+   TEST_ASSERT_EQUAL_size_t( 3, arena.alloc_calls );
+   TEST_ASSERT_TRUE( VectorsAreEqual(slice, cat) );
+   VectorFree(cat);
+   cat = VectorConcatenateWith(src, slice, &mem_mgr);
+   TEST_ASSERT_EQUAL_size_t( 4, arena.alloc_calls );
+   TEST_ASSERT_EQUAL_size_t( 13, VectorLength(cat) );
+   TEST_ASSERT_EQUAL_INT( 4, *(int *)VectorLastElement(cat) );
+
+   struct Vector * right = VectorSplitAtWith(cat, 10, &mem_mgr);
+   TEST_ASSERT_EQUAL_size_t( 5, arena.alloc_calls );
+   TEST_ASSERT_EQUAL_size_t( 10, VectorLength(cat) );
+   TEST_ASSERT_EQUAL_INT( 2, *(int *)VectorGet(right, 0) );
+
+   // NULL means the source's allocator
+   struct Vector * plain = VectorSliceWith(slice, 0, 2, NULL);
+   TEST_ASSERT_EQUAL_size_t( 6, arena.alloc_calls );
+
+   VectorFree(plain);
+   VectorFree(right);
+   VectorFree(cat);
+   VectorFree(slice);
+   VectorFree(whole);
+   TEST_ASSERT_EQUAL_size_t( arena.alloc_calls, arena.reclaim_calls );
+   VectorFree(empty);
+   VectorFree(src);
+}
+
 /*********************** Vector Range: Push Elements ***********************/
 
 void test_VectorRangePush_ValidInts(void)
@@ -2668,6 +4077,32 @@ void test_VectorRangePush_ExactlyMaxCapacity(void)
 
 /********************** Vector Range: Insert Elements **********************/
 
+void test_VectorRangePush_AbsorbsAllocatorSlack(void)
+{
+   const size_t BLOCK_SZ = 1024;
+   struct TestCountingArena arena = { .block_sz = BLOCK_SZ };
+   const struct Allocator mem_mgr =
+   {
+      .alloc = test_block_alloc,
+      .realloc = test_counting_realloc,
+      .reclaim = test_counting_reclaim,
+      .arena = &arena,
+      .usable_size = test_block_usable_size
+   };
+   int data[100];
+   for ( size_t i = 0; i < ARR_LEN(data); i++ ) data[i] = (int)i;
+
+   struct Vector * vec = VectorNew(sizeof(int), 10, 1000, 0, &mem_mgr);
+   TEST_ASSERT_TRUE( VectorRangePush(vec, data, ARR_LEN(data)) );
+   TEST_ASSERT_EQUAL_size_t( 0, arena.realloc_calls );
+   TEST_ASSERT_EQUAL_size_t( ARR_LEN(data), VectorLength(vec) );
+   for ( size_t i = 0; i < ARR_LEN(data); i++ )
+   {
+      TEST_ASSERT_EQUAL_INT( data[i], *(int *)VectorGet(vec, i) );
+   }
+   VectorFree(vec);
+}
+
 void test_VectorRangeInsert_ValidInts(void)
 {
    struct Vector * vec = VectorNew(sizeof(int), 5, 10, 0, &DEFAULT_ALLOCATOR);